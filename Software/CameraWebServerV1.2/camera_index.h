@@ -1,127 +0,0 @@
-#include <pgmspace.h>
-
-const uint8_t index_ov3660_html_gz[] PROGMEM = {
-  0x1f, 0x8b, 0x08, 0x00, 0xe4, 0x15, 0x2f, 0x69, 0x02, 0xff, 0xc5, 0x59, 0xdd, 0x72, 0xe3, 0xb6, 0x15, 0xbe, 0xcf, 0x53,
-  0x20, 0x74, 0x5a, 0x52, 0xad, 0x48, 0x51, 0xd2, 0xda, 0x2b, 0xdb, 0x92, 0x52, 0xc7, 0x6b, 0x27, 0xee, 0x38, 0x5d, 0x77,
-  0x1d, 0x67, 0xdb, 0xe9, 0x74, 0xb2, 0x20, 0x09, 0x49, 0xd8, 0xe5, 0x5f, 0x40, 0xd0, 0xb2, 0xeb, 0xec, 0x4c, 0x2e, 0xdb,
-  0xeb, 0x5e, 0xf4, 0x0d, 0xfa, 0x0a, 0xbd, 0x6f, 0xdf, 0x64, 0x9f, 0xa4, 0x07, 0x00, 0x7f, 0x40, 0x8a, 0xd2, 0xda, 0x69,
-  0x3b, 0x1d, 0xcf, 0x48, 0x24, 0x7e, 0x0e, 0xce, 0x39, 0xdf, 0x77, 0x7e, 0x20, 0x4f, 0x3f, 0x7d, 0xf1, 0xf2, 0xf4, 0x9b,
-  0xdf, 0x5f, 0x9d, 0xa1, 0x15, 0x8f, 0xc2, 0xf9, 0x27, 0x53, 0xf1, 0x85, 0x42, 0x1c, 0x2f, 0x67, 0x06, 0x89, 0x0d, 0x31,
-  0x40, 0x70, 0x30, 0xff, 0x04, 0xa1, 0x69, 0x44, 0x38, 0x46, 0xfe, 0x0a, 0xb3, 0x8c, 0xf0, 0x99, 0x71, 0xf3, 0xcd, 0xb9,
-  0x3d, 0x31, 0xea, 0x89, 0x18, 0x47, 0x64, 0x66, 0xdc, 0x52, 0xb2, 0x4e, 0x13, 0xc6, 0x0d, 0xe4, 0x27, 0x31, 0x27, 0x31,
-  0x2c, 0x5c, 0xd3, 0x80, 0xaf, 0x66, 0x01, 0xb9, 0xa5, 0x3e, 0xb1, 0xe5, 0x4b, 0x1f, 0xd1, 0x98, 0x72, 0x8a, 0x43, 0x3b,
-  0xf3, 0x71, 0x48, 0x66, 0x43, 0xc7, 0x55, 0x82, 0x38, 0xe5, 0x21, 0x99, 0xff, 0xee, 0xe2, 0xe4, 0x25, 0x3a, 0xbb, 0xbe,
-  0x1a, 0x8f, 0xae, 0xc7, 0xe8, 0x8a, 0xd1, 0x98, 0xa3, 0xaf, 0x13, 0xd8, 0x90, 0xb0, 0xe9, 0x40, 0xad, 0x10, 0x6b, 0x33,
-  0x7e, 0xaf, 0x9e, 0x10, 0x3a, 0x62, 0x49, 0xc2, 0xd1, 0x83, 0x7c, 0x46, 0xc8, 0xb6, 0xbd, 0xe5, 0x11, 0xda, 0x73, 0x17,
-  0xc3, 0xe7, 0x23, 0x7c, 0x5c, 0x0d, 0xfa, 0x98, 0x05, 0x30, 0x3c, 0x1c, 0x0e, 0x27, 0xa3, 0xe7, 0xf5, 0x30, 0xf6, 0x7d,
-  0xd0, 0x12, 0x26, 0xc6, 0x13, 0x2f, 0x58, 0x4c, 0xea, 0x09, 0x4e, 0xee, 0xc4, 0x30, 0xd9, 0x27, 0xcf, 0x89, 0x57, 0x0f,
-  0x47, 0x39, 0x27, 0x42, 0xce, 0xa1, 0x8f, 0xc7, 0x78, 0xa1, 0xc6, 0xdf, 0xcb, 0xcf, 0x5f, 0xa0, 0x07, 0xe4, 0x25, 0x77,
-  0x76, 0x46, 0xff, 0x44, 0x63, 0xd0, 0xc0, 0x4b, 0x58, 0x40, 0x98, 0x0d, 0x43, 0xc7, 0xc5, 0x0a, 0x2f, 0x09, 0xee, 0x2b,
-  0x35, 0x23, 0xcc, 0x96, 0x34, 0x3e, 0x42, 0x6e, 0x29, 0x7b, 0x01, 0x0e, 0xb3, 0x17, 0x38, 0xa2, 0xe1, 0xfd, 0x11, 0x32,
-  0x2e, 0xc0, 0x7b, 0xcc, 0xe8, 0xa3, 0xec, 0x3e, 0xe3, 0x24, 0xb2, 0x73, 0xda, 0x47, 0x36, 0x4e, 0xd3, 0x90, 0xd8, 0x6a,
-  0x04, 0x66, 0x70, 0x9c, 0xd9, 0x19, 0x61, 0x74, 0x51, 0x4a, 0xf0, 0xb0, 0xff, 0x6e, 0xc9, 0x92, 0x3c, 0x06, 0x05, 0x6f,
-  0x31, 0xb3, 0x84, 0x27, 0x7a, 0xe5, 0xa4, 0x9f, 0x84, 0x09, 0x2b, 0xc7, 0x85, 0x71, 0xd5, 0x4c, 0x44, 0x63, 0x7b, 0x45,
-  0xe8, 0x72, 0x05, 0xf6, 0x0e, 0x5d, 0xf7, 0x76, 0xa5, 0x5b, 0x25, 0xd0, 0x27, 0xac, 0xd2, 0x3a, 0xc5, 0x41, 0x20, 0xad,
-  0x1b, 0x1e, 0xa4, 0x77, 0x68, 0xe4, 0xa6, 0x77, 0xd5, 0xe1, 0xa5, 0xb9, 0x9c, 0x27, 0x11, 0xcc, 0xc3, 0x74, 0x96, 0x84,
-  0x34, 0x00, 0x97, 0x2f, 0x46, 0x87, 0xe3, 0xca, 0xe5, 0x01, 0xcd, 0xd2, 0x10, 0x83, 0x89, 0x8b, 0x90, 0x54, 0x9b, 0x71,
-  0x48, 0x97, 0xb1, 0x4d, 0xc1, 0xae, 0xec, 0x08, 0x09, 0x40, 0x08, 0x2b, 0xa7, 0xde, 0xe6, 0x19, 0xa7, 0x8b, 0x7b, 0xbb,
-  0xe0, 0xd3, 0x11, 0xca, 0x52, 0x0c, 0x44, 0xf2, 0x08, 0x5f, 0x13, 0x12, 0x97, 0xab, 0x96, 0x38, 0x85, 0x33, 0x47, 0xb5,
-  0x3a, 0x42, 0xba, 0xbd, 0x66, 0x62, 0x58, 0x7c, 0x76, 0x98, 0xb4, 0x1a, 0x02, 0x60, 0x35, 0x0a, 0xca, 0xff, 0x00, 0x1e,
-  0x01, 0x41, 0xce, 0x90, 0x91, 0xe8, 0x18, 0x85, 0x84, 0x83, 0x26, 0xb6, 0x38, 0x51, 0x1a, 0xed, 0x3a, 0xee, 0x48, 0x8c,
-  0x37, 0xe4, 0x38, 0x59, 0xee, 0x49, 0x5a, 0x82, 0xb8, 0x86, 0x93, 0x25, 0x55, 0x7a, 0x0d, 0xc1, 0xae, 0x73, 0xb8, 0xcf,
-  0x6a, 0x09, 0x0e, 0x38, 0x22, 0xc9, 0x6b, 0xea, 0x76, 0xfa, 0xa6, 0xd3, 0x92, 0xd2, 0xe2, 0x83, 0xda, 0xe2, 0x06, 0x34,
-  0xba, 0xbd, 0x4e, 0x8a, 0x63, 0x12, 0x56, 0x87, 0x6c, 0xb2, 0x44, 0x84, 0x46, 0xaf, 0x89, 0xe3, 0x0e, 0x00, 0x0b, 0xa0,
-  0x19, 0x0e, 0x68, 0x9e, 0x35, 0x9d, 0x5e, 0xab, 0xf0, 0xac, 0x89, 0x04, 0x8c, 0xc0, 0xdf, 0x58, 0xe7, 0x8b, 0x60, 0x9d,
-  0xcc, 0x06, 0x47, 0x68, 0x34, 0x71, 0x9b, 0x1a, 0xef, 0x65, 0x9c, 0x11, 0x1c, 0x89, 0xd8, 0x01, 0xa7, 0x2a, 0x01, 0x23,
-  0x10, 0xf0, 0x4c, 0x0a, 0x68, 0x2e, 0xaa, 0xec, 0x2a, 0x84, 0x01, 0x83, 0x7f, 0xb6, 0x4d, 0xd5, 0x0d, 0xba, 0xee, 0x32,
-  0x53, 0x73, 0xd3, 0x9e, 0xeb, 0x0d, 0x47, 0xa3, 0x2a, 0x52, 0x13, 0xef, 0x2d, 0xf1, 0x21, 0x56, 0x29, 0xb0, 0x51, 0xd0,
-  0x12, 0xd3, 0xb8, 0x16, 0x0b, 0x09, 0x60, 0x85, 0x83, 0x64, 0x0d, 0x60, 0x4b, 0xdf, 0xa0, 0x31, 0x9c, 0x8a, 0xd8, 0xd2,
-  0xc3, 0x96, 0xdb, 0x97, 0x7f, 0xce, 0x78, 0xbf, 0xd7, 0xc0, 0x47, 0xc8, 0x60, 0x49, 0x98, 0x81, 0xad, 0x15, 0x03, 0x96,
-  0x8c, 0x06, 0xc7, 0x1a, 0xad, 0x5b, 0x6b, 0x6d, 0xa1, 0x5a, 0xaa, 0x6f, 0x90, 0x94, 0x51, 0x64, 0x09, 0x28, 0x03, 0xfd,
-  0x68, 0x12, 0x0b, 0xf5, 0xc2, 0x3c, 0x8a, 0x0b, 0x41, 0x93, 0x0e, 0x39, 0x25, 0x73, 0xbb, 0x48, 0xda, 0xc9, 0xe6, 0x8e,
-  0x98, 0x18, 0x6a, 0x8c, 0xf6, 0x72, 0x88, 0xff, 0xd8, 0x66, 0xc9, 0x7a, 0x8b, 0x72, 0x1a, 0x93, 0x37, 0xb4, 0x52, 0x9b,
-  0x6b, 0xa6, 0x3e, 0x09, 0xa3, 0xe6, 0xd4, 0xf6, 0x74, 0x57, 0x93, 0x54, 0x00, 0xa3, 0xd3, 0x77, 0x07, 0x5d, 0xfc, 0x9c,
-  0x65, 0x42, 0x5e, 0x9a, 0x50, 0x3d, 0x39, 0x75, 0x78, 0xad, 0x98, 0xe1, 0x0c, 0xd2, 0x33, 0x55, 0x20, 0xe0, 0x30, 0x84,
-  0xe9, 0xe1, 0x7e, 0x86, 0x08, 0xce, 0x48, 0x47, 0x00, 0x3c, 0x1f, 0x35, 0xf9, 0xaf, 0xfc, 0x70, 0xb4, 0x4a, 0x6e, 0x45,
-  0xea, 0x2d, 0xf5, 0x6a, 0x98, 0xa4, 0xea, 0x56, 0xaf, 0x05, 0x52, 0x35, 0xaa, 0xcb, 0x71, 0x30, 0x90, 0xe1, 0x56, 0x80,
-  0xac, 0xfb, 0x4b, 0x32, 0x72, 0xff, 0xa0, 0x8f, 0x86, 0x93, 0xc3, 0x3e, 0x1a, 0x3d, 0x9b, 0xf4, 0x85, 0x8e, 0x23, 0xd8,
-  0xfb, 0x93, 0x8f, 0x73, 0x32, 0x8e, 0x79, 0x9e, 0x6d, 0xa6, 0x33, 0x49, 0xe6, 0x32, 0x6f, 0xc1, 0x33, 0x00, 0x12, 0xc1,
-  0x0c, 0x27, 0xb6, 0xe2, 0x27, 0x38, 0x9b, 0x91, 0x94, 0x60, 0x6e, 0xe1, 0x9c, 0x27, 0x22, 0xb0, 0xfa, 0xc2, 0x3d, 0x11,
-  0xbe, 0xb3, 0x86, 0x07, 0x80, 0x02, 0x28, 0xb9, 0x60, 0xbd, 0x5e, 0x23, 0xf5, 0x4d, 0xb4, 0x54, 0x22, 0x93, 0xb8, 0xcd,
-  0x93, 0xb4, 0x09, 0xda, 0x76, 0x74, 0xba, 0x98, 0xad, 0x47, 0xa4, 0x87, 0x83, 0x25, 0xd9, 0xb4, 0x83, 0xc6, 0x21, 0x8d,
-  0x89, 0xfd, 0xc8, 0xca, 0x25, 0xd5, 0xec, 0x4a, 0xd0, 0xa2, 0x74, 0x36, 0x72, 0xd1, 0x76, 0x1a, 0xb7, 0x28, 0x79, 0x78,
-  0x78, 0xf8, 0x84, 0x14, 0xb6, 0x3d, 0x06, 0x0a, 0xde, 0x81, 0xa3, 0xcb, 0xba, 0xda, 0x61, 0xbe, 0x13, 0x88, 0xae, 0xaa,
-  0xce, 0xab, 0x22, 0x4e, 0xeb, 0x3e, 0x41, 0xbc, 0xb5, 0xb4, 0xdb, 0x87, 0xcc, 0xdb, 0x51, 0x5e, 0x2a, 0x96, 0xb4, 0xfd,
-  0xe8, 0x85, 0x89, 0xff, 0xae, 0x22, 0xcf, 0x4a, 0x34, 0x7a, 0x8f, 0x2a, 0xa1, 0x32, 0x39, 0xe9, 0xa0, 0x6b, 0x29, 0xe4,
-  0x57, 0x11, 0x09, 0x28, 0x46, 0x16, 0x70, 0xa7, 0x8e, 0x2e, 0x50, 0xb6, 0x57, 0xa1, 0x59, 0x76, 0x34, 0x5b, 0x73, 0x65,
-  0x03, 0x52, 0xb9, 0x08, 0x78, 0xcd, 0x78, 0x79, 0x42, 0xbb, 0x3c, 0x15, 0x28, 0xd8, 0xc3, 0x7a, 0x41, 0x55, 0xd7, 0xb5,
-  0x64, 0xa3, 0x25, 0x71, 0xf1, 0x39, 0x1d, 0x14, 0x0d, 0xec, 0x74, 0xa0, 0x1a, 0xec, 0xa9, 0xe8, 0x0e, 0x65, 0x67, 0xab,
-  0x14, 0x54, 0xad, 0xed, 0x34, 0xa0, 0xb7, 0xf3, 0x42, 0xea, 0x74, 0x35, 0x9c, 0xbf, 0xc8, 0x09, 0x87, 0x52, 0xf8, 0x9a,
-  0x9e, 0xd3, 0xb2, 0x29, 0x46, 0xa7, 0xd0, 0x79, 0x33, 0x0c, 0x72, 0x86, 0xd5, 0x4a, 0xd8, 0x85, 0xfc, 0x10, 0x67, 0xd9,
-  0xcc, 0x28, 0xbb, 0x13, 0x63, 0x7e, 0x4d, 0x08, 0x09, 0xd0, 0x35, 0xcf, 0x03, 0x9a, 0xa0, 0x46, 0x93, 0x7d, 0x4d, 0xe2,
-  0x8c, 0xa0, 0x7f, 0xfe, 0x03, 0xbd, 0xfc, 0x76, 0x7c, 0x70, 0xe0, 0x4e, 0x07, 0xd5, 0xa9, 0xfa, 0xa3, 0x26, 0x54, 0x12,
-  0xc4, 0x98, 0x4f, 0xa1, 0x0a, 0xc4, 0xe5, 0x18, 0xb0, 0x05, 0x46, 0x06, 0x62, 0xa8, 0x98, 0xa0, 0xc1, 0xcc, 0xa0, 0xa9,
-  0x1d, 0x62, 0x8f, 0x84, 0xc6, 0xfc, 0x35, 0x86, 0x74, 0x18, 0x2f, 0x01, 0x4b, 0x06, 0xfa, 0xdb, 0xe7, 0xf4, 0xc3, 0x8f,
-  0x7f, 0x2f, 0x97, 0x97, 0xa7, 0x28, 0x67, 0x08, 0xe3, 0xe5, 0xbd, 0x02, 0x0a, 0x6b, 0x29, 0x5d, 0x79, 0xd4, 0x28, 0x54,
-  0xc9, 0x14, 0x66, 0xf2, 0x84, 0x1a, 0x0c, 0xa3, 0x5c, 0x2c, 0x1b, 0x1e, 0xa3, 0xf2, 0x06, 0x8d, 0x96, 0xda, 0x4a, 0x03,
-  0x65, 0xcc, 0x9f, 0x19, 0x83, 0xf2, 0x0d, 0x87, 0x70, 0x49, 0xb9, 0x14, 0x09, 0xb2, 0x1c, 0x19, 0x74, 0xfa, 0x51, 0xe6,
-  0xb6, 0x4a, 0x68, 0x01, 0xcd, 0x2b, 0x02, 0x91, 0x97, 0x2b, 0xfe, 0xc0, 0x95, 0x84, 0x25, 0x71, 0x79, 0x94, 0x58, 0x6d,
-  0xb3, 0x6a, 0x1a, 0xdc, 0xff, 0xed, 0x97, 0x27, 0x02, 0x75, 0xb1, 0x66, 0xae, 0xf9, 0xb5, 0x92, 0xf5, 0xdb, 0x1c, 0x98,
-  0xc7, 0xef, 0x3b, 0x05, 0x7d, 0xaf, 0xe6, 0x8c, 0xf9, 0x87, 0x1f, 0xff, 0xba, 0x53, 0xc8, 0x15, 0x61, 0xe0, 0xe0, 0x08,
-  0xc7, 0x3e, 0xe9, 0x14, 0x94, 0xd6, 0xf3, 0xc6, 0xfc, 0x0b, 0x1c, 0x8a, 0x87, 0xa0, 0x5b, 0x62, 0xf3, 0x25, 0x2d, 0x1d,
-  0x21, 0xe2, 0xd4, 0x98, 0xdf, 0x00, 0x61, 0x0a, 0xf1, 0xf3, 0xc2, 0x95, 0x95, 0x14, 0x84, 0x33, 0xc4, 0x57, 0x04, 0xad,
-  0x89, 0xe7, 0x43, 0x83, 0x76, 0xf3, 0xea, 0x12, 0x22, 0x1e, 0x49, 0xea, 0xbe, 0x26, 0x1e, 0x3a, 0x55, 0xad, 0x87, 0x33,
-  0x1d, 0xa4, 0x25, 0xc9, 0x0a, 0x3c, 0x25, 0xec, 0x1a, 0xbc, 0xdd, 0x70, 0x6a, 0xa0, 0x94, 0x9d, 0x53, 0x0b, 0x96, 0xd6,
-  0xb4, 0x6a, 0x96, 0xb4, 0x35, 0xdd, 0xab, 0x8a, 0x30, 0xa9, 0x21, 0x6d, 0xf9, 0xb7, 0x15, 0x02, 0x55, 0xa3, 0x63, 0x48,
-  0xff, 0x02, 0xd4, 0xb6, 0x1a, 0xcb, 0x1a, 0x27, 0xc1, 0xae, 0xa2, 0xad, 0x29, 0x36, 0xaa, 0x6a, 0x6c, 0xa0, 0x00, 0x73,
-  0x6c, 0x63, 0x69, 0xe8, 0xcc, 0x58, 0x30, 0x08, 0x62, 0x91, 0xe0, 0x8a, 0xf1, 0x5b, 0x1c, 0xe6, 0x70, 0x9d, 0x16, 0x9c,
-  0x51, 0xcc, 0x41, 0xd6, 0xc4, 0x75, 0xff, 0xf5, 0xb7, 0x03, 0xd7, 0xed, 0x4d, 0x07, 0x4a, 0x60, 0xf7, 0x29, 0x8f, 0x11,
-  0x7b, 0xfe, 0xd5, 0x0b, 0x63, 0xfe, 0x15, 0x64, 0x72, 0x34, 0x80, 0x4c, 0x0e, 0xdd, 0x77, 0x97, 0xc8, 0x36, 0xbb, 0x36,
-  0xc9, 0xf6, 0x1f, 0xb9, 0xf9, 0xd7, 0x57, 0x67, 0x5f, 0xa2, 0x82, 0xf2, 0x4f, 0x72, 0x74, 0x11, 0x0a, 0x1f, 0x71, 0x76,
-  0xc3, 0x0d, 0x65, 0xf4, 0x34, 0x9c, 0x30, 0x9c, 0x18, 0xf3, 0xcb, 0x64, 0xbd, 0xdb, 0x9b, 0xbb, 0x30, 0xeb, 0x96, 0x3a,
-  0x32, 0xe6, 0x5f, 0x43, 0x09, 0xca, 0xa3, 0x27, 0xc0, 0xd4, 0x2d, 0xc9, 0x55, 0x18, 0xfd, 0x1f, 0xb0, 0xd1, 0x92, 0xc8,
-  0x93, 0xa0, 0x11, 0xc9, 0xe5, 0x29, 0xb8, 0xa8, 0xbc, 0xf1, 0x5d, 0x40, 0x20, 0xbb, 0x37, 0x8d, 0x87, 0xdb, 0x96, 0x44,
-  0x07, 0x59, 0x1f, 0xfe, 0xf2, 0xe7, 0x31, 0x5a, 0xa4, 0x59, 0xef, 0xa7, 0x03, 0xb5, 0xfd, 0x98, 0xa1, 0x38, 0x46, 0xc1,
-  0x25, 0x4f, 0x3a, 0x78, 0xc4, 0x49, 0x8f, 0x14, 0x5d, 0xa0, 0x27, 0x3b, 0x91, 0xad, 0x52, 0x77, 0xe1, 0xd8, 0xa8, 0xc2,
-  0x55, 0x82, 0x14, 0x2f, 0xa2, 0x2e, 0xaa, 0x0a, 0x99, 0xf9, 0x8c, 0xa6, 0x5c, 0x2d, 0x02, 0x0c, 0x33, 0x8e, 0x54, 0x9a,
-  0xaf, 0x73, 0x18, 0x9a, 0xa1, 0x20, 0xf1, 0xf3, 0x08, 0x3a, 0x30, 0x67, 0x49, 0xf8, 0x59, 0x48, 0xc4, 0xe3, 0x17, 0xf7,
-  0x17, 0x81, 0x65, 0x6e, 0x14, 0x29, 0xb3, 0x68, 0x10, 0x75, 0x51, 0x45, 0x88, 0x3e, 0x42, 0x4e, 0xc1, 0xe2, 0x2e, 0x21,
-  0x1a, 0xa1, 0x1e, 0x21, 0x48, 0xab, 0x51, 0x4d, 0x61, 0x34, 0xbd, 0x14, 0xbd, 0xc4, 0x2e, 0x11, 0x65, 0xbf, 0x21, 0x36,
-  0xca, 0x9d, 0x8b, 0x3c, 0x56, 0xc5, 0x24, 0x23, 0xfc, 0x44, 0xb2, 0xc3, 0x52, 0x38, 0xf4, 0x91, 0x8c, 0x89, 0x6b, 0x12,
-  0x82, 0x6f, 0x13, 0x56, 0x37, 0x88, 0x95, 0xec, 0xef, 0x73, 0xc2, 0xee, 0xcb, 0xf9, 0x93, 0x30, 0xb4, 0x1a, 0x1b, 0xd0,
-  0x2f, 0x91, 0x59, 0xdc, 0xb0, 0xcc, 0x9e, 0x03, 0x0a, 0x9f, 0x61, 0x7f, 0x65, 0x79, 0x1c, 0x5c, 0x3e, 0x47, 0xf0, 0xe5,
-  0x48, 0x4a, 0x5e, 0xd2, 0x8c, 0x3b, 0xd0, 0xb0, 0xc2, 0x55, 0xce, 0x32, 0x15, 0x3b, 0xcd, 0xfa, 0x26, 0x53, 0x5c, 0xd0,
-  0xea, 0x95, 0xd0, 0x2e, 0xd6, 0xcb, 0xca, 0x9e, 0x5c, 0x7e, 0xe1, 0xec, 0x3e, 0xf6, 0x75, 0x6b, 0xe2, 0xe0, 0x34, 0x89,
-  0xc0, 0x49, 0x81, 0x05, 0xbd, 0x32, 0xc5, 0x5e, 0x48, 0xfa, 0x48, 0x72, 0xaf, 0xb6, 0x04, 0xaf, 0xa1, 0xe7, 0x42, 0x0b,
-  0xc2, 0x41, 0xb1, 0x37, 0x83, 0x22, 0xc8, 0x3f, 0x87, 0xe5, 0xb3, 0xcf, 0x1e, 0xca, 0x4d, 0xef, 0x7f, 0x0e, 0x9b, 0xe0,
-  0x9d, 0xc4, 0x7e, 0x12, 0x90, 0x9b, 0x57, 0x17, 0x20, 0x35, 0x4d, 0x62, 0xb0, 0xdf, 0x52, 0xd2, 0xde, 0xbf, 0xa9, 0xd4,
-  0x65, 0x64, 0x01, 0x64, 0x59, 0x5d, 0x4b, 0x98, 0xac, 0xa6, 0x7e, 0x95, 0x66, 0x11, 0x4e, 0x35, 0xb8, 0x2d, 0x19, 0x1a,
-  0xb5, 0x4a, 0x74, 0x81, 0xd4, 0x10, 0x9a, 0xcd, 0x66, 0xc8, 0xed, 0x81, 0x4c, 0x9e, 0xb3, 0x18, 0x99, 0x22, 0x58, 0xcc,
-  0xe3, 0x8d, 0x55, 0xd3, 0x19, 0xb4, 0xce, 0xda, 0x32, 0x15, 0xac, 0x66, 0xad, 0x91, 0x1a, 0x86, 0x54, 0x61, 0x76, 0xab,
-  0x23, 0xd9, 0x70, 0xce, 0x92, 0xe8, 0xbc, 0xac, 0x85, 0x96, 0xf8, 0xa9, 0xba, 0xa9, 0xd1, 0xa7, 0x6a, 0xa8, 0x94, 0x26,
-  0x0a, 0x6e, 0x43, 0x17, 0x31, 0xed, 0xf0, 0xe4, 0x26, 0x05, 0x6a, 0x9e, 0xc2, 0x1d, 0xde, 0xea, 0x49, 0xf5, 0x4d, 0x28,
-  0xa4, 0x66, 0xbd, 0x4d, 0x96, 0xd2, 0xb6, 0x6a, 0x9b, 0x5b, 0xbb, 0xf5, 0x6c, 0xf9, 0xb6, 0x52, 0x4f, 0xa1, 0x67, 0x0e,
-  0x54, 0x6c, 0x98, 0xbd, 0x2a, 0x59, 0x38, 0xd0, 0x62, 0xc5, 0x16, 0x13, 0x6c, 0x63, 0xce, 0xdb, 0x2c, 0x89, 0xad, 0x5e,
-  0x7b, 0x52, 0xe4, 0x23, 0x31, 0xff, 0xa0, 0xa5, 0x9c, 0x76, 0x82, 0x70, 0xc4, 0xc5, 0xf0, 0x54, 0x5d, 0x02, 0x21, 0xb0,
-  0x3a, 0xdc, 0x25, 0xa4, 0x38, 0x55, 0x27, 0xf1, 0x9d, 0x30, 0x08, 0xfd, 0xf0, 0x43, 0xe1, 0xa5, 0x8a, 0x1b, 0xb5, 0xec,
-  0x22, 0x63, 0xb4, 0x04, 0x4b, 0x29, 0x45, 0x8a, 0xd8, 0xdc, 0xa3, 0x31, 0xa6, 0xb5, 0xaf, 0x45, 0xa7, 0xdf, 0xe4, 0x91,
-  0x47, 0x98, 0xd2, 0x49, 0x4f, 0xbe, 0xbd, 0x32, 0xde, 0x3f, 0x16, 0xc3, 0xe6, 0x9e, 0xd6, 0xa9, 0x6d, 0x8d, 0xdf, 0x87,
-  0x46, 0xea, 0x17, 0x14, 0xd8, 0xea, 0x06, 0xd8, 0xbc, 0xc9, 0x0c, 0x11, 0xff, 0x62, 0x03, 0x24, 0x1d, 0x47, 0x86, 0x51,
-  0x73, 0x4d, 0xaf, 0x75, 0x00, 0xd2, 0xb3, 0x13, 0x87, 0xd4, 0xd4, 0xd0, 0xb2, 0xe9, 0x64, 0x54, 0x5d, 0x33, 0xe5, 0xf3,
-  0xe3, 0xed, 0x6e, 0x35, 0x4e, 0x4f, 0xb0, 0xbd, 0x70, 0xfa, 0x86, 0x51, 0xca, 0x56, 0x1d, 0x92, 0xe2, 0x8c, 0xc7, 0x18,
-  0xd8, 0x52, 0xe7, 0xbf, 0x64, 0xa4, 0xde, 0x82, 0xfc, 0x4f, 0x2c, 0x6c, 0x92, 0xee, 0xe3, 0x66, 0xea, 0x0a, 0x7d, 0xcc,
-  0xc6, 0xfa, 0xb9, 0x0e, 0x64, 0x1f, 0x8b, 0xf8, 0x17, 0xb4, 0x02, 0xbd, 0xdf, 0x6f, 0x49, 0x1e, 0xe2, 0xff, 0x69, 0xc5,
-  0xb5, 0x4a, 0xcf, 0x1d, 0x3b, 0x1c, 0xa5, 0x34, 0xfa, 0x83, 0xd6, 0xcc, 0xfc, 0x71, 0x97, 0x9f, 0x84, 0x63, 0xa0, 0x36,
-  0x9d, 0xdd, 0x82, 0x34, 0x51, 0xa8, 0x48, 0x0c, 0xfe, 0x30, 0xfd, 0x90, 0xfa, 0xef, 0xcc, 0x3e, 0x2a, 0xb4, 0xd3, 0xac,
-  0x51, 0xf5, 0xba, 0xac, 0x31, 0xa8, 0x19, 0x10, 0xea, 0xbc, 0xe3, 0x8e, 0xe5, 0xe0, 0x71, 0xd4, 0x11, 0x3c, 0x8d, 0x7c,
-  0xd1, 0x74, 0xf0, 0x9b, 0xbd, 0xcf, 0x1e, 0xc4, 0xfa, 0x14, 0x33, 0x50, 0xad, 0x68, 0x05, 0x1c, 0x1a, 0x68, 0x55, 0x4b,
-  0xed, 0xda, 0x5e, 0x2e, 0x75, 0xbf, 0x97, 0xcf, 0xdb, 0x1c, 0x0d, 0xa7, 0x5f, 0xa4, 0x1b, 0xd9, 0x79, 0x4d, 0xe3, 0x20,
-  0x59, 0x3b, 0x61, 0x02, 0x60, 0x89, 0x94, 0x9a, 0x30, 0xba, 0xa4, 0xa0, 0xdc, 0x03, 0x8a, 0x08, 0x5f, 0x25, 0xc1, 0x11,
-  0x94, 0xb7, 0xb3, 0x93, 0x17, 0x66, 0x03, 0x58, 0x99, 0xa1, 0x0b, 0xcf, 0x95, 0x9d, 0x4d, 0x2b, 0xf7, 0x75, 0xcb, 0x3d,
-  0xde, 0xce, 0x8f, 0x2d, 0x72, 0x4c, 0x78, 0x8c, 0x01, 0x7b, 0x12, 0x98, 0xc7, 0x6d, 0xd3, 0x9a, 0xd4, 0x51, 0x53, 0x9d,
-  0x75, 0xbe, 0x30, 0xbd, 0x7e, 0x11, 0xbf, 0x75, 0x82, 0x07, 0xad, 0xc6, 0xea, 0x3e, 0xda, 0x77, 0xe1, 0x8e, 0x7a, 0xac,
-  0x7e, 0xe2, 0x2a, 0xda, 0x53, 0x68, 0x7d, 0xe5, 0x8f, 0x5b, 0xd3, 0x81, 0xfa, 0x27, 0xf3, 0xbf, 0x01, 0xd7, 0xc4, 0x2c,
-  0x0d, 0x75, 0x1e, 0x00, 0x00,
-};
-
-const size_t index_ov3660_html_gz_len = 2405;
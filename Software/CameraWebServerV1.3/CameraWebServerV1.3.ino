@@ -5,6 +5,11 @@
 // Select camera model in board_config.h
 // ===========================
 #include "board_config.h"
+#include "camera_board.h"
+#include "settings.h"
+#include "sensor_roi.h"
+#include "wifi_link.h"
+#include "power_idle.h"
 
 // ===========================
 // Enter your WiFi credentials
@@ -13,12 +18,14 @@ const char *ssid = "Dinosaurs";
 const char *password = "JurassicJulia00!";
 
 // ===========================
-// User LED Configuration
-// GPIO21, active LOW (0 = ON, 1 = OFF)
+// Status LED Configuration
+// Pin and polarity come from camera_pins.h (GPIO21, active LOW on the XIAO,
+// where TIMELAPSE builds give the pin to the SD card and have no LED)
 // ===========================
-#define USER_LED_GPIO 21
-#define LED_ON  LOW
-#define LED_OFF HIGH
+#if defined(STATUS_LED_GPIO_NUM)
+#define LED_ON  STATUS_LED_ON
+#define LED_OFF (!STATUS_LED_ON)
+#endif
 
 // LED state machine
 enum LedMode {
@@ -36,14 +43,22 @@ bool camera_initialized = false;
 bool wifi_connected = false;
 bool server_started = false; // Set by startCameraServer() in app_httpd.cpp
 unsigned long wifi_connect_start_ms = 0;
+camera_config_t camera_config = {}; // Active driver config (re-used by the benchmark in app_httpd.cpp)
 const unsigned long WIFI_CONNECT_TIMEOUT_MS = 30000; // 30 seconds
 
+// Boot phase timings in ms since reset, reported by /status (0 = not reached yet).
+// The IP phase is tracked by wifi_link.
+uint32_t boot_camera_ms = 0;
+uint32_t boot_server_ms = 0;
+
 void startCameraServer();
+uint32_t cameraServerSessions();
+bool cameraServerBackground();
 void setLedMode(LedMode mode);
 void updateLed();
 bool initCamera();
-bool connectWiFi();
 void checkWiFiStatus();
+void startHttpServer();
 
 // ===========================
 // LED Status Management
@@ -53,13 +68,10 @@ void setLedMode(LedMode mode) {
   last_led_toggle_ms = millis();
   
   // Immediately set LED state based on mode
-  if (mode == LED_MODE_READY) {
-    digitalWrite(USER_LED_GPIO, LED_ON);
-    led_state = true;
-  } else {
-    digitalWrite(USER_LED_GPIO, LED_OFF);
-    led_state = false;
-  }
+  led_state = (mode == LED_MODE_READY);
+#if defined(STATUS_LED_GPIO_NUM)
+  digitalWrite(STATUS_LED_GPIO_NUM, led_state ? LED_ON : LED_OFF);
+#endif
 }
 
 void updateLed() {
@@ -80,7 +92,9 @@ void updateLed() {
   
   if (now - last_led_toggle_ms >= interval_ms) {
     led_state = !led_state;
-    digitalWrite(USER_LED_GPIO, led_state ? LED_ON : LED_OFF);
+#if defined(STATUS_LED_GPIO_NUM)
+    digitalWrite(STATUS_LED_GPIO_NUM, led_state ? LED_ON : LED_OFF);
+#endif
     last_led_toggle_ms = now;
   }
 }
@@ -91,44 +105,47 @@ void updateLed() {
 bool initCamera() {
   Serial.println("Initializing camera...");
   
+  // Pins and clock from the compile-time board/sensor descriptors (camera_board.h)
+  constexpr const camera_board_desc_t &board = CAMERA_BOARD_DESC;
   camera_config_t config = {};
   config.ledc_channel = LEDC_CHANNEL_0;
   config.ledc_timer = LEDC_TIMER_0;
-  config.pin_d0 = Y2_GPIO_NUM;
-  config.pin_d1 = Y3_GPIO_NUM;
-  config.pin_d2 = Y4_GPIO_NUM;
-  config.pin_d3 = Y5_GPIO_NUM;
-  config.pin_d4 = Y6_GPIO_NUM;
-  config.pin_d5 = Y7_GPIO_NUM;
-  config.pin_d6 = Y8_GPIO_NUM;
-  config.pin_d7 = Y9_GPIO_NUM;
-  config.pin_xclk = XCLK_GPIO_NUM;
-  config.pin_pclk = PCLK_GPIO_NUM;
-  config.pin_vsync = VSYNC_GPIO_NUM;
-  config.pin_href = HREF_GPIO_NUM;
-  config.pin_sccb_sda = SIOD_GPIO_NUM;
-  config.pin_sccb_scl = SIOC_GPIO_NUM;
-  config.pin_pwdn = PWDN_GPIO_NUM;
-  config.pin_reset = RESET_GPIO_NUM;
-  config.xclk_freq_hz = 20000000;
+  config.pin_d0 = board.pin_d[0];
+  config.pin_d1 = board.pin_d[1];
+  config.pin_d2 = board.pin_d[2];
+  config.pin_d3 = board.pin_d[3];
+  config.pin_d4 = board.pin_d[4];
+  config.pin_d5 = board.pin_d[5];
+  config.pin_d6 = board.pin_d[6];
+  config.pin_d7 = board.pin_d[7];
+  config.pin_xclk = board.pin_xclk;
+  config.pin_pclk = board.pin_pclk;
+  config.pin_vsync = board.pin_vsync;
+  config.pin_href = board.pin_href;
+  config.pin_sccb_sda = board.pin_sda;
+  config.pin_sccb_scl = board.pin_scl;
+  config.pin_pwdn = board.pin_pwdn;
+  config.pin_reset = board.pin_reset;
+  config.xclk_freq_hz = CAMERA_SENSOR_DESC.xclk_freq_hz;
   config.pixel_format = PIXFORMAT_JPEG;
   
-  // Default to SVGA (800x600) for smooth streaming
-  config.frame_size = FRAMESIZE_SVGA;
+  // Stored settings (the sensor's defaults on first boot) go straight into the driver
+  // config, so the sensor is configured once and the first frame already uses them
+  config.frame_size = (framesize_t)camera_settings.framesize;
+  config.jpeg_quality = camera_settings.quality;
   
   const bool hasPsram = psramFound();
   config.fb_location = hasPsram ? CAMERA_FB_IN_PSRAM : CAMERA_FB_IN_DRAM;
-  config.fb_count = hasPsram ? 2 : 1;
-  config.jpeg_quality = hasPsram ? 12 : 16;
+  config.fb_count = hasPsram ? CAMERA_FB_COUNT_PSRAM : 1;
   config.grab_mode = hasPsram ? CAMERA_GRAB_LATEST : CAMERA_GRAB_WHEN_EMPTY;
   
   if (!hasPsram) {
     Serial.println("WARNING: No PSRAM detected, using DRAM only");
-    config.frame_size = FRAMESIZE_SVGA;
   } else {
     Serial.println("PSRAM detected, using PSRAM for frame buffers");
   }
   
+  camera_config = config;
   esp_err_t err = esp_camera_init(&config);
   if (err != ESP_OK) {
     Serial.printf("ERROR: Camera init failed with error 0x%x\n", err);
@@ -143,11 +160,19 @@ bool initCamera() {
   
   applySensorDefaults(s);
   
-  // Ensure SVGA is set (may have been overridden by defaults)
-  s->set_framesize(s, FRAMESIZE_SVGA);
-  s->set_quality(s, config.jpeg_quality);
+#if CAMERA_WARMUP_FRAMES > 0
+  // Capture and discard a few frames so auto exposure has settled before the
+  // first /snapshot (DWC polls from the moment the server is up)
+  for (int i = 0; i < CAMERA_WARMUP_FRAMES; i++) {
+    camera_fb_t *fb = esp_camera_fb_get();
+    if (fb) {
+      esp_camera_fb_return(fb);
+    }
+  }
+#endif
   
-  Serial.println("Camera initialized successfully");
+  Serial.printf("Camera initialized successfully (framesize %u, quality %u)\n",
+                camera_settings.framesize, camera_settings.quality);
   return true;
 }
 
@@ -156,15 +181,17 @@ static void applySensorDefaults(sensor_t *s) {
     return;
   }
   
-  // OV3660 specific defaults
-  if (s->id.PID == OV3660_PID) {
-    // Default orientation: normal (can be changed via /control)
-    s->set_vflip(s, 0);
-    s->set_hmirror(s, 0);
-    s->set_brightness(s, 0);
-    s->set_saturation(s, 0);
+  if (s->id.PID != CAMERA_SENSOR_DESC.pid) {
+    Serial.printf("WARNING: Detected sensor PID 0x%x, this build is tuned for %s\n", s->id.PID,
+                  CAMERA_SENSOR_DESC.name);
   }
   
+#if CAMERA_SENSOR == CAMERA_SENSOR_OV3660
+  // OV3660 specific defaults
+  s->set_brightness(s, 0);
+  s->set_saturation(s, 0);
+#endif
+  
   // Enable auto features for indoor use
   s->set_lenc(s, 1);           // Lens correction
   s->set_whitebal(s, 1);       // Auto white balance
@@ -173,58 +200,49 @@ static void applySensorDefaults(sensor_t *s) {
   s->set_gain_ctrl(s, 1);      // Auto gain
   s->set_special_effect(s, 0); // No special effects
   s->set_colorbar(s, 0);       // No test pattern
+
+  // Orientation as last set via /control
+  s->set_vflip(s, camera_settings.vflip);
+  s->set_hmirror(s, camera_settings.hmirror);
+
+  // Stored region of interest (no-op at full frame)
+  camera_roi_t roi = {camera_settings.roi_zoom, camera_settings.roi_x, camera_settings.roi_y};
+  if (roi_set(s, &roi) != 0) {
+    Serial.println("WARNING: Failed to apply the stored region of interest");
+  }
 }
 
 // ===========================
-// WiFi Connection (Non-blocking)
+// WiFi Link Status
 // ===========================
-bool connectWiFi() {
-  Serial.println("Starting WiFi connection...");
-  WiFi.setSleep(false); // Disable WiFi sleep for stable streaming
-  WiFi.mode(WIFI_STA);
-  WiFi.begin(ssid, password);
-  
-  wifi_connect_start_ms = millis();
-  wifi_connected = false;
-  
-  return true; // Connection attempt started
-}
-
+// Association and reconnects (with backoff) are handled by wifi_link; this only
+// reports transitions. The HTTP server and camera keep running across drops.
 void checkWiFiStatus() {
-  if (wifi_connected) {
-    // Check if WiFi is still connected
-    if (WiFi.status() != WL_CONNECTED) {
-      Serial.println("WARNING: WiFi connection lost!");
-      wifi_connected = false;
-      server_started = false;
+  wifi_link_poll();
+  
+  bool up = wifi_link_up();
+  if (up == wifi_connected) {
+    if (!up && boot_server_ms == 0 && led_mode != LED_MODE_ERROR &&
+        millis() - wifi_connect_start_ms > WIFI_CONNECT_TIMEOUT_MS) {
+      Serial.println("ERROR: WiFi connection timeout, still retrying");
       setLedMode(LED_MODE_ERROR);
     }
     return;
   }
   
-  // Check connection status
-  wl_status_t status = WiFi.status();
-  
-  if (status == WL_CONNECTED) {
-    if (!wifi_connected) {
-      wifi_connected = true;
-      IPAddress ip = WiFi.localIP();
-      Serial.println("");
-      Serial.println("WiFi connected!");
-      Serial.printf("IP address: %d.%d.%d.%d\n", ip[0], ip[1], ip[2], ip[3]);
-      Serial.printf("RSSI: %d dBm\n", WiFi.RSSI());
-    }
-  } else if (status == WL_CONNECT_FAILED || status == WL_NO_SSID_AVAIL) {
-    // Connection failed, check timeout
-    if (millis() - wifi_connect_start_ms > WIFI_CONNECT_TIMEOUT_MS) {
-      Serial.println("ERROR: WiFi connection timeout");
-      setLedMode(LED_MODE_ERROR);
+  wifi_connected = up;
+  if (up) {
+    IPAddress ip = WiFi.localIP();
+    Serial.println("WiFi connected!");
+    Serial.printf("IP address: %d.%d.%d.%d\n", ip[0], ip[1], ip[2], ip[3]);
+    Serial.printf("RSSI: %d dBm\n", WiFi.RSSI());
+    if (server_started) {
+      setLedMode(LED_MODE_READY);
     }
   } else {
-    // Still connecting
-    unsigned long elapsed = millis() - wifi_connect_start_ms;
-    if (elapsed % 2000 < 100) { // Print every 2 seconds
-      Serial.print(".");
+    Serial.println("WARNING: WiFi connection lost, reconnecting...");
+    if (camera_initialized) {
+      setLedMode(LED_MODE_CONNECTING);
     }
   }
 }
@@ -239,29 +257,72 @@ void setup() {
   
   Serial.println();
   Serial.println("========================================");
-  Serial.println("XIAO ESP32-S3 Sense Camera Web Server");
-  Serial.println("Board: Seeed Studio XIAO ESP32-S3 Sense");
-  Serial.println("Camera: OV3660");
+  Serial.println("ESP32 Camera Web Server");
+  Serial.printf("Board: %s\n", CAMERA_BOARD_DESC.name);
+  Serial.printf("Camera: %s\n", CAMERA_SENSOR_DESC.name);
   Serial.println("Use case: Duet 2 WiFi 3D printer monitor");
   Serial.println("========================================");
   
-  // Initialize user LED (GPIO21, active LOW)
-  pinMode(USER_LED_GPIO, OUTPUT);
+  // Initialize status LED
+#if defined(STATUS_LED_GPIO_NUM)
+  pinMode(STATUS_LED_GPIO_NUM, OUTPUT);
+  Serial.printf("Status LED initialized (GPIO%d)\n", STATUS_LED_GPIO_NUM);
+#endif
   setLedMode(LED_MODE_CONNECTING);
-  Serial.println("User LED initialized (GPIO21, active LOW)");
   
-  // Initialize camera
+  if (!settings_load()) {
+    Serial.println("No stored settings, using defaults");
+  }
+  
+  // Start WiFi first: association and DHCP run in the WiFi task while the
+  // sensor is being initialised below
+  Serial.println("Starting WiFi connection...");
+  wifi_connect_start_ms = millis();
+  wifi_link_begin(ssid, password);
+  
+  // Initialize camera with the stored settings
   camera_initialized = initCamera();
   if (!camera_initialized) {
     Serial.println("FATAL: Camera initialization failed, entering error state");
     setLedMode(LED_MODE_ERROR);
     return; // Continue anyway, LED will show error
   }
+  boot_camera_ms = millis();
   
-  // Start WiFi connection (non-blocking)
-  connectWiFi();
+  // Note: HTTP server is started from loop() as soon as the IP is assigned
+}
+
+// ===========================
+// HTTP Server Startup
+// ===========================
+void startHttpServer() {
+  Serial.println("Starting HTTP server...");
+  startCameraServer();
   
-  // Note: HTTP server will be started in loop() once WiFi is connected
+  if (server_started) {
+    if (boot_server_ms == 0) {
+      wifi_link_status_t link;
+      wifi_link_get_status(&link);
+      boot_server_ms = millis();
+      Serial.printf("Boot timings: camera %u ms, IP %u ms, server %u ms%s\n",
+                    (unsigned)boot_camera_ms, (unsigned)link.first_ip_ms, (unsigned)boot_server_ms,
+                    link.fast_connect ? " (fast connect)" : "");
+    }
+    Serial.println("HTTP server started successfully");
+    Serial.print("Camera Ready! Use 'http://");
+    Serial.print(WiFi.localIP());
+    Serial.println("/' to connect");
+#if SNAPSHOT_SERVER_PORT
+    Serial.printf("DWC Webcam URL: http://%s:%u/snapshot\n", WiFi.localIP().toString().c_str(),
+                  SNAPSHOT_SERVER_PORT);
+#else
+    Serial.println("Stream URL for Duet: http://" + WiFi.localIP().toString() + "/stream");
+#endif
+    setLedMode(LED_MODE_READY);
+  } else {
+    Serial.println("ERROR: Failed to start HTTP server");
+    setLedMode(LED_MODE_ERROR);
+  }
 }
 
 // ===========================
@@ -274,24 +335,23 @@ void loop() {
   // Check WiFi connection status
   checkWiFiStatus();
   
-  // Start HTTP server once WiFi is connected
-  if (wifi_connected && camera_initialized && !server_started) {
-    Serial.println("Starting HTTP server...");
-    startCameraServer();
-    
-    if (server_started) {
-      Serial.println("HTTP server started successfully");
-      Serial.print("Camera Ready! Use 'http://");
-      Serial.print(WiFi.localIP());
-      Serial.println("/' to connect");
-      Serial.println("Stream URL for Duet: http://" + WiFi.localIP().toString() + "/stream");
-      setLedMode(LED_MODE_READY);
-    } else {
-      Serial.println("ERROR: Failed to start HTTP server");
-      setLedMode(LED_MODE_ERROR);
+  // Start HTTP server once an IP is assigned. Waiting on the link (rather than
+  // a fixed delay) wakes loop() the moment GOT_IP fires; the timeout keeps the
+  // LED blinking meanwhile. The server is started once and survives link drops.
+  if (camera_initialized && !server_started) {
+    if (wifi_link_wait_up(10)) {
+      startHttpServer();
     }
+    return;
   }
-  
+
+#if IDLE_POWER_SAVE
+  // Nobody watching: modem sleep, low clock and sensor standby until a request
+  // comes in; a request cuts the slower idle poll short to have loop() wake it
+  power_idle_poll(cameraServerSessions(), cameraServerBackground());
+  power_idle_sleep(power_idle_active() ? IDLE_LOOP_DELAY_MS : 10);
+#else
   // Small delay to prevent watchdog issues
   delay(10);
+#endif
 }
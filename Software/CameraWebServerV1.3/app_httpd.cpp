@@ -1,12 +1,29 @@
 #include "esp_http_server.h"
 #include "esp_timer.h"
 #include "esp_camera.h"
-#include "img_converters.h"
-#include "camera_index.h"
+#include "web_assets.h"
 #include "board_config.h"
+#include "frame_pipeline.h"
+#include "stream_writer.h"
+#include "preview_stage.h"
+#include "metrics.h"
+#include "benchmark.h"
+#include "motion_stage.h"
+#include "clip_recorder.h"
+#include "timelapse.h"
+#include "settings.h"
+#include "wifi_link.h"
+#include "camera_board.h"
+#include "rate_control.h"
+#include "rtsp_server.h"
+#include "sensor_roi.h"
+#include "power_idle.h"
 
 #include <esp32-hal-psram.h>
 #include <WiFi.h>
+#include <errno.h>
+#include "lwip/sockets.h"
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
@@ -17,39 +34,52 @@
 
 // External flag to track server status
 extern bool server_started;
+extern uint32_t boot_camera_ms;     // Boot phase timings, ms since reset
+extern uint32_t boot_server_ms;
 
 // HTTP server handle (single server on port 80)
 static httpd_handle_t camera_httpd = nullptr;
+#if SNAPSHOT_SERVER_PORT
+// Separate /snapshot server for Duet Web Control, so its polling never queues
+// behind UI requests on port 80
+static httpd_handle_t snapshot_httpd = nullptr;
+#endif
 
-// User-tunable stream pacing (set via /control?var=stream_delay&val=###)
-static uint16_t stream_delay_ms = 0;
+// Stream pacing: target frame interval, 0 = as fast as frames arrive.
+// Set via /control?var=target_fps&val=## or the legacy ?var=stream_delay&val=### (ms);
+// a compile-time constant under STREAM_PACING_FIXED
+#if STREAM_PACING == STREAM_PACING_FIXED
+static const uint32_t stream_interval_us = STREAM_FIXED_INTERVAL_MS * 1000;
+#else
+static uint32_t stream_interval_us = 0;
+#endif
 
-typedef struct {
-  httpd_req_t *req;
-  size_t len;
-} jpg_chunking_t;
+// Achieved stream rate (smoothed), as reported in /status
+static float stream_achieved_fps = 0;
+static int64_t stream_last_frame_us = 0;
 
-#define PART_BOUNDARY "123456789000000000000987654321"
-static const char *_STREAM_CONTENT_TYPE = "multipart/x-mixed-replace;boundary=" PART_BOUNDARY;
-static const char *_STREAM_BOUNDARY = "\r\n--" PART_BOUNDARY "\r\n";
-static const char *_STREAM_PART = "Content-Type: image/jpeg\r\nContent-Length: %u\r\nX-Timestamp: %d.%06d\r\n\r\n";
+// Open /stream sessions, capped at STREAM_MAX_CLIENTS
+static uint32_t stream_clients = 0;
 
-static size_t jpg_encode_stream(void *arg, size_t index, const void *data, size_t len) {
-  jpg_chunking_t *j = (jpg_chunking_t *)arg;
-  if (!index) {
-    j->len = 0;
-  }
-  if (httpd_resp_send_chunk(j->req, (const char *)data, len) != ESP_OK) {
-    return 0;
-  }
-  j->len += len;
-  return len;
-}
+// Serve /capture and /snapshot from the latest-frame cache when it is at most
+// this old (set via /control?var=snapshot_max_age&val=###, 0 = always wait for a new frame)
+static uint16_t snapshot_max_age_ms = 250;
 
-// /capture and /snapshot: single JPEG frame
+// How long a consumer waits on the frame pipeline before re-checking for errors
+static const uint32_t FRAME_WAIT_TIMEOUT_MS = 1000;
+
+// /capture and /snapshot: single JPEG frame, served from the latest-frame cache when fresh
 static esp_err_t capture_handler(httpd_req_t *req) {
-  camera_fb_t *fb = esp_camera_fb_get();
-  if (!fb) {
+  frame_t *frame = frame_pipeline_get_latest(snapshot_max_age_ms);
+  metrics_inc(frame ? METRIC_SNAPSHOT_CACHE_HITS : METRIC_SNAPSHOT_CACHE_MISSES);
+  // Cache miss: wait for the next published frame, retrying across transient
+  // capture failures (SNAPSHOT_RETRIES waits in total)
+  for (int attempt = 0; !frame && attempt < SNAPSHOT_RETRIES; attempt++) {
+    int sub = frame_pipeline_subscribe(FRAME_PROFILE_FULL);
+    frame = frame_pipeline_wait(sub, FRAME_WAIT_TIMEOUT_MS);
+    frame_pipeline_unsubscribe(sub);
+  }
+  if (!frame) {
     log_e("Camera capture failed");
     httpd_resp_send_500(req);
     return ESP_FAIL;
@@ -58,166 +88,344 @@ static esp_err_t capture_handler(httpd_req_t *req) {
   httpd_resp_set_type(req, "image/jpeg");
   httpd_resp_set_hdr(req, "Content-Disposition", "inline; filename=capture.jpg");
   httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+  // Pollers (DWC) must never be handed a cached, stale frame
+  httpd_resp_set_hdr(req, "Cache-Control", "no-store, no-cache, must-revalidate, max-age=0");
 
-  esp_err_t res;
-  if (fb->format == PIXFORMAT_JPEG) {
-    res = httpd_resp_send(req, (const char *)fb->buf, fb->len);
-  } else {
-    jpg_chunking_t jchunk = {req, 0};
-    res = frame2jpg_cb(fb, 80, jpg_encode_stream, &jchunk) ? ESP_OK : ESP_FAIL;
-    httpd_resp_send_chunk(req, NULL, 0);
-  }
+  esp_err_t res = httpd_resp_send(req, (const char *)frame->buf, frame->len);
 
-  esp_camera_fb_return(fb);
+  frame_pipeline_release(frame);
   return res;
 }
 
-// /stream: MJPEG stream (Duet Web Control webcam URL)
-// Optimized for stability and performance
-static esp_err_t stream_handler(httpd_req_t *req) {
-  camera_fb_t *fb = NULL;
-  struct timeval _timestamp;
-  esp_err_t res = ESP_OK;
-  size_t _jpg_buf_len = 0;
-  uint8_t *_jpg_buf = NULL;
-  char part_buf[128];
+// Deadline-based frame scheduler: frames are due at fixed multiples of the
+// target interval, so capture and send time no longer add to the period
+typedef struct {
+  int64_t next_us; // Deadline for the next frame (0 = not started)
+} frame_pacer_t;
 
-  static int64_t last_frame = 0;
-  static uint32_t frame_counter = 0;
-  static uint32_t error_count = 0;
+static void pacer_wait(frame_pacer_t *pacer) {
+  uint32_t interval_us = stream_interval_us;
+  if (interval_us == 0) {
+    pacer->next_us = 0;
+    return;
+  }
 
-  res = httpd_resp_set_type(req, _STREAM_CONTENT_TYPE);
-  if (res != ESP_OK) {
-    log_e("Failed to set stream content type");
-    return res;
+  int64_t now = esp_timer_get_time();
+  if (pacer->next_us == 0 || now - pacer->next_us > (int64_t)interval_us) {
+    // First frame, or fell a whole period behind: resync instead of bursting
+    pacer->next_us = now;
   }
+  pacer->next_us += interval_us;
 
-  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+  int64_t remaining_us = pacer->next_us - now;
+  if (remaining_us > 0) {
+    TickType_t ticks = pdMS_TO_TICKS(remaining_us / 1000);
+    if (ticks > 0) {
+      vTaskDelay(ticks);
+    }
+  }
+}
+
+// Send frames from the pipeline until the client goes away or capture keeps failing
+static esp_err_t stream_loop(stream_writer_t *writer, int sub) {
+  esp_err_t res = ESP_OK;
+  int64_t last_frame = 0;
+#if STREAM_FPS_LOG
+  uint32_t frame_counter = 0;
+#endif
+  float fps = 0;
+  frame_pacer_t pacer = {0};
+
+  int64_t link_down_since = 0;
 
   log_i("Stream client connected");
 
   while (true) {
-    fb = esp_camera_fb_get();
-    if (!fb) {
-      error_count++;
-      log_e("Camera capture failed (error count: %u)", error_count);
-      
+    frame_t *frame = frame_pipeline_wait(sub, FRAME_WAIT_TIMEOUT_MS);
+    if (!frame) {
       // If too many consecutive errors, break the stream
-      if (error_count > 10) {
+      if (frame_pipeline_error_count() > 10) {
         log_e("Too many capture errors, closing stream");
         res = ESP_FAIL;
         break;
       }
-      
-      // Small delay before retry
-      vTaskDelay(50 / portTICK_PERIOD_MS);
       continue;
     }
-    
-    // Reset error count on successful capture
-    error_count = 0;
-    
-    _timestamp.tv_sec = fb->timestamp.tv_sec;
-    _timestamp.tv_usec = fb->timestamp.tv_usec;
-    
-    if (fb->format != PIXFORMAT_JPEG) {
-      // Convert non-JPEG format to JPEG
-      bool jpeg_converted = frame2jpg(fb, 80, &_jpg_buf, &_jpg_buf_len);
-      esp_camera_fb_return(fb);
-      fb = NULL;
-      
-      if (!jpeg_converted || !_jpg_buf || _jpg_buf_len == 0) {
-        log_e("JPEG compression failed");
-        if (_jpg_buf) {
-          free(_jpg_buf);
-          _jpg_buf = NULL;
-        }
+
+    // While Wi-Fi is reconnecting, skip frames instead of filling the socket
+    // buffer (and hitting the send timeout); the TCP session usually survives a
+    // short drop, so the first frame after reassociation is the newest one
+    if (!wifi_link_up()) {
+      frame_pipeline_release(frame);
+      int64_t now = esp_timer_get_time();
+      if (link_down_since == 0) {
+        link_down_since = now;
+      } else if (now - link_down_since > (int64_t)STREAM_LINK_HOLD_MS * 1000) {
+        log_w("Link down for %u ms, closing stream", STREAM_LINK_HOLD_MS);
         res = ESP_FAIL;
         break;
       }
-    } else {
-      _jpg_buf_len = fb->len;
-      _jpg_buf = fb->buf;
+      continue;
     }
+    link_down_since = 0;
 
-    // Send boundary
-    if (res == ESP_OK) {
-      res = httpd_resp_send_chunk(req, _STREAM_BOUNDARY, strlen(_STREAM_BOUNDARY));
-    }
-    
-    // Send header
-    if (res == ESP_OK) {
-      size_t hlen = snprintf(part_buf, sizeof(part_buf), _STREAM_PART, 
-                             _jpg_buf_len, _timestamp.tv_sec, _timestamp.tv_usec);
-      if (hlen < sizeof(part_buf)) {
-        res = httpd_resp_send_chunk(req, part_buf, hlen);
-      } else {
-        log_e("Header buffer overflow");
-        res = ESP_FAIL;
-      }
-    }
-    
-    // Send image data
-    if (res == ESP_OK && _jpg_buf && _jpg_buf_len > 0) {
-      res = httpd_resp_send_chunk(req, (const char *)_jpg_buf, _jpg_buf_len);
-    }
+    // Part header, JPEG and closing boundary in a single zero-copy write
+    int64_t send_start = esp_timer_get_time();
+    res = stream_writer_send_part(writer, frame);
+    uint32_t send_us = (uint32_t)(esp_timer_get_time() - send_start);
+    metrics_observe(METRIC_HIST_SEND_US, send_us);
+    size_t sent_len = frame->len;
 
-    // Free frame buffer
-    if (fb) {
-      esp_camera_fb_return(fb);
-      fb = NULL;
-      _jpg_buf = NULL; // Don't free, it's part of fb
-    } else if (_jpg_buf) {
-      free(_jpg_buf);
-      _jpg_buf = NULL;
-    }
+    // Drop our reference; the slot is reused once every client is done
+    frame_pipeline_release(frame);
 
     if (res != ESP_OK) {
       log_e("Stream send error: %d", res);
       break;
     }
+    metrics_inc(METRIC_FRAMES_SENT);
+#if RATE_CONTROL
+    rate_control_observe(sent_len, send_us, __atomic_load_n(&stream_clients, __ATOMIC_RELAXED));
+#else
+    (void)sent_len;
+#endif
 
-    // Frame rate logging (every 30 frames)
+    // Achieved rate and debug logging (every 30 frames; /metrics has the details)
     int64_t now = esp_timer_get_time();
-    if (last_frame > 0) {
-      int64_t frame_time = (now - last_frame) / 1000;
-      if (++frame_counter % 30 == 0 && frame_time > 0) {
-        log_i("Stream: %ums/frame (%.1ffps)", (uint32_t)frame_time, 1000.0 / frame_time);
+    if (last_frame > 0 && now > last_frame) {
+      float instant = 1000000.0f / (now - last_frame);
+      fps = (fps == 0) ? instant : fps * 0.9f + instant * 0.1f;
+      stream_achieved_fps = fps;
+      stream_last_frame_us = now;
+#if STREAM_FPS_LOG
+      if (++frame_counter % 30 == 0) {
+        log_d("Stream: %.1ffps (target %.1f), %u stale frames skipped", fps,
+              stream_interval_us ? 1000000.0f / stream_interval_us : 0.0f, frame_pipeline_dropped(sub));
       }
+#endif
     }
     last_frame = now;
 
-    // Optional frame rate limiting
-    if (stream_delay_ms > 0) {
-      vTaskDelay(stream_delay_ms / portTICK_PERIOD_MS);
-    }
+    // Sleep until the next frame deadline (no-op when unpaced)
+    pacer_wait(&pacer);
   }
 
   log_i("Stream client disconnected");
-  
-  // Cleanup
-  if (fb) {
-    esp_camera_fb_return(fb);
+  return res;
+}
+
+#if STREAM_RAW_SOCKET || WS_STREAM
+// Stream sockets send large writes back to back: no Nagle delay, bigger send buffer
+static void tune_stream_socket(int fd) {
+  int nodelay = 1;
+  if (setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay)) != 0) {
+    log_w("TCP_NODELAY not applied (errno %d)", errno);
+  }
+  int sndbuf = STREAM_SOCKET_SNDBUF;
+  if (setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf)) != 0) {
+    log_d("SO_SNDBUF not supported by this lwIP build");
+  }
+}
+#endif
+
+#if STREAM_RAW_SOCKET
+// Raw-socket stream session: owns the socket after the httpd worker has let go
+typedef struct {
+  httpd_req_t *req; // Async copy of the request, completed when the session ends
+  int sub;
+  bool chunked;     // HTTP chunked framing (?mode=chunked) instead of raw multipart
+} stream_session_t;
+
+static const char *_RAW_STREAM_HEADERS =
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: " STREAM_CONTENT_TYPE "\r\n"
+  "Access-Control-Allow-Origin: *\r\n"
+  "Cache-Control: no-store, no-cache, must-revalidate\r\n"
+  "Connection: close\r\n"
+  "\r\n";
+
+// Sender task: writes the multipart stream straight to the socket
+static void stream_sender_task(void *arg) {
+  stream_session_t *session = (stream_session_t *)arg;
+  httpd_handle_t hd = session->req->handle;
+  int fd = httpd_req_to_sockfd(session->req);
+
+  tune_stream_socket(fd);
+
+  stream_writer_t writer;
+  stream_writer_init(&writer, fd, session->chunked);
+  bool started;
+  if (session->chunked) {
+    // httpd writes the headers with the first chunk; later parts bypass it
+    size_t preamble_len = 0;
+    const char *preamble = stream_writer_preamble(&preamble_len);
+    httpd_resp_set_type(session->req, STREAM_CONTENT_TYPE);
+    httpd_resp_set_hdr(session->req, "Access-Control-Allow-Origin", "*");
+    started = httpd_resp_send_chunk(session->req, preamble, preamble_len) == ESP_OK;
+  } else {
+    started = stream_writer_send_head(&writer, _RAW_STREAM_HEADERS) == ESP_OK;
+  }
+  if (started) {
+    stream_loop(&writer, session->sub);
+  }
+
+  frame_pipeline_unsubscribe(session->sub);
+  __atomic_fetch_sub(&stream_clients, 1, __ATOMIC_RELAXED);
+  httpd_req_async_handler_complete(session->req);
+  httpd_sess_trigger_close(hd, fd);
+  free(session);
+  vTaskDelete(NULL);
+}
+
+// Hand the connection to a dedicated sender task so the httpd worker is free at once
+static bool start_stream_session(httpd_req_t *req, int sub, bool chunked) {
+  stream_session_t *session = (stream_session_t *)malloc(sizeof(stream_session_t));
+  if (!session) {
+    return false;
+  }
+  session->sub = sub;
+  session->chunked = chunked;
+
+  if (httpd_req_async_handler_begin(req, &session->req) != ESP_OK) {
+    free(session);
+    return false;
   }
-  if (_jpg_buf && !fb) {
-    free(_jpg_buf);
+
+  if (xTaskCreatePinnedToCore(stream_sender_task, "stream_tx", STREAM_SENDER_STACK, session,
+                              STREAM_SENDER_PRIORITY, NULL, HTTPD_TASK_CORE) != pdPASS) {
+    log_e("Failed to create stream sender task");
+    httpd_req_async_handler_complete(session->req);
+    free(session);
+    return false;
   }
+  return true;
+}
+#endif
+
+// /stream: MJPEG stream (Duet Web Control webcam URL)
+// Frames come from the shared capture pipeline, so N viewers cost one capture per frame.
+// A slow client skips stale frames instead of throttling capture for everyone else.
+// Every session runs on its own sender task, so the single httpd worker stays
+// free for /status and /control however many viewers are attached. By default
+// the socket is written without HTTP chunked encoding; /stream?mode=chunked
+// keeps the chunked framing. /stream?profile=preview serves the low-resolution
+// preview instead. Beyond STREAM_MAX_CLIENTS viewers new streams get a 503.
+static esp_err_t stream_handler(httpd_req_t *req) {
+#if IDLE_POWER_SAVE
+  power_idle_touch();
+#endif
+  char query[64];
+  char mode[16] = "";
+  char profile[16] = "";
+  if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+    httpd_query_key_value(query, "mode", mode, sizeof(mode));
+    httpd_query_key_value(query, "profile", profile, sizeof(profile));
+  }
+
+  // Sockets beyond the stream limit stay reserved for control requests
+  if (__atomic_add_fetch(&stream_clients, 1, __ATOMIC_RELAXED) > STREAM_MAX_CLIENTS) {
+    __atomic_fetch_sub(&stream_clients, 1, __ATOMIC_RELAXED);
+    log_w("Stream limit (%u) reached", STREAM_MAX_CLIENTS);
+    httpd_resp_set_status(req, "503 Service Unavailable");
+    httpd_resp_set_hdr(req, "Retry-After", "5");
+    return httpd_resp_sendstr(req, "Too many streams");
+  }
+
+  int sub = frame_pipeline_subscribe(strcmp(profile, "preview") == 0 ? FRAME_PROFILE_PREVIEW
+                                                                    : FRAME_PROFILE_FULL);
+  if (sub < 0) {
+    __atomic_fetch_sub(&stream_clients, 1, __ATOMIC_RELAXED);
+    httpd_resp_send_500(req);
+    return ESP_FAIL;
+  }
+
+#if STREAM_RAW_SOCKET
+  if (start_stream_session(req, sub, strcmp(mode, "chunked") == 0)) {
+    return ESP_OK;
+  }
+  log_w("Stream task unavailable, serving from the httpd worker");
+#endif
 
+  esp_err_t res = httpd_resp_set_type(req, STREAM_CONTENT_TYPE);
+  if (res != ESP_OK) {
+    log_e("Failed to set stream content type");
+    frame_pipeline_unsubscribe(sub);
+    __atomic_fetch_sub(&stream_clients, 1, __ATOMIC_RELAXED);
+    return res;
+  }
+
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+
+  // The first chunk flushes the response headers; every part after that is
+  // written as one chunk straight to the socket
+  size_t preamble_len = 0;
+  const char *preamble = stream_writer_preamble(&preamble_len);
+  res = httpd_resp_send_chunk(req, preamble, preamble_len);
+  if (res == ESP_OK) {
+    stream_writer_t writer;
+    stream_writer_init(&writer, httpd_req_to_sockfd(req), true);
+    res = stream_loop(&writer, sub);
+  }
+
+  frame_pipeline_unsubscribe(sub);
+  __atomic_fetch_sub(&stream_clients, 1, __ATOMIC_RELAXED);
   return res;
 }
 
 // /: Serve HTML UI
+// Assets are pre-gzipped and tagged with a content hash by tools/build_assets.py.
+// "no-cache" makes browsers revalidate every load; a matching If-None-Match
+// gets an empty 304, so repeat visits cost a few hundred bytes.
 static esp_err_t index_handler(httpd_req_t *req) {
-  httpd_resp_set_type(req, "text/html");
-  httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+  const web_asset_t *asset = nullptr;
+  size_t uri_len = strcspn(req->uri, "?");
+  for (size_t i = 0; i < WEB_ASSET_COUNT; i++) {
+    if (strlen(web_assets[i].uri) == uri_len && strncmp(web_assets[i].uri, req->uri, uri_len) == 0) {
+      asset = &web_assets[i];
+      break;
+    }
+  }
+  if (!asset) {
+    return httpd_resp_send_404(req);
+  }
+
+  httpd_resp_set_hdr(req, "ETag", asset->etag);
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
   httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
-  return httpd_resp_send(req, (const char *)index_ov3660_html_gz, index_ov3660_html_gz_len);
+
+  // If-None-Match may list several tags (or carry a W/ prefix); any match will do
+  char if_none_match[96];
+  if (httpd_req_get_hdr_value_str(req, "If-None-Match", if_none_match, sizeof(if_none_match)) == ESP_OK &&
+      (strstr(if_none_match, asset->etag) != nullptr || strcmp(if_none_match, "*") == 0)) {
+    httpd_resp_set_status(req, "304 Not Modified");
+    return httpd_resp_send(req, nullptr, 0);
+  }
+
+  httpd_resp_set_type(req, asset->type);
+  httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+  httpd_resp_set_hdr(req, "Vary", "Accept-Encoding");
+  return httpd_resp_send(req, (const char *)asset->data, asset->len);
 }
 
-// Helper: Parse framesize value
+static bool is_number(const char *value) {
+  if (*value == '-') {
+    value++;
+  }
+  if (!*value) {
+    return false;
+  }
+  for (; *value; value++) {
+    if (*value < '0' || *value > '9') {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Helper: Parse framesize value; FRAMESIZE_INVALID for anything unrecognised
 static framesize_t framesize_from_value(const char *value) {
   if (!value) {
-    return FRAMESIZE_SVGA;
+    return FRAMESIZE_INVALID;
   }
 
   if (strcasecmp(value, "svga") == 0) {
@@ -228,10 +436,10 @@ static framesize_t framesize_from_value(const char *value) {
   }
 
   int idx = atoi(value);
-  if (idx >= 0 && idx < FRAMESIZE_INVALID) {
+  if (is_number(value) && idx >= 0 && idx < FRAMESIZE_INVALID) {
     return (framesize_t)idx;
   }
-  return FRAMESIZE_SVGA;
+  return FRAMESIZE_INVALID;
 }
 
 // Helper: Get framesize name
@@ -246,32 +454,345 @@ static const char *framesize_name(framesize_t size) {
   }
 }
 
-// /control: Camera controls (framesize, quality, stream_delay, vflip, hmirror)
-static esp_err_t cmd_handler(httpd_req_t *req) {
-  char variable[32];
-  char value[32];
+// Frames discarded after a framesize change while the sensor settles
+static const uint8_t RECONFIG_DISCARD_FRAMES = 2;
+
+// Parsed /control request: every setting is validated before any is applied.
+// Fields left at -1 were not requested.
+typedef struct {
+  int framesize;
+  int quality;
+  int vflip;
+  int hmirror;
+  int interval_ms;       // From target_fps or stream_delay
+  int snapshot_max_age;
+  int adaptive;
+#if MOTION_DETECTION
+  int motion;
+#endif
+#if RATE_CONTROL
+  int rate_kbps;         // 0 turns the controller off
+  int rate_fps;
+#endif
+  int roi_zoom;          // Percent, 100 = full frame
+  int roi_x;             // Window centre, per mille
+  int roi_y;
+} control_batch_t;
+
+// Clamp helper matching the single-setting behaviour of earlier releases
+static int clamp_val(int val, int lo, int hi) {
+  return val < lo ? lo : (val > hi ? hi : val);
+}
+
+// /control settings, one row per name. The table is constexpr and sorted (checked
+// at compile time), so a request costs a binary search instead of a strcmp chain,
+// and ranges come from the sensor descriptor of this build.
+typedef enum {
+  CONTROL_CLAMP,     // Integer clamped to [min, max]
+  CONTROL_BOOL,      // Any integer, stored as 0/1
+  CONTROL_FPS,       // Frames per second, stored as an interval in ms
+  CONTROL_FRAMESIZE, // Index or name (svga, fhd, 1080p), limited to the sensor/PSRAM maximum
+} control_kind_t;
+
+typedef struct {
+  const char *name;
+  control_kind_t kind;
+  uint8_t offset;    // int field in control_batch_t
+  int16_t min;
+  int16_t max;
+} control_def_t;
+
+static constexpr control_def_t CONTROL_DEFS[] = {
+  {"adaptive", CONTROL_BOOL, offsetof(control_batch_t, adaptive), 0, 1},
+  {"framesize", CONTROL_FRAMESIZE, offsetof(control_batch_t, framesize), 0, CAMERA_SENSOR_DESC.max_framesize},
+  {"hmirror", CONTROL_CLAMP, offsetof(control_batch_t, hmirror), 0, 1},
+#if MOTION_DETECTION
+  {"motion", CONTROL_BOOL, offsetof(control_batch_t, motion), 0, 1},
+#endif
+  {"quality", CONTROL_CLAMP, offsetof(control_batch_t, quality), CAMERA_SENSOR_DESC.min_quality, 63},
+#if RATE_CONTROL
+  {"rate_fps", CONTROL_CLAMP, offsetof(control_batch_t, rate_fps), 0, 60},
+  {"rate_kbps", CONTROL_CLAMP, offsetof(control_batch_t, rate_kbps), 0, 20000},
+#endif
+  {"roi_x", CONTROL_CLAMP, offsetof(control_batch_t, roi_x), 0, 1000},
+  {"roi_y", CONTROL_CLAMP, offsetof(control_batch_t, roi_y), 0, 1000},
+  // Sensors without windowing clamp every zoom to full frame
+  {"roi_zoom", CONTROL_CLAMP, offsetof(control_batch_t, roi_zoom), ROI_ZOOM_MIN,
+   CAMERA_ROI_SUPPORTED ? ROI_ZOOM_MAX : ROI_ZOOM_MIN},
+  {"snapshot_max_age", CONTROL_CLAMP, offsetof(control_batch_t, snapshot_max_age), 0, 5000},
+  {"stream_delay", CONTROL_CLAMP, offsetof(control_batch_t, interval_ms), 0, 500}, // Legacy: interval in ms
+  {"target_fps", CONTROL_FPS, offsetof(control_batch_t, interval_ms), 0, 60},
+  {"vflip", CONTROL_CLAMP, offsetof(control_batch_t, vflip), 0, 1},
+};
+static constexpr size_t CONTROL_DEF_COUNT = sizeof(CONTROL_DEFS) / sizeof(CONTROL_DEFS[0]);
+
+static constexpr int str_order(const char *a, const char *b) {
+  return (*a != *b || !*a) ? (unsigned char)*a - (unsigned char)*b : str_order(a + 1, b + 1);
+}
+
+static constexpr bool controls_sorted(size_t i) {
+  return i + 1 >= CONTROL_DEF_COUNT ||
+         (str_order(CONTROL_DEFS[i].name, CONTROL_DEFS[i + 1].name) < 0 && controls_sorted(i + 1));
+}
+static_assert(controls_sorted(0), "CONTROL_DEFS must be sorted by name");
+
+static const control_def_t *find_control(const char *name) {
+  size_t lo = 0;
+  size_t hi = CONTROL_DEF_COUNT;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    int order = strcmp(name, CONTROL_DEFS[mid].name);
+    if (order == 0) {
+      return &CONTROL_DEFS[mid];
+    }
+    if (order < 0) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return nullptr;
+}
+
+// Validate one setting into the batch; false for unknown names or bad values
+static bool parse_control(const char *variable, const char *value, control_batch_t *b) {
+  const control_def_t *def = find_control(variable);
+  if (!def) {
+    return false;
+  }
+  int *field = (int *)((char *)b + def->offset);
+
+  if (def->kind == CONTROL_FRAMESIZE) {
+    framesize_t target = framesize_from_value(value);
+    if (target == FRAMESIZE_INVALID) {
+      return false;
+    }
+    framesize_t max_size = camera_max_framesize(psramFound());
+    if (target > max_size) {
+      log_w("%s limited to framesize %d", psramFound() ? CAMERA_SENSOR_DESC.name : "No PSRAM",
+            max_size);
+      target = max_size;
+    }
+    *field = target;
+    return true;
+  }
+
+  if (!is_number(value)) {
+    return false;
+  }
+  int val = atoi(value);
+  switch (def->kind) {
+    case CONTROL_BOOL:
+      *field = val != 0;
+      break;
+    case CONTROL_FPS:
+      val = clamp_val(val, def->min, def->max);
+      *field = val ? 1000 / val : 0;
+      break;
+    default:
+      *field = clamp_val(val, def->min, def->max);
+      break;
+  }
+  return true;
+}
+
+// Split the query into name=value pairs; var/val is the legacy single form
+static bool parse_control_query(char *query, control_batch_t *b, int *count) {
+  char *var = nullptr;
+  char *val = nullptr;
+  char *save = nullptr;
+  *count = 0;
+  for (char *pair = strtok_r(query, "&", &save); pair; pair = strtok_r(nullptr, "&", &save)) {
+    char *eq = strchr(pair, '=');
+    if (!eq) {
+      return false;
+    }
+    *eq = '\0';
+    if (!strcmp(pair, "var")) {
+      var = eq + 1;
+    } else if (!strcmp(pair, "val")) {
+      val = eq + 1;
+    } else if (!parse_control(pair, eq + 1, b)) {
+      log_w("Invalid control %s=%s", pair, eq + 1);
+      return false;
+    } else {
+      (*count)++;
+    }
+  }
+  if (var || val) {
+    if (!var || !val || !parse_control(var, val, b)) {
+      log_w("Invalid control %s=%s", var ? var : "?", val ? val : "?");
+      return false;
+    }
+    (*count)++;
+  }
+  return *count > 0;
+}
+
+// Apply a validated batch: one parked-pipeline reconfiguration for framesize,
+// every other register write in the same pass, and a single flush afterwards
+static esp_err_t apply_control(sensor_t *s, const control_batch_t *b, bool *reconfigured) {
+  bool resize = b->framesize >= 0 && b->framesize != s->status.framesize;
+  camera_roi_t stored;
+  roi_get(&stored);
+  camera_roi_t roi = stored;
+  if (b->roi_zoom >= 0) {
+    roi.zoom = b->roi_zoom;
+  }
+  if (b->roi_x >= 0) {
+    roi.x = b->roi_x;
+  }
+  if (b->roi_y >= 0) {
+    roi.y = b->roi_y;
+  }
+  // The UI sends the region with every Apply: only a different window needs the
+  // sensor reprogrammed, and at full frame a new centre is just stored
+  bool recentre = roi.x != stored.x || roi.y != stored.y;
+  bool reroi = roi.zoom != stored.zoom || (recentre && roi.zoom > ROI_ZOOM_MIN);
+  bool rewindow = resize || reroi;
+  *reconfigured = rewindow;
+
+  // Park capture so no frame is grabbed half way through the window change;
+  // reconfiguring under a running capture is what parking is there to avoid
+  if (rewindow && !frame_pipeline_suspend(1000)) {
+    log_e("Capture did not park, control not applied");
+    *reconfigured = false;
+    return ESP_FAIL;
+  }
+  // The rate controller's quality steps wait for the register writes below; a
+  // running benchmark holds the sensor for minutes, so give up rather than wait
+  if (!frame_pipeline_sensor_lock(1000)) {
+    log_e("Sensor busy, control not applied");
+    if (rewindow) {
+      frame_pipeline_resume();
+    }
+    *reconfigured = false;
+    return ESP_FAIL;
+  }
+  int failed = 0;
+
+  if (resize) {
+    failed |= s->set_framesize(s, (framesize_t)b->framesize);
+    log_i("Set framesize to %s", framesize_name((framesize_t)b->framesize));
+  }
+  // A framesize change resets the sensor window, so the region goes on after it
+  if (reroi) {
+    failed |= roi_set(s, &roi);
+  } else {
+    if (resize) {
+      failed |= roi_reapply(s);
+    }
+    if (recentre) {
+      failed |= roi_set(s, &roi);  // Full frame: no sensor write
+    }
+  }
+  if (b->quality >= 0) {
+    failed |= s->set_quality(s, b->quality);
+    // The user's quality, not the controller's step: what rate control goes
+    // back to when it is turned off
+    camera_settings.quality = b->quality;
+    log_i("Set quality to %d", b->quality);
+  }
+  if (b->vflip >= 0) {
+    failed |= s->set_vflip(s, b->vflip);
+    log_i("Set vflip to %d", b->vflip);
+  }
+  if (b->hmirror >= 0) {
+    failed |= s->set_hmirror(s, b->hmirror);
+    log_i("Set hmirror to %d", b->hmirror);
+  }
+  frame_pipeline_sensor_unlock();
 
-  if (httpd_req_get_url_query_len(req) == 0) {
+  if (rewindow) {
+    frame_pipeline_flush(RECONFIG_DISCARD_FRAMES);
+    frame_pipeline_resume();
+  }
+
+  if (b->interval_ms >= 0) {
+#if STREAM_PACING == STREAM_PACING_TUNABLE
+    stream_interval_us = (uint32_t)b->interval_ms * 1000;
+    log_i("Set stream interval to %dms", b->interval_ms);
+#else
+    // Accepted so batched UI requests still apply, but the interval is built in
+    log_i("Fixed stream pacing (%ums), interval ignored", STREAM_FIXED_INTERVAL_MS);
+#endif
+  }
+  if (b->snapshot_max_age >= 0) {
+    snapshot_max_age_ms = (uint16_t)b->snapshot_max_age;
+    log_i("Set snapshot_max_age to %ums", snapshot_max_age_ms);
+  }
+  if (b->adaptive >= 0) {
+    frame_pipeline_set_adaptive(b->adaptive);
+    log_i("Set adaptive frame rate %s", b->adaptive ? "on" : "off");
+  }
+#if MOTION_DETECTION
+  if (b->motion >= 0) {
+    motion_set_enabled(b->motion);
+    log_i("Set motion detection %s", b->motion ? "on" : "off");
+  }
+#endif
+#if RATE_CONTROL
+  // A new user quality is the controller's starting point from the next window
+  if (b->quality >= 0) {
+    rate_control_restart();
+  }
+  // A bitrate target wins if both are given in one request
+  if (b->rate_kbps >= 0) {
+    rate_control_set(RATE_MODE_BITRATE, (uint16_t)b->rate_kbps);
+  } else if (b->rate_fps >= 0) {
+    rate_control_set(RATE_MODE_FPS, (uint16_t)b->rate_fps);
+  }
+#endif
+  if (failed) {
+    return ESP_FAIL;
+  }
+
+  // Persist the result so the next boot starts with it
+  camera_settings.framesize = s->status.framesize;
+  // camera_settings.quality was set above: the sensor may hold a controller step
+  camera_settings.vflip = s->status.vflip;
+  camera_settings.hmirror = s->status.hmirror;
+  camera_settings.interval_ms = stream_interval_us / 1000;
+  camera_settings.snapshot_max_age = snapshot_max_age_ms;
+  roi_get(&roi);
+  camera_settings.roi_zoom = roi.zoom;
+  camera_settings.roi_x = roi.x;
+  camera_settings.roi_y = roi.y;
+  camera_settings.adaptive = frame_pipeline_adaptive();
+#if MOTION_DETECTION
+  camera_settings.motion = motion_is_enabled();
+#endif
+  settings_save();
+  return ESP_OK;
+}
+
+// /control: Camera controls (framesize, quality, target_fps, stream_delay,
+// snapshot_max_age, adaptive, motion, vflip, hmirror). Either the legacy
+// ?var=name&val=value form or several settings at once, e.g.
+// /control?framesize=svga&quality=12&vflip=1. The whole request is rejected
+// with 400 if any setting is unknown or malformed, before anything is applied.
+static esp_err_t cmd_handler(httpd_req_t *req) {
+  size_t query_len = httpd_req_get_url_query_len(req);
+  if (query_len == 0) {
     httpd_resp_send_404(req);
     return ESP_FAIL;
   }
 
-  char *buf = (char *)malloc(httpd_req_get_url_query_len(req) + 1);
+  char *buf = (char *)malloc(query_len + 1);
   if (!buf) {
     httpd_resp_send_500(req);
     return ESP_FAIL;
   }
 
-  esp_err_t res = ESP_OK;
-  if (httpd_req_get_url_query_str(req, buf, httpd_req_get_url_query_len(req) + 1) != ESP_OK ||
-      httpd_query_key_value(buf, "var", variable, sizeof(variable)) != ESP_OK ||
-      httpd_query_key_value(buf, "val", value, sizeof(value)) != ESP_OK) {
-    res = ESP_FAIL;
-  }
+  control_batch_t batch;
+  memset(&batch, 0xff, sizeof(batch)); // Every field -1: not requested
+  int count = 0;
+  bool valid = httpd_req_get_url_query_str(req, buf, query_len + 1) == ESP_OK &&
+               parse_control_query(buf, &batch, &count);
   free(buf);
 
-  if (res != ESP_OK) {
-    httpd_resp_send_404(req);
+  if (!valid) {
+    httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid control request");
     return ESP_FAIL;
   }
 
@@ -281,53 +802,18 @@ static esp_err_t cmd_handler(httpd_req_t *req) {
     return ESP_FAIL;
   }
 
-  int val = atoi(value);
-  
-  if (!strcmp(variable, "framesize")) {
-    framesize_t target = framesize_from_value(value);
-    if (!psramFound() && target > FRAMESIZE_SVGA) {
-      log_w("PSRAM not available, limiting to SVGA");
-      target = FRAMESIZE_SVGA;
-    }
-    res = s->set_framesize(s, target);
-    log_i("Set framesize to %s", framesize_name(target));
-    
-  } else if (!strcmp(variable, "quality")) {
-    if (val < 5) val = 5;
-    if (val > 63) val = 63;
-    res = s->set_quality(s, val);
-    log_i("Set quality to %d", val);
-    
-  } else if (!strcmp(variable, "stream_delay")) {
-    if (val < 0) val = 0;
-    if (val > 500) val = 500;
-    stream_delay_ms = (uint16_t)val;
-    log_i("Set stream_delay to %ums", stream_delay_ms);
-    
-  } else if (!strcmp(variable, "vflip")) {
-    if (val < 0) val = 0;
-    if (val > 1) val = 1;
-    res = s->set_vflip(s, val);
-    log_i("Set vflip to %d", val);
-    
-  } else if (!strcmp(variable, "hmirror")) {
-    if (val < 0) val = 0;
-    if (val > 1) val = 1;
-    res = s->set_hmirror(s, val);
-    log_i("Set hmirror to %d", val);
-    
-  } else {
-    log_w("Unknown control variable: %s", variable);
-    res = ESP_FAIL;
-  }
-
-  if (res != ESP_OK) {
+  bool reconfigured = false;
+  if (apply_control(s, &batch, &reconfigured) != ESP_OK) {
     httpd_resp_send_500(req);
     return ESP_FAIL;
   }
 
+  char json[64];
+  int len = snprintf(json, sizeof(json), "{\"applied\":%d,\"reconfigured\":%s}", count,
+                     reconfigured ? "true" : "false");
+  httpd_resp_set_type(req, "application/json");
   httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
-  return httpd_resp_send(req, NULL, 0);
+  return httpd_resp_send(req, json, len);
 }
 
 // /status: JSON status with resolution, quality, fps, orientation
@@ -337,19 +823,96 @@ static esp_err_t status_handler(httpd_req_t *req) {
     return httpd_resp_send_500(req);
   }
 
-  char json_response[256];
+  // Achieved rate goes to 0 once no stream has sent a frame for a while
+  bool streaming = (esp_timer_get_time() - stream_last_frame_us) < 2000000;
+
+  char json_response[1536];
   int len = snprintf(json_response, sizeof(json_response),
                      "{\"framesize\":%u,\"framesize_name\":\"%s\",\"quality\":%u,"
-                     "\"stream_delay\":%u,\"vflip\":%u,\"hmirror\":%u,"
-                     "\"wifi_rssi\":%d}",
+                     "\"stream_delay\":%u,\"target_fps\":%.1f,\"achieved_fps\":%.1f,"
+                     "\"snapshot_max_age\":%u,\"vflip\":%u,\"hmirror\":%u,"
+                     "\"adaptive\":%u,\"scene_static\":%u,\"wifi_rssi\":%d",
                      s->status.framesize, 
                      framesize_name((framesize_t)s->status.framesize),
                      s->status.quality, 
-                     stream_delay_ms,
+                     (unsigned)(stream_interval_us / 1000),
+                     stream_interval_us ? 1000000.0f / stream_interval_us : 0.0f,
+                     streaming ? stream_achieved_fps : 0.0f,
+                     snapshot_max_age_ms,
                      s->status.vflip,
                      s->status.hmirror,
+                     frame_pipeline_adaptive(),
+                     frame_pipeline_quiet(),
                      WiFi.RSSI());
 
+#if MOTION_DETECTION
+  motion_status_t motion;
+  motion_get_status(&motion);
+  len += snprintf(json_response + len, sizeof(json_response) - len,
+                  ",\"motion_enabled\":%u,\"motion\":%u,\"motion_score\":%u,"
+                  "\"motion_box\":[%u,%u,%u,%u],\"motion_events\":%u",
+                  motion.enabled, motion.active, motion.score, motion.box.x, motion.box.y,
+                  motion.box.w, motion.box.h, (unsigned)motion.events);
+#endif
+#if CLIP_RECORDER
+  clip_status_t clip;
+  clip_get_status(&clip);
+  len += snprintf(json_response + len, sizeof(json_response) - len,
+                  ",\"clip_frames\":%u,\"clip_seconds\":%.1f,\"clip_kb\":%u",
+                  (unsigned)clip.frames, clip.span_ms / 1000.0f, (unsigned)(clip.bytes / 1024));
+#endif
+#if TIMELAPSE
+  timelapse_status_t timelapse;
+  timelapse_get_status(&timelapse);
+  len += snprintf(json_response + len, sizeof(json_response) - len,
+                  ",\"timelapse\":%u,\"timelapse_frames\":%u",
+                  timelapse.active, (unsigned)timelapse.written);
+#endif
+  wifi_link_status_t link;
+  wifi_link_get_status(&link);
+  len += snprintf(json_response + len, sizeof(json_response) - len,
+                  ",\"wifi_state\":\"%s\",\"wifi_drops\":%u,\"wifi_attempts\":%u,"
+                  "\"wifi_last_reason\":%u,\"boot_camera_ms\":%u,\"boot_ip_ms\":%u,"
+                  "\"boot_server_ms\":%u,\"boot_fast_connect\":%s",
+                  wifi_link_state_name(link.state), (unsigned)link.drops, (unsigned)link.attempts,
+                  link.last_reason, (unsigned)boot_camera_ms, (unsigned)link.first_ip_ms,
+                  (unsigned)boot_server_ms, link.fast_connect ? "true" : "false");
+#if RATE_CONTROL
+  rate_status_t rate;
+  rate_control_get_status(&rate);
+  len += snprintf(json_response + len, sizeof(json_response) - len,
+                  ",\"rate_mode\":\"%s\",\"rate_target\":%u,\"rate_kbps\":%u,"
+                  "\"rate_send_us\":%u,\"rate_quality\":%u,\"rate_decision\":\"%s\","
+                  "\"rate_changes\":%u",
+                  rate_mode_name(rate.mode), rate.target, (unsigned)rate.kbps,
+                  (unsigned)rate.send_us, rate.quality, rate_decision_name(rate.decision),
+                  (unsigned)rate.changes);
+#endif
+  camera_roi_t roi;
+  roi_window_t roi_window;
+  roi_get(&roi);
+  roi_get_window(&roi_window);
+  len += snprintf(json_response + len, sizeof(json_response) - len,
+                  ",\"roi_zoom\":%u,\"roi_x\":%u,\"roi_y\":%u,\"roi_window\":[%u,%u,%u,%u]",
+                  roi_window.zoom, roi.x, roi.y, roi_window.x, roi_window.y, roi_window.w,
+                  roi_window.h);
+#if RTSP_SERVER
+  rtsp_status_t rtsp;
+  rtsp_get_status(&rtsp);
+  len += snprintf(json_response + len, sizeof(json_response) - len,
+                  ",\"rtsp_sessions\":%u,\"rtsp_frames\":%u,\"rtsp_skipped\":%u",
+                  rtsp.sessions, (unsigned)rtsp.frames, (unsigned)rtsp.skipped);
+#endif
+#if IDLE_POWER_SAVE
+  power_status_t power;
+  power_get_status(&power);
+  len += snprintf(json_response + len, sizeof(json_response) - len,
+                  ",\"power_state\":\"%s\",\"power_idle_entries\":%u,\"power_wake_ms\":%u",
+                  power_state_name(power.state), (unsigned)power.idle_entries,
+                  (unsigned)power.last_wake_ms);
+#endif
+  len += snprintf(json_response + len, sizeof(json_response) - len, "}");
+
   httpd_resp_set_type(req, "application/json");
   httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
   return httpd_resp_send(req, json_response, len);
@@ -376,6 +939,553 @@ static esp_err_t health_handler(httpd_req_t *req) {
   return httpd_resp_send(req, response, len);
 }
 
+// /metrics: Prometheus text exposition of the hot-path counters and histograms
+static void metrics_emit_chunk(void *ctx, const char *text, size_t len) {
+  httpd_resp_send_chunk((httpd_req_t *)ctx, text, len);
+}
+
+static esp_err_t metrics_handler(httpd_req_t *req) {
+  httpd_resp_set_type(req, "text/plain; version=0.0.4");
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+
+  metrics_render(metrics_emit_chunk, req);
+
+  bool streaming = (esp_timer_get_time() - stream_last_frame_us) < 2000000;
+  char line[256];
+  int len = snprintf(line, sizeof(line),
+                     "# TYPE cam_stream_clients gauge\ncam_stream_clients %u\n"
+                     "# TYPE cam_stream_target_fps gauge\ncam_stream_target_fps %.1f\n"
+                     "# TYPE cam_stream_achieved_fps gauge\ncam_stream_achieved_fps %.1f\n"
+                     "# TYPE cam_capture_quiet gauge\ncam_capture_quiet %u\n",
+                     (unsigned)__atomic_load_n(&stream_clients, __ATOMIC_RELAXED),
+                     stream_interval_us ? 1000000.0f / stream_interval_us : 0.0f,
+                     streaming ? stream_achieved_fps : 0.0f, frame_pipeline_quiet());
+  httpd_resp_send_chunk(req, line, len);
+
+#if MOTION_DETECTION
+  motion_status_t motion;
+  motion_get_status(&motion);
+  len = snprintf(line, sizeof(line),
+                 "# TYPE cam_motion_score gauge\ncam_motion_score %u\n"
+                 "# TYPE cam_motion_events_total counter\ncam_motion_events_total %u\n",
+                 motion.score, (unsigned)motion.events);
+  httpd_resp_send_chunk(req, line, len);
+#endif
+#if IDLE_POWER_SAVE
+  power_status_t power;
+  power_get_status(&power);
+  len = snprintf(line, sizeof(line),
+                 "# TYPE cam_power_state gauge\ncam_power_state %u\n"
+                 "# TYPE cam_power_idle_entries_total counter\ncam_power_idle_entries_total %u\n",
+                 (unsigned)power.state, (unsigned)power.idle_entries);
+  httpd_resp_send_chunk(req, line, len);
+#endif
+  return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+#if MOTION_DETECTION
+// /events[?since=id]: logged motion events newer than `since`, oldest first.
+// Times are milliseconds ago (esp_timer based), end_ms_ago is null while open.
+static esp_err_t events_handler(httpd_req_t *req) {
+  uint32_t since = 0;
+  char query[32];
+  char value[12];
+  if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+      httpd_query_key_value(query, "since", value, sizeof(value)) == ESP_OK) {
+    since = strtoul(value, nullptr, 10);
+  }
+
+  motion_event_t events[MOTION_EVENT_LOG];
+  int count = motion_get_events(since, events, MOTION_EVENT_LOG);
+  motion_status_t motion;
+  motion_get_status(&motion);
+  int64_t now = esp_timer_get_time();
+
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+
+  char buf[192];
+  int len = snprintf(buf, sizeof(buf), "{\"enabled\":%s,\"active\":%s,\"score\":%u,\"events\":[",
+                     motion.enabled ? "true" : "false", motion.active ? "true" : "false",
+                     motion.score);
+  httpd_resp_send_chunk(req, buf, len);
+  for (int i = 0; i < count; i++) {
+    const motion_event_t *e = &events[i];
+    char end[16] = "null";
+    if (e->end_us) {
+      snprintf(end, sizeof(end), "%u", (unsigned)((now - e->end_us) / 1000));
+    }
+    len = snprintf(buf, sizeof(buf),
+                   "%s{\"id\":%u,\"start_ms_ago\":%u,\"end_ms_ago\":%s,\"peak\":%u,"
+                   "\"box\":[%u,%u,%u,%u]}",
+                   i ? "," : "", (unsigned)e->id, (unsigned)((now - e->start_us) / 1000), end,
+                   e->peak, e->box.x, e->box.y, e->box.w, e->box.h);
+    httpd_resp_send_chunk(req, buf, len);
+  }
+  httpd_resp_sendstr_chunk(req, "]}");
+  return httpd_resp_send_chunk(req, NULL, 0);
+}
+#endif
+
+#if WS_STREAM
+// /ws: WebSocket viewer. One socket carries everything the UI needs:
+//   server -> client, binary: 8-byte header (sequence, sensor timestamp in ms,
+//                             both little-endian u32) followed by the JPEG
+//   server -> client, text:   {"type":"status",...} with the fields that changed
+//                             since the last one, {"type":"control",...} replies
+//   client -> server, text:   "ack <seq>" once a frame is shown, "set <query>"
+//                             with /control parameters, "status" for a full snapshot
+// Frames go out from a sender task as two fragments (header, then the JPEG
+// straight from the ring slot), so nothing is copied. The httpd worker only
+// parses client messages; replies are handed to the sender task so they never
+// interleave with a fragmented frame.
+typedef struct {
+  httpd_handle_t hd;
+  int fd;
+  int sub;
+  uint32_t refs;          // Sender task + httpd session context
+  bool closed;            // httpd dropped the session (context freed)
+  uint32_t sent;          // Sequence of the last frame sent (sender task only)
+  uint32_t acked;         // Highest sequence the client acknowledged
+  portMUX_TYPE lock;      // Guards reply and status_now
+  char reply[96];         // Pending control reply, empty if none
+  bool status_now;        // Send a full status snapshot next
+} ws_session_t;
+
+// Status fields pushed as deltas
+typedef enum {
+  WS_ST_FRAMESIZE,
+  WS_ST_QUALITY,
+  WS_ST_STREAM_DELAY,
+  WS_ST_ACHIEVED_FPS, // Tenths of a frame per second
+  WS_ST_WIFI_RSSI,
+  WS_ST_STREAM_CLIENTS,
+  WS_ST_DROPPED,
+  WS_ST_MOTION,
+  WS_ST_ROI_ZOOM,     // Applied zoom in percent
+  WS_ST_COUNT
+} ws_status_field_t;
+
+static const char *const WS_STATUS_NAMES[WS_ST_COUNT] = {
+  "framesize", "quality", "stream_delay", "achieved_fps",
+  "wifi_rssi", "stream_clients", "dropped", "motion", "roi_zoom",
+};
+
+static const uint32_t WS_FRAME_WAIT_MS = 100; // Reply latency while no frame arrives
+
+static void ws_session_release(ws_session_t *session) {
+  if (__atomic_sub_fetch(&session->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+    free(session);
+  }
+}
+
+// httpd free_ctx: the socket is gone, the sender task stops at its next check
+static void ws_session_free_ctx(void *ctx) {
+  ws_session_t *session = (ws_session_t *)ctx;
+  __atomic_store_n(&session->closed, true, __ATOMIC_RELEASE);
+  ws_session_release(session);
+}
+
+// Still our socket? The fd may already belong to a new client once httpd closed it
+static bool ws_session_alive(ws_session_t *session) {
+  return !__atomic_load_n(&session->closed, __ATOMIC_ACQUIRE) &&
+         httpd_sess_get_ctx(session->hd, session->fd) == session;
+}
+
+static esp_err_t ws_send_text(ws_session_t *session, const char *text, size_t len) {
+  httpd_ws_frame_t pkt = {};
+  pkt.type = HTTPD_WS_TYPE_TEXT;
+  pkt.payload = (uint8_t *)text;
+  pkt.len = len;
+  return httpd_ws_send_frame_async(session->hd, session->fd, &pkt);
+}
+
+static void ws_read_status(int32_t *v, int sub, float fps) {
+  sensor_t *s = esp_camera_sensor_get();
+  v[WS_ST_FRAMESIZE] = s ? s->status.framesize : -1;
+  v[WS_ST_QUALITY] = s ? s->status.quality : -1;
+  v[WS_ST_STREAM_DELAY] = stream_interval_us / 1000;
+  v[WS_ST_ACHIEVED_FPS] = (int32_t)(fps * 10 + 0.5f);
+  v[WS_ST_WIFI_RSSI] = WiFi.RSSI();
+  v[WS_ST_STREAM_CLIENTS] = __atomic_load_n(&stream_clients, __ATOMIC_RELAXED);
+  v[WS_ST_DROPPED] = frame_pipeline_dropped(sub);
+#if MOTION_DETECTION
+  motion_status_t motion;
+  motion_get_status(&motion);
+  v[WS_ST_MOTION] = motion.active;
+#else
+  v[WS_ST_MOTION] = 0;
+#endif
+  roi_window_t roi;
+  roi_get_window(&roi);
+  v[WS_ST_ROI_ZOOM] = roi.zoom;
+}
+
+// Format the fields that differ from `last` (all of them when full) and remember
+// them; returns the JSON length, or 0 when nothing changed
+static int ws_status_delta(const int32_t *now, int32_t *last, bool full, char *buf, size_t size) {
+  int len = snprintf(buf, size, "{\"type\":\"status\"");
+  bool changed = false;
+  for (int i = 0; i < WS_ST_COUNT; i++) {
+    if (!full && now[i] == last[i]) {
+      continue;
+    }
+    changed = true;
+    last[i] = now[i];
+    if (i == WS_ST_ACHIEVED_FPS) {
+      len += snprintf(buf + len, size - len, ",\"%s\":%d.%d", WS_STATUS_NAMES[i],
+                      (int)(now[i] / 10), (int)(now[i] % 10));
+    } else {
+      len += snprintf(buf + len, size - len, ",\"%s\":%d", WS_STATUS_NAMES[i], (int)now[i]);
+    }
+    if (i == WS_ST_FRAMESIZE && now[i] >= 0) {
+      len += snprintf(buf + len, size - len, ",\"framesize_name\":\"%s\"",
+                      framesize_name((framesize_t)now[i]));
+    }
+  }
+  len += snprintf(buf + len, size - len, "}");
+  return changed && len < (int)size ? len : 0;
+}
+
+// Control reply and status deltas queued since the last frame
+static esp_err_t ws_send_pending(ws_session_t *session, int32_t *last, int64_t *status_due,
+                                 float fps) {
+  char text[256];
+  bool full;
+  portENTER_CRITICAL(&session->lock);
+  size_t reply_len = strlen(session->reply);
+  memcpy(text, session->reply, reply_len);
+  session->reply[0] = '\0';
+  full = session->status_now;
+  session->status_now = false;
+  portEXIT_CRITICAL(&session->lock);
+
+  if (reply_len > 0 && ws_send_text(session, text, reply_len) != ESP_OK) {
+    return ESP_FAIL;
+  }
+
+  int64_t now = esp_timer_get_time();
+  if (!full && now < *status_due) {
+    return ESP_OK;
+  }
+  *status_due = now + (int64_t)WS_STATUS_INTERVAL_MS * 1000;
+
+  int32_t values[WS_ST_COUNT];
+  ws_read_status(values, session->sub, fps);
+  int len = ws_status_delta(values, last, full, text, sizeof(text));
+  return len > 0 ? ws_send_text(session, text, len) : ESP_OK;
+}
+
+// Header fragment, then the JPEG as the final continuation fragment
+static esp_err_t ws_send_frame(ws_session_t *session, const frame_t *frame, uint32_t seq) {
+  uint32_t ts_ms = (uint32_t)(frame->timestamp.tv_sec * 1000 + frame->timestamp.tv_usec / 1000);
+  uint8_t header[8];
+  for (int i = 0; i < 4; i++) {
+    header[i] = (uint8_t)(seq >> (8 * i));
+    header[4 + i] = (uint8_t)(ts_ms >> (8 * i));
+  }
+
+  httpd_ws_frame_t pkt = {};
+  pkt.type = HTTPD_WS_TYPE_BINARY;
+  pkt.fragmented = true;
+  pkt.final = false;
+  pkt.payload = header;
+  pkt.len = sizeof(header);
+  esp_err_t res = httpd_ws_send_frame_async(session->hd, session->fd, &pkt);
+  if (res != ESP_OK) {
+    return res;
+  }
+  pkt.type = HTTPD_WS_TYPE_CONTINUE;
+  pkt.final = true;
+  pkt.payload = frame->buf;
+  pkt.len = frame->len;
+  return httpd_ws_send_frame_async(session->hd, session->fd, &pkt);
+}
+
+static void ws_sender_task(void *arg) {
+  ws_session_t *session = (ws_session_t *)arg;
+  int32_t last[WS_ST_COUNT];
+  int64_t status_due = 0;
+  int64_t last_frame = 0;
+  int64_t ack_wait_since = 0;
+  float fps = 0;
+  frame_pacer_t pacer = {0};
+
+  log_i("WebSocket viewer connected");
+
+  while (ws_session_alive(session)) {
+    if (ws_send_pending(session, last, &status_due, fps) != ESP_OK) {
+      break;
+    }
+
+    frame_t *frame = frame_pipeline_wait(session->sub, WS_FRAME_WAIT_MS);
+    if (!frame) {
+      if (frame_pipeline_error_count() > 10) {
+        log_e("Too many capture errors, closing WebSocket viewer");
+        break;
+      }
+      continue;
+    }
+
+    // Backpressure: the client is still decoding, so skip this frame instead of
+    // queueing it behind the others; likewise while the link is down
+    int64_t now = esp_timer_get_time();
+    uint32_t inflight = session->sent - __atomic_load_n(&session->acked, __ATOMIC_ACQUIRE);
+    if (inflight >= WS_MAX_INFLIGHT || !wifi_link_up()) {
+      frame_pipeline_release(frame);
+      metrics_inc(METRIC_FRAMES_DROPPED);
+      if (ack_wait_since == 0) {
+        ack_wait_since = now;
+      } else if (now - ack_wait_since > (int64_t)WS_ACK_TIMEOUT_MS * 1000) {
+        log_w("No ack for %u ms, closing WebSocket viewer", WS_ACK_TIMEOUT_MS);
+        break;
+      }
+      continue;
+    }
+    ack_wait_since = 0;
+
+    int64_t send_start = now;
+    esp_err_t res = ws_send_frame(session, frame, session->sent + 1);
+    uint32_t send_us = (uint32_t)(esp_timer_get_time() - send_start);
+    size_t sent_len = frame->len;
+    frame_pipeline_release(frame);
+    if (res != ESP_OK) {
+      log_e("WebSocket send error: %d", res);
+      break;
+    }
+    __atomic_store_n(&session->sent, session->sent + 1, __ATOMIC_RELEASE);
+    metrics_inc(METRIC_FRAMES_SENT);
+    metrics_observe(METRIC_HIST_SEND_US, send_us);
+#if RATE_CONTROL
+    rate_control_observe(sent_len, send_us, __atomic_load_n(&stream_clients, __ATOMIC_RELAXED));
+#else
+    (void)sent_len;
+#endif
+
+    now = esp_timer_get_time();
+    if (last_frame > 0 && now > last_frame) {
+      float instant = 1000000.0f / (now - last_frame);
+      fps = (fps == 0) ? instant : fps * 0.9f + instant * 0.1f;
+      stream_achieved_fps = fps;
+      stream_last_frame_us = now;
+    }
+    last_frame = now;
+
+    pacer_wait(&pacer);
+  }
+
+  log_i("WebSocket viewer disconnected");
+  frame_pipeline_unsubscribe(session->sub);
+  __atomic_fetch_sub(&stream_clients, 1, __ATOMIC_RELAXED);
+  if (ws_session_alive(session)) {
+    httpd_sess_trigger_close(session->hd, session->fd);
+  }
+  ws_session_release(session);
+  vTaskDelete(NULL);
+}
+
+// Handshake completed: subscribe and hand the socket to a sender task
+static esp_err_t ws_open(httpd_req_t *req) {
+#if IDLE_POWER_SAVE
+  power_idle_touch();
+#endif
+  char query[64];
+  char profile[16] = "";
+  if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+    httpd_query_key_value(query, "profile", profile, sizeof(profile));
+  }
+
+  if (__atomic_add_fetch(&stream_clients, 1, __ATOMIC_RELAXED) > STREAM_MAX_CLIENTS) {
+    __atomic_fetch_sub(&stream_clients, 1, __ATOMIC_RELAXED);
+    log_w("Stream limit (%u) reached", STREAM_MAX_CLIENTS);
+    return ESP_FAIL; // Closes the socket
+  }
+
+  ws_session_t *session = (ws_session_t *)calloc(1, sizeof(ws_session_t));
+  if (session) {
+    session->sub = frame_pipeline_subscribe(strcmp(profile, "preview") == 0 ? FRAME_PROFILE_PREVIEW
+                                                                           : FRAME_PROFILE_FULL);
+  }
+  if (!session || session->sub < 0) {
+    free(session);
+    __atomic_fetch_sub(&stream_clients, 1, __ATOMIC_RELAXED);
+    return ESP_FAIL;
+  }
+  session->hd = req->handle;
+  session->fd = httpd_req_to_sockfd(req);
+  session->refs = 2;
+  session->status_now = true;
+  session->lock = portMUX_INITIALIZER_UNLOCKED;
+
+  // httpd owns one reference as the session context and drops it on close
+  req->sess_ctx = session;
+  req->free_ctx = ws_session_free_ctx;
+
+  tune_stream_socket(session->fd);
+  if (xTaskCreatePinnedToCore(ws_sender_task, "ws_tx", STREAM_SENDER_STACK, session,
+                              STREAM_SENDER_PRIORITY, NULL, HTTPD_TASK_CORE) != pdPASS) {
+    log_e("Failed to create WebSocket sender task");
+    frame_pipeline_unsubscribe(session->sub);
+    __atomic_fetch_sub(&stream_clients, 1, __ATOMIC_RELAXED);
+    ws_session_release(session); // The context reference goes when httpd closes
+    return ESP_FAIL;
+  }
+  return ESP_OK;
+}
+
+// "set <query>": same validation and batching as /control
+static void ws_control(ws_session_t *session, char *query) {
+  char reply[sizeof(session->reply)];
+  control_batch_t batch;
+  memset(&batch, 0xff, sizeof(batch)); // Every field -1: not requested
+  int count = 0;
+  sensor_t *s = esp_camera_sensor_get();
+  bool reconfigured = false;
+
+  if (!parse_control_query(query, &batch, &count)) {
+    snprintf(reply, sizeof(reply), "{\"type\":\"control\",\"error\":\"Invalid control request\"}");
+  } else if (!s || apply_control(s, &batch, &reconfigured) != ESP_OK) {
+    snprintf(reply, sizeof(reply), "{\"type\":\"control\",\"error\":\"Failed to apply\"}");
+  } else {
+    snprintf(reply, sizeof(reply), "{\"type\":\"control\",\"applied\":%d,\"reconfigured\":%s}",
+             count, reconfigured ? "true" : "false");
+  }
+
+  portENTER_CRITICAL(&session->lock);
+  strcpy(session->reply, reply);
+  session->status_now = true;
+  portEXIT_CRITICAL(&session->lock);
+}
+
+static esp_err_t ws_handler(httpd_req_t *req) {
+  if (req->method == HTTP_GET) {
+    return ws_open(req);
+  }
+
+  ws_session_t *session = (ws_session_t *)req->sess_ctx;
+  httpd_ws_frame_t pkt = {};
+  if (!session || httpd_ws_recv_frame(req, &pkt, 0) != ESP_OK) {
+    return ESP_FAIL;
+  }
+  char msg[256];
+  if (pkt.len >= sizeof(msg)) {
+    log_w("WebSocket message too long (%u bytes)", (unsigned)pkt.len);
+    return ESP_FAIL;
+  }
+  pkt.payload = (uint8_t *)msg;
+  if (pkt.len > 0 && httpd_ws_recv_frame(req, &pkt, pkt.len) != ESP_OK) {
+    return ESP_FAIL;
+  }
+  msg[pkt.len] = '\0';
+  if (pkt.type != HTTPD_WS_TYPE_TEXT) {
+    return ESP_OK;
+  }
+
+  if (strncmp(msg, "ack ", 4) == 0) {
+    // Acks only move forward; a stale or bogus one cannot release more frames
+    uint32_t seq = strtoul(msg + 4, nullptr, 10);
+    uint32_t acked = __atomic_load_n(&session->acked, __ATOMIC_RELAXED);
+    if ((int32_t)(seq - acked) > 0 && (int32_t)(seq - __atomic_load_n(&session->sent, __ATOMIC_ACQUIRE)) <= 0) {
+      __atomic_store_n(&session->acked, seq, __ATOMIC_RELEASE);
+    }
+  } else if (strncmp(msg, "set ", 4) == 0) {
+    ws_control(session, msg + 4);
+  } else if (strcmp(msg, "status") == 0) {
+    portENTER_CRITICAL(&session->lock);
+    session->status_now = true;
+    portEXIT_CRITICAL(&session->lock);
+  }
+  return ESP_OK;
+}
+#endif
+
+// Request latency wrapper: user_ctx names the real handler and its metric slot
+typedef struct {
+  esp_err_t (*handler)(httpd_req_t *req);
+  metric_endpoint_t endpoint;
+  bool wakes;  // Needs the camera awake (monitoring endpoints leave it idle)
+} timed_handler_t;
+
+static esp_err_t timed_handler(httpd_req_t *req) {
+  const timed_handler_t *timed = (const timed_handler_t *)req->user_ctx;
+#if IDLE_POWER_SAVE
+  if (timed->wakes) {
+    power_idle_touch();
+  }
+#endif
+  int64_t start = esp_timer_get_time();
+  esp_err_t res = timed->handler(req);
+  metrics_observe_endpoint(timed->endpoint, (uint32_t)(esp_timer_get_time() - start));
+  return res;
+}
+
+static const timed_handler_t timed_index = {index_handler, METRIC_EP_INDEX, true};
+static const timed_handler_t timed_status = {status_handler, METRIC_EP_STATUS, false};
+static const timed_handler_t timed_cmd = {cmd_handler, METRIC_EP_CONTROL, true};
+static const timed_handler_t timed_capture = {capture_handler, METRIC_EP_CAPTURE, true};
+static const timed_handler_t timed_health = {health_handler, METRIC_EP_HEALTH, false};
+static const timed_handler_t timed_metrics = {metrics_handler, METRIC_EP_METRICS, false};
+#if MOTION_DETECTION
+static const timed_handler_t timed_events = {events_handler, METRIC_EP_EVENTS, false};
+#endif
+
+// Endpoints served by other modules, woken like the timed ones that capture
+typedef struct {
+  esp_err_t (*handler)(httpd_req_t *req);
+} waking_handler_t;
+
+static esp_err_t waking_handler(httpd_req_t *req) {
+#if IDLE_POWER_SAVE
+  power_idle_touch();
+#endif
+  return ((const waking_handler_t *)req->user_ctx)->handler(req);
+}
+
+#if CLIP_RECORDER
+static const waking_handler_t waking_clip = {clip_handler};
+#endif
+#if TIMELAPSE
+static const waking_handler_t waking_timelapse = {timelapse_handler};
+#endif
+#if CAMERA_BENCHMARK
+static const waking_handler_t waking_benchmark = {benchmark_handler};
+#endif
+
+// Open stream, WebSocket and RTSP sessions, for the sketch's idle power saving
+uint32_t cameraServerSessions() {
+  uint32_t sessions = __atomic_load_n(&stream_clients, __ATOMIC_RELAXED);
+#if RTSP_SERVER
+  rtsp_status_t rtsp;
+  rtsp_get_status(&rtsp);
+  sessions += rtsp.sessions;
+#endif
+  return sessions;
+}
+
+// A background stage samples the pipeline, so the sensor has to keep capturing
+bool cameraServerBackground() {
+#if MOTION_DETECTION
+  if (motion_is_enabled()) {
+    return true;
+  }
+#endif
+#if CLIP_RECORDER
+  clip_status_t clip;
+  clip_get_status(&clip);
+  if (clip.running) {
+    return true;
+  }
+#endif
+#if TIMELAPSE
+  timelapse_status_t timelapse;
+  timelapse_get_status(&timelapse);
+  if (timelapse.active && timelapse.interval_s > 0) {
+    return true;
+  }
+#endif
+  return false;
+}
+
 // Start HTTP server on port 80 with all handlers
 void startCameraServer() {
   // Prevent multiple starts
@@ -385,10 +1495,47 @@ void startCameraServer() {
     return;
   }
 
+  // Stream-side settings restored from NVS alongside the sensor ones
+#if STREAM_PACING == STREAM_PACING_TUNABLE
+  stream_interval_us = (uint32_t)camera_settings.interval_ms * 1000;
+#endif
+  snapshot_max_age_ms = camera_settings.snapshot_max_age;
+  frame_pipeline_set_adaptive(camera_settings.adaptive);
+#if MOTION_DETECTION
+  motion_set_enabled(camera_settings.motion);
+#endif
+#if RATE_CONTROL
+  rate_control_set(RATE_CONTROL_DEFAULT_MODE, RATE_CONTROL_DEFAULT_TARGET);
+#endif
+
+  // One capture task feeds every stream and snapshot client
+  if (!frame_pipeline_start()) {
+    server_started = false;
+    return;
+  }
+  preview_stage_start();
+#if MOTION_DETECTION
+  motion_stage_start();
+#endif
+#if CLIP_RECORDER
+  clip_recorder_start();
+#endif
+#if TIMELAPSE
+  timelapse_init();
+#endif
+#if RTSP_SERVER
+  rtsp_server_start();
+#endif
+
   httpd_config_t config = HTTPD_DEFAULT_CONFIG();
   config.server_port = 80;
-  config.max_uri_handlers = 12; // Enough for all handlers
+  config.max_uri_handlers = 16; // Enough for all handlers
   config.lru_purge_enable = true; // Enable LRU purge for better memory management
+  config.core_id = HTTPD_TASK_CORE; // Keep senders off the capture core
+  config.max_open_sockets = HTTPD_MAX_SOCKETS;
+  config.backlog_conn = HTTPD_BACKLOG;
+  config.stack_size = HTTPD_STACK_SIZE;
+  config.task_priority = HTTPD_TASK_PRIORITY;
 
   // Start server
   esp_err_t err = httpd_start(&camera_httpd, &config);
@@ -402,36 +1549,36 @@ void startCameraServer() {
   httpd_uri_t index_uri = {
     .uri = "/",
     .method = HTTP_GET,
-    .handler = index_handler,
-    .user_ctx = NULL
+    .handler = timed_handler,
+    .user_ctx = (void *)&timed_index
   };
 
   httpd_uri_t status_uri = {
     .uri = "/status",
     .method = HTTP_GET,
-    .handler = status_handler,
-    .user_ctx = NULL
+    .handler = timed_handler,
+    .user_ctx = (void *)&timed_status
   };
 
   httpd_uri_t cmd_uri = {
     .uri = "/control",
     .method = HTTP_GET,
-    .handler = cmd_handler,
-    .user_ctx = NULL
+    .handler = timed_handler,
+    .user_ctx = (void *)&timed_cmd
   };
 
   httpd_uri_t capture_uri = {
     .uri = "/capture",
     .method = HTTP_GET,
-    .handler = capture_handler,
-    .user_ctx = NULL
+    .handler = timed_handler,
+    .user_ctx = (void *)&timed_capture
   };
 
   httpd_uri_t snapshot_uri = {
     .uri = "/snapshot",
     .method = HTTP_GET,
-    .handler = capture_handler,
-    .user_ctx = NULL
+    .handler = timed_handler,
+    .user_ctx = (void *)&timed_capture
   };
 
   httpd_uri_t stream_uri = {
@@ -444,8 +1591,15 @@ void startCameraServer() {
   httpd_uri_t health_uri = {
     .uri = "/health",
     .method = HTTP_GET,
-    .handler = health_handler,
-    .user_ctx = NULL
+    .handler = timed_handler,
+    .user_ctx = (void *)&timed_health
+  };
+
+  httpd_uri_t metrics_uri = {
+    .uri = "/metrics",
+    .method = HTTP_GET,
+    .handler = timed_handler,
+    .user_ctx = (void *)&timed_metrics
   };
 
   // Register handlers
@@ -456,9 +1610,101 @@ void startCameraServer() {
   httpd_register_uri_handler(camera_httpd, &snapshot_uri);
   httpd_register_uri_handler(camera_httpd, &stream_uri);
   httpd_register_uri_handler(camera_httpd, &health_uri);
+  httpd_register_uri_handler(camera_httpd, &metrics_uri);
+
+#if MOTION_DETECTION
+  httpd_uri_t events_uri = {
+    .uri = "/events",
+    .method = HTTP_GET,
+    .handler = timed_handler,
+    .user_ctx = (void *)&timed_events
+  };
+  httpd_register_uri_handler(camera_httpd, &events_uri);
+#endif
+
+#if WS_STREAM
+  httpd_uri_t ws_uri = {
+    .uri = "/ws",
+    .method = HTTP_GET,
+    .handler = ws_handler,
+    .user_ctx = NULL,
+    .is_websocket = true
+  };
+  httpd_register_uri_handler(camera_httpd, &ws_uri);
+#endif
+
+#if CLIP_RECORDER
+  httpd_uri_t clip_uri = {
+    .uri = "/clip",
+    .method = HTTP_GET,
+    .handler = waking_handler,
+    .user_ctx = (void *)&waking_clip
+  };
+  httpd_register_uri_handler(camera_httpd, &clip_uri);
+#endif
+
+#if TIMELAPSE
+  httpd_uri_t timelapse_uri = {
+    .uri = "/timelapse",
+    .method = HTTP_GET,
+    .handler = waking_handler,
+    .user_ctx = (void *)&waking_timelapse
+  };
+  httpd_register_uri_handler(camera_httpd, &timelapse_uri);
+#endif
+
+#if CAMERA_BENCHMARK
+  httpd_uri_t benchmark_uri = {
+    .uri = "/benchmark",
+    .method = HTTP_GET,
+    .handler = waking_handler,
+    .user_ctx = (void *)&waking_benchmark
+  };
+  httpd_register_uri_handler(camera_httpd, &benchmark_uri);
+  log_w("Benchmark endpoint enabled: /benchmark pauses live capture while it runs");
+#endif
+
+#if SNAPSHOT_SERVER_PORT
+  httpd_config_t snapshot_config = HTTPD_DEFAULT_CONFIG();
+  snapshot_config.server_port = SNAPSHOT_SERVER_PORT;
+  snapshot_config.ctrl_port = config.ctrl_port + 1; // Each server needs its own control socket
+  snapshot_config.max_uri_handlers = 1;
+  snapshot_config.max_open_sockets = SNAPSHOT_SERVER_SOCKETS;
+  snapshot_config.lru_purge_enable = true;
+  snapshot_config.core_id = HTTPD_TASK_CORE;
+  snapshot_config.stack_size = HTTPD_STACK_SIZE;
+  snapshot_config.task_priority = HTTPD_TASK_PRIORITY;
+
+  err = httpd_start(&snapshot_httpd, &snapshot_config);
+  if (err != ESP_OK) {
+    log_e("Failed to start snapshot server: %d", err);
+    server_started = false;
+    return;
+  }
+  httpd_register_uri_handler(snapshot_httpd, &snapshot_uri);
+  log_i("Snapshot server started on port %u (/snapshot for DWC)", SNAPSHOT_SERVER_PORT);
+#endif
 
   log_i("HTTP server started on port 80");
-  log_i("Endpoints: /, /stream, /capture, /snapshot, /status, /control, /health");
+  // Same guards as the registrations above, so the list matches this build
+  static const char endpoints[] = "/, /stream, /stream?profile=preview, /capture, /snapshot, /status, /control, /health, /metrics"
+#if MOTION_DETECTION
+        ", /events"
+#endif
+#if WS_STREAM
+        ", /ws"
+#endif
+#if CLIP_RECORDER
+        ", /clip"
+#endif
+#if TIMELAPSE
+        ", /timelapse"
+#endif
+#if CAMERA_BENCHMARK
+        ", /benchmark"
+#endif
+    ;
+  log_i("Endpoints: %s", endpoints);
   
   server_started = true;
 }
@@ -0,0 +1,381 @@
+#include "benchmark.h"
+#include "board_config.h"
+
+#if CAMERA_BENCHMARK
+
+#include "esp_camera.h"
+#include "esp_timer.h"
+#include "camera_board.h"
+#include "frame_pipeline.h"
+#include "jpeg_encoder.h"
+#include "sensor_roi.h"
+
+#include <esp32-hal-psram.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#endif
+
+// Driver config and init live in the main sketch
+extern camera_config_t camera_config;
+bool initCamera();
+
+#define BENCH_MAX_VALUES 8
+#define BENCH_MAX_FRAMES 100
+
+static const int BENCH_DEFAULT_FRAMES = 30;
+static const int BENCH_WARMUP_FRAMES = 3;
+static const uint32_t BENCH_TASK_STACK = 6144;
+
+typedef struct {
+  int values[BENCH_MAX_VALUES];
+  int count;
+} bench_list_t;
+
+// Parse a comma separated list of integers from the query, or keep the defaults
+static void parse_list(const char *query, const char *key, bench_list_t *list) {
+  char value[64];
+  if (!query || httpd_query_key_value(query, key, value, sizeof(value)) != ESP_OK) {
+    return;
+  }
+  list->count = 0;
+  char *save = nullptr;
+  for (char *tok = strtok_r(value, ",", &save); tok && list->count < BENCH_MAX_VALUES;
+       tok = strtok_r(nullptr, ",", &save)) {
+    list->values[list->count++] = atoi(tok);
+  }
+}
+
+static int compare_u32(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a;
+  uint32_t y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+// Raw sensor formats accepted by ?fmt=; raw cells also time each JPEG encoder backend
+static pixformat_t parse_format(const char *name) {
+  if (strcmp(name, "yuv422") == 0) return PIXFORMAT_YUV422;
+  if (strcmp(name, "rgb565") == 0) return PIXFORMAT_RGB565;
+  if (strcmp(name, "grayscale") == 0) return PIXFORMAT_GRAYSCALE;
+  return PIXFORMAT_JPEG;
+}
+
+typedef struct {
+  jpeg_encoder_t encoders[2]; // Software, then SIMD (when built in)
+  int count;
+  int64_t encode_us[2];
+  int encoded[2];
+  int fallbacks[2];           // Frames the backend handed to software, not timed
+} bench_encoders_t;
+
+static bool reinit_camera(framesize_t size, int fb_count, pixformat_t format) {
+  esp_camera_deinit();
+  camera_config_t config = camera_config;
+  config.frame_size = size;
+  config.fb_count = fb_count;
+  config.pixel_format = format;
+  return esp_camera_init(&config) == ESP_OK;
+}
+
+// Measure one quality setting; writes a JSON object into out
+// For raw formats quality is the encoder quality (1-100) rather than the sensor's
+static int measure_cell(int frames, int size, int quality, int fb_count, uint32_t *latency,
+                        uint8_t *copy_buf, size_t copy_cap, bench_encoders_t *enc, char *out,
+                        size_t out_len) {
+  sensor_t *s = esp_camera_sensor_get();
+  if (s && !enc) {
+    s->set_quality(s, quality);
+  }
+  if (enc) {
+    memset(enc->encode_us, 0, sizeof(enc->encode_us));
+    memset(enc->encoded, 0, sizeof(enc->encoded));
+    memset(enc->fallbacks, 0, sizeof(enc->fallbacks));
+  }
+
+  // Let exposure and the new quality settle
+  for (int i = 0; i < BENCH_WARMUP_FRAMES; i++) {
+    camera_fb_t *fb = esp_camera_fb_get();
+    if (fb) {
+      esp_camera_fb_return(fb);
+    }
+  }
+
+  int captured = 0;
+  uint64_t total_bytes = 0;
+  uint64_t total_wait_us = 0;
+  int64_t copy_us = 0;
+  int64_t start = esp_timer_get_time();
+
+  for (int i = 0; i < frames; i++) {
+    int64_t t0 = esp_timer_get_time();
+    camera_fb_t *fb = esp_camera_fb_get();
+    int64_t t1 = esp_timer_get_time();
+    if (!fb) {
+      continue;
+    }
+    latency[captured++] = (uint32_t)(t1 - t0);
+    total_wait_us += t1 - t0;
+    total_bytes += fb->len;
+
+    // The hot path copies every frame into a ring slot once; time the same move
+    if (copy_buf && fb->len <= copy_cap) {
+      int64_t c0 = esp_timer_get_time();
+      memcpy(copy_buf, fb->buf, fb->len);
+      copy_us += esp_timer_get_time() - c0;
+    }
+
+    // Encode the same raw frame with every backend, into the copy buffer
+    for (int b = 0; enc && copy_buf && b < enc->count; b++) {
+      size_t jpg_len = 0;
+      int64_t e0 = esp_timer_get_time();
+      jpeg_encoder_t *e = &enc->encoders[b];
+      if (jpeg_encoder_encode(e, fb->buf, fb->len, fb->width, fb->height, fb->format, quality,
+                              copy_buf, copy_cap, &jpg_len) != ESP_OK) {
+        continue;
+      }
+      // A SIMD frame that fell back is a software timing; keep it out of the SIMD column
+      if (e->last_backend != e->backend) {
+        enc->fallbacks[b]++;
+        continue;
+      }
+      enc->encode_us[b] += esp_timer_get_time() - e0;
+      enc->encoded[b]++;
+    }
+    esp_camera_fb_return(fb);
+  }
+  int64_t elapsed_us = esp_timer_get_time() - start;
+
+  if (captured == 0) {
+    return snprintf(out, out_len,
+                    "{\"framesize\":%d,\"quality\":%d,\"fb_count\":%d,\"error\":\"no frames\"}",
+                    size, quality, fb_count);
+  }
+
+  qsort(latency, captured, sizeof(uint32_t), compare_u32);
+  uint32_t p99 = latency[(captured * 99) / 100 < captured ? (captured * 99) / 100 : captured - 1];
+
+  int len = snprintf(out, out_len,
+                  "{\"framesize\":%d,\"width\":%u,\"height\":%u,\"quality\":%d,\"fb_count\":%d,"
+                  "\"frames\":%d,\"fps\":%.2f,\"fb_get_mean_us\":%u,\"fb_get_p99_us\":%u,"
+                  "\"jpeg_mean_bytes\":%u,\"copy_mbps\":%.1f",
+                  size, resolution[size].width, resolution[size].height, quality, fb_count,
+                  captured, captured * 1000000.0 / elapsed_us,
+                  (unsigned)(total_wait_us / captured), (unsigned)p99,
+                  (unsigned)(total_bytes / captured),
+                  copy_us > 0 ? (double)total_bytes / copy_us : 0.0);
+
+  for (int b = 0; enc && b < enc->count && len < (int)out_len; b++) {
+    const char *name = jpeg_encoder_backend_name(enc->encoders[b].backend);
+    uint32_t mean = enc->encoded[b] ? (uint32_t)(enc->encode_us[b] / enc->encoded[b]) : 0;
+    len += snprintf(out + len, out_len - len,
+                    ",\"encode_%s_us\":%u,\"encode_%s_fps\":%.1f,\"encode_%s_fallbacks\":%d", name,
+                    (unsigned)mean, name, mean ? 1000000.0 / mean : 0.0, name, enc->fallbacks[b]);
+  }
+  if (len < (int)out_len - 1) {
+    out[len++] = '}';
+    out[len] = '\0';
+  }
+  return len;
+}
+
+typedef struct {
+  httpd_req_t *req;
+  bench_list_t sizes;
+  bench_list_t qualities;
+  bench_list_t fb_counts;
+  int frames;
+  pixformat_t format;
+  camera_status_t saved; // Live settings, restored afterwards
+} bench_job_t;
+
+// One sweep at a time; the pipeline stays parked for its whole run
+static volatile bool bench_running = false;
+
+// Re-init the live configuration: framesize, then the stored ROI (the framesize
+// resets the sensor window), then the rest, and throw away the settling frames
+static bool restore_camera(const camera_status_t *saved) {
+  esp_camera_deinit();
+  bool restored = initCamera();
+  sensor_t *s = esp_camera_sensor_get();
+  if (restored && s) {
+    s->set_framesize(s, saved->framesize);
+    roi_reapply(s);
+    s->set_quality(s, saved->quality);
+    s->set_vflip(s, saved->vflip);
+    s->set_hmirror(s, saved->hmirror);
+  }
+  return restored && s;
+}
+
+// The sweep itself, streaming each cell to the client. Runs with capture parked
+// and the sensor lock held, so /control and the idle standby keep off the
+// driver while it is re-initialised.
+static esp_err_t run_benchmark(bench_job_t *job) {
+  uint32_t *latency = (uint32_t *)malloc(BENCH_MAX_FRAMES * sizeof(uint32_t));
+  size_t copy_cap = 512 * 1024;
+  uint8_t *copy_buf = psramFound() ? (uint8_t *)ps_malloc(copy_cap) : nullptr;
+
+  // Raw capture: compare the software encoder against the SIMD backend on the same frames
+  bench_encoders_t *encoders = nullptr;
+  if (job->format != PIXFORMAT_JPEG) {
+    encoders = (bench_encoders_t *)calloc(1, sizeof(bench_encoders_t));
+    if (encoders) {
+      jpeg_encoder_init(&encoders->encoders[encoders->count++], JPEG_BACKEND_SOFTWARE);
+#if JPEG_ENCODER_SIMD
+      jpeg_encoder_init(&encoders->encoders[encoders->count++], JPEG_BACKEND_SIMD);
+#endif
+    }
+  }
+
+  httpd_resp_set_type(job->req, "application/json");
+  httpd_resp_set_hdr(job->req, "Access-Control-Allow-Origin", "*");
+  httpd_resp_sendstr_chunk(job->req, "{\"cells\":[");
+
+  log_i("Benchmark: %d sizes x %d qualities x %d fb_counts, %d frames each", job->sizes.count,
+        job->qualities.count, job->fb_counts.count, job->frames);
+
+  char cell[512];
+  bool first = true;
+  for (int f = 0; f < job->fb_counts.count && latency; f++) {
+    for (int z = 0; z < job->sizes.count; z++) {
+      int size = job->sizes.values[z];
+      int fb_count = job->fb_counts.values[f];
+      // Sizes beyond what this sensor (or DRAM) can do are skipped
+      if (size < 0 || size > camera_max_framesize(psramFound()) || fb_count < 1 || fb_count > 3) {
+        continue;
+      }
+      if (!psramFound() && fb_count > 1) {
+        continue;
+      }
+
+      bool ok = reinit_camera((framesize_t)size, fb_count, job->format);
+      for (int q = 0; q < job->qualities.count; q++) {
+        int len;
+        if (ok) {
+          len = measure_cell(job->frames, size, job->qualities.values[q], fb_count, latency,
+                             copy_buf, copy_cap, encoders, cell, sizeof(cell));
+        } else {
+          len = snprintf(cell, sizeof(cell),
+                         "{\"framesize\":%d,\"quality\":%d,\"fb_count\":%d,\"error\":\"init failed\"}",
+                         size, job->qualities.values[q], fb_count);
+        }
+        if (!first) {
+          httpd_resp_send_chunk(job->req, ",", 1);
+        }
+        first = false;
+        httpd_resp_send_chunk(job->req, cell, len);
+      }
+    }
+  }
+
+  bool restored = restore_camera(&job->saved);
+  frame_pipeline_flush(BENCH_WARMUP_FRAMES); // Fresh init: let exposure settle
+  frame_pipeline_sensor_unlock();
+  frame_pipeline_resume();
+  bench_running = false;
+
+  free(latency);
+  free(copy_buf);
+  for (int b = 0; encoders && b < encoders->count; b++) {
+    jpeg_encoder_deinit(&encoders->encoders[b]);
+  }
+  free(encoders);
+
+  snprintf(cell, sizeof(cell),
+           "],\"grab_mode\":\"%s\",\"xclk_hz\":%d,\"raw_format\":%s,\"restored\":%s}",
+           camera_config.grab_mode == CAMERA_GRAB_LATEST ? "latest" : "when_empty",
+           camera_config.xclk_freq_hz, job->format == PIXFORMAT_JPEG ? "false" : "true",
+           restored ? "true" : "false");
+  httpd_resp_sendstr_chunk(job->req, cell);
+  return httpd_resp_send_chunk(job->req, NULL, 0);
+}
+
+static void benchmark_task(void *arg) {
+  bench_job_t *job = (bench_job_t *)arg;
+  run_benchmark(job);
+  httpd_req_async_handler_complete(job->req);
+  free(job);
+  vTaskDelete(NULL);
+}
+
+esp_err_t benchmark_handler(httpd_req_t *req) {
+  bench_job_t *job = (bench_job_t *)calloc(1, sizeof(bench_job_t));
+  if (!job) {
+    return httpd_resp_send_500(req);
+  }
+  job->sizes = {{FRAMESIZE_QVGA, FRAMESIZE_VGA, FRAMESIZE_SVGA, FRAMESIZE_HD}, 4};
+  job->qualities = {{10, 12, 20, 30}, 4};
+  job->fb_counts = {{1, 2, 3}, 3};
+  job->frames = BENCH_DEFAULT_FRAMES;
+  job->format = PIXFORMAT_JPEG;
+
+  char *query = nullptr;
+  size_t query_len = httpd_req_get_url_query_len(req);
+  if (query_len > 0) {
+    query = (char *)malloc(query_len + 1);
+    if (query && httpd_req_get_url_query_str(req, query, query_len + 1) == ESP_OK) {
+      char value[8];
+      if (httpd_query_key_value(query, "frames", value, sizeof(value)) == ESP_OK) {
+        job->frames = atoi(value);
+      }
+      if (httpd_query_key_value(query, "fmt", value, sizeof(value)) == ESP_OK) {
+        job->format = parse_format(value);
+        if (job->format != PIXFORMAT_JPEG) {
+          job->qualities = {{80}, 1};
+        }
+      }
+      parse_list(query, "sizes", &job->sizes);
+      parse_list(query, "qualities", &job->qualities);
+      parse_list(query, "fb", &job->fb_counts);
+    }
+    free(query);
+  }
+  if (job->frames < 1) job->frames = 1;
+  if (job->frames > BENCH_MAX_FRAMES) job->frames = BENCH_MAX_FRAMES;
+
+  // Remember the live settings so they can be restored afterwards
+  sensor_t *s = esp_camera_sensor_get();
+  if (!s) {
+    free(job);
+    return httpd_resp_send_500(req);
+  }
+  job->saved = s->status;
+
+  if (bench_running) {
+    free(job);
+    httpd_resp_set_status(req, "503 Service Unavailable");
+    return httpd_resp_sendstr(req, "Benchmark already running");
+  }
+  if (!frame_pipeline_suspend(2000)) {
+    free(job);
+    httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Capture pipeline busy");
+    return ESP_FAIL;
+  }
+  if (!frame_pipeline_sensor_lock(2000)) {
+    frame_pipeline_resume();
+    free(job);
+    httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Sensor busy");
+    return ESP_FAIL;
+  }
+  bench_running = true;
+
+  // The sweep takes minutes: run it on its own task so the worker keeps serving
+  // /status, /control and /capture meanwhile
+  if (httpd_req_async_handler_begin(req, &job->req) == ESP_OK) {
+    if (xTaskCreatePinnedToCore(benchmark_task, "bench", BENCH_TASK_STACK, job,
+                                STREAM_SENDER_PRIORITY, NULL, HTTPD_TASK_CORE) == pdPASS) {
+      return ESP_OK;
+    }
+    log_e("Failed to create benchmark task");
+    httpd_req_async_handler_complete(job->req);
+  }
+  job->req = req;
+  esp_err_t res = run_benchmark(job);
+  free(job);
+  return res;
+}
+
+#endif  // CAMERA_BENCHMARK
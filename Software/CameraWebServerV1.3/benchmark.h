@@ -0,0 +1,26 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "esp_http_server.h"
+
+//
+// On-device capture benchmark (built with CAMERA_BENCHMARK=1)
+//
+// GET /benchmark[?frames=N&sizes=5,8,9&qualities=10,12,20&fb=1,2&fmt=yuv422]
+//
+// For each framesize x fb_count cell the camera is re-initialised, then every
+// quality is measured over N frames: capture FPS, mean/p99 esp_camera_fb_get()
+// latency, mean JPEG size and ring-copy throughput. Each cell is streamed out as
+// it completes, and the original configuration (with the stored ROI) is
+// restored afterwards. The sweep runs on its own task with capture parked and
+// the sensor lock held: /status and /capture keep answering, /control fails
+// with 500 until it is done, and a second /benchmark gets 503.
+//
+// fmt=yuv422|rgb565|grayscale captures raw frames instead and times each JPEG
+// encoder backend (software, and SIMD on the S3) on the same frames; qualities
+// are then encoder qualities (1-100, default 80).
+//
+
+esp_err_t benchmark_handler(httpd_req_t *req);
+
+#endif  // BENCHMARK_H
@@ -12,6 +12,443 @@
 // Select camera model
 // ===================
 #define CAMERA_MODEL_XIAO_ESP32S3 // Has PSRAM
+//#define CAMERA_MODEL_AI_THINKER   // ESP32-CAM, OV2640, has PSRAM
+//#define CAMERA_MODEL_ESP32S3_EYE  // OV2640, has PSRAM
+
+// Sensor modules (camera_pins.h picks the board's usual one; camera_board.h
+// holds the per-sensor descriptors)
+#define CAMERA_SENSOR_OV2640 1
+#define CAMERA_SENSOR_OV3660 2
+#define CAMERA_SENSOR_OV5640 3
 #include "camera_pins.h"
 
+// ===================
+// Build profile
+// ===================
+// One tree covers what used to be separate sketch folders. The profile only
+// picks defaults for the switches below; each can still be overridden on its
+// own, and disabled paths are compiled out.
+//   CAMERA_PROFILE_STREAM  UI, stream and snapshots on port 80, tunable pacing (was V1.1/V1.3)
+//   CAMERA_PROFILE_DWC     adds a port-81 /snapshot server for Duet Web Control,
+//                          sensor warm-up, snapshot retries and a fixed 30 fps
+//                          stream cap with minimal logging (was V1.2)
+#define CAMERA_PROFILE_STREAM 0
+#define CAMERA_PROFILE_DWC    1
+#ifndef CAMERA_PROFILE
+#define CAMERA_PROFILE CAMERA_PROFILE_STREAM
+#endif
+
+// Second httpd instance serving only /snapshot (0 = off)
+#ifndef SNAPSHOT_SERVER_PORT
+#define SNAPSHOT_SERVER_PORT    (CAMERA_PROFILE == CAMERA_PROFILE_DWC ? 81 : 0)
+#endif
+#ifndef SNAPSHOT_SERVER_SOCKETS
+#define SNAPSHOT_SERVER_SOCKETS 2
+#endif
+
+// Frames grabbed and dropped after init so auto exposure has settled before
+// the first snapshot (0 = off)
+#ifndef CAMERA_WARMUP_FRAMES
+#define CAMERA_WARMUP_FRAMES    (CAMERA_PROFILE == CAMERA_PROFILE_DWC ? 3 : 0)
+#endif
+
+// Frame waits a /snapshot cache miss makes before answering 500
+#ifndef SNAPSHOT_RETRIES
+#define SNAPSHOT_RETRIES        (CAMERA_PROFILE == CAMERA_PROFILE_DWC ? 3 : 1)
+#endif
+
+// Stream pacing: TUNABLE follows /control target_fps / stream_delay (default
+// unpaced); FIXED paces every stream at STREAM_FIXED_INTERVAL_MS and ignores them
+#define STREAM_PACING_TUNABLE 0
+#define STREAM_PACING_FIXED   1
+#ifndef STREAM_PACING
+#define STREAM_PACING           (CAMERA_PROFILE == CAMERA_PROFILE_DWC ? STREAM_PACING_FIXED : STREAM_PACING_TUNABLE)
+#endif
+#ifndef STREAM_FIXED_INTERVAL_MS
+#define STREAM_FIXED_INTERVAL_MS 33
+#endif
+
+// Per-30-frame stream rate log (log_d)
+#ifndef STREAM_FPS_LOG
+#define STREAM_FPS_LOG          (CAMERA_PROFILE != CAMERA_PROFILE_DWC)
+#endif
+
+// Driver frame buffers with PSRAM (DRAM-only boards always use 1). Defaults to
+// the sensor descriptor's count in camera_board.h; define to override.
+//#define CAMERA_FB_COUNT         2
+
+// ===================
+// Task placement
+// ===================
+// Capture runs on its own core so slow TCP receivers never stall the sensor;
+// the httpd tasks live on the other core and only send.
+#ifndef CAPTURE_TASK_CORE
+#define CAPTURE_TASK_CORE     1
+#endif
+#ifndef CAPTURE_TASK_STACK
+#define CAPTURE_TASK_STACK    6144
+#endif
+#ifndef CAPTURE_TASK_PRIORITY
+#define CAPTURE_TASK_PRIORITY 6
+#endif
+#ifndef HTTPD_TASK_CORE
+#define HTTPD_TASK_CORE       0
+#endif
+
+// Ready-frame ring in PSRAM: each captured JPEG is copied into a slot and the
+// driver buffer is returned immediately. Slots grow on demand and are reused.
+#ifndef FRAME_RING_SLOTS
+#define FRAME_RING_SLOTS      10
+#endif
+
+// Per-client send queue (1-2 frames). A viewer that falls behind has its
+// oldest queued frame dropped, so it always gets the newest one next.
+#ifndef STREAM_CLIENT_QUEUE_DEPTH
+#define STREAM_CLIENT_QUEUE_DEPTH 1
+#endif
+#if STREAM_CLIENT_QUEUE_DEPTH < 1 || STREAM_CLIENT_QUEUE_DEPTH > 2
+#error "STREAM_CLIENT_QUEUE_DEPTH must be 1 or 2"
+#endif
+
+// Raw-socket streaming: /stream takes over the socket after the request is
+// parsed and writes multipart directly (no chunked encoding) from its own
+// sender task, freeing the httpd worker. Needs ESP-IDF 5.1+ async handlers.
+#ifndef STREAM_RAW_SOCKET
+#include "esp_idf_version.h"
+#define STREAM_RAW_SOCKET (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0))
+#endif
+#ifndef STREAM_SENDER_STACK
+#define STREAM_SENDER_STACK    4096
+#endif
+#ifndef STREAM_SENDER_PRIORITY
+#define STREAM_SENDER_PRIORITY 5
+#endif
+#ifndef STREAM_SOCKET_SNDBUF
+#define STREAM_SOCKET_SNDBUF   (32 * 1024)
+#endif
+
+// RTSP server for NVRs (rtsp://<ip>:RTSP_PORT/, any path): RTP/JPEG (RFC 2435)
+// over UDP unicast, one session per client and up to RTSP_MAX_SESSIONS, fed
+// by the frame pipeline like /stream. Each session binds the UDP port pair
+// RTSP_RTP_PORT + 2 * slot. Frames the payload format cannot carry (wider or
+// taller than 2040 px, progressive) are skipped. On by default in the stream
+// profile; the DWC profile keeps its sockets for the snapshot server.
+#ifndef RTSP_SERVER
+#define RTSP_SERVER            (CAMERA_PROFILE == CAMERA_PROFILE_STREAM)
+#endif
+#ifndef RTSP_PORT
+#define RTSP_PORT              554
+#endif
+#ifndef RTSP_MAX_SESSIONS
+#define RTSP_MAX_SESSIONS      1
+#endif
+#ifndef RTSP_RTP_PORT
+#define RTSP_RTP_PORT          5004
+#endif
+#ifndef RTSP_RTP_PAYLOAD
+#define RTSP_RTP_PAYLOAD       1400 // RTP payload per packet, under the Wi-Fi MTU
+#endif
+#ifndef RTSP_SESSION_TIMEOUT_S
+#define RTSP_SESSION_TIMEOUT_S 60   // Without a keep-alive request or RTCP report the session is torn down
+#endif
+#ifndef RTSP_TASK_PRIORITY
+#define RTSP_TASK_PRIORITY     4
+#endif
+// Listener, a spare for turning away extra clients, and TCP + UDP per session
+#define RTSP_LWIP_SOCKETS      (RTSP_SERVER ? 2 + 2 * RTSP_MAX_SESSIONS : 0)
+
+// HTTP server: one httpd worker handles every request, while stream sessions run
+// on their own sender tasks. Of the HTTPD_MAX_SOCKETS sessions,
+// HTTPD_CONTROL_SOCKETS are kept free of streams, so /status, /control and
+// snapshots are still accepted with the maximum number of viewers attached.
+// Each httpd instance uses 3 lwIP sockets itself (listener + control), so the
+// session limits of both servers (and the RTSP server's sockets) must fit in the
+// CONFIG_LWIP_MAX_SOCKETS budget.
+#ifndef HTTPD_MAX_SOCKETS
+#define HTTPD_MAX_SOCKETS      ((SNAPSHOT_SERVER_PORT ? 8 : 10) - RTSP_LWIP_SOCKETS)
+#endif
+#ifndef HTTPD_CONTROL_SOCKETS
+#define HTTPD_CONTROL_SOCKETS  3
+#endif
+#ifndef HTTPD_BACKLOG
+#define HTTPD_BACKLOG          5
+#endif
+#ifndef HTTPD_STACK_SIZE
+#define HTTPD_STACK_SIZE       6144 // /status and /control format JSON on the stack
+#endif
+#ifndef HTTPD_TASK_PRIORITY
+#define HTTPD_TASK_PRIORITY    6    // Above the stream senders, so control requests win the core
+#endif
+#define STREAM_MAX_CLIENTS     (HTTPD_MAX_SOCKETS - HTTPD_CONTROL_SOCKETS)
+#if STREAM_MAX_CLIENTS < 1
+#error "HTTPD_MAX_SOCKETS must leave room for at least one stream"
+#endif
+#include "sdkconfig.h"
+#define HTTPD_LWIP_SOCKETS     (HTTPD_MAX_SOCKETS + 3 + (SNAPSHOT_SERVER_PORT ? SNAPSHOT_SERVER_SOCKETS + 3 : 0))
+#if defined(CONFIG_LWIP_MAX_SOCKETS) && HTTPD_LWIP_SOCKETS + RTSP_LWIP_SOCKETS > CONFIG_LWIP_MAX_SOCKETS
+#error "HTTP and RTSP server socket limits exceed CONFIG_LWIP_MAX_SOCKETS"
+#endif
+
+// WebSocket viewer (/ws): binary JPEG frames pushed on one socket, with status
+// deltas every WS_STATUS_INTERVAL_MS and /control requests riding along. The
+// client acks each frame once it is decoded; with WS_MAX_INFLIGHT frames
+// unacknowledged, new frames are skipped rather than queued in the socket, and
+// a session without an ack for WS_ACK_TIMEOUT_MS is closed. Each viewer counts
+// against STREAM_MAX_CLIENTS. Needs CONFIG_HTTPD_WS_SUPPORT (on in arduino-esp32).
+#ifndef WS_STREAM
+#if defined(CONFIG_HTTPD_WS_SUPPORT)
+#define WS_STREAM              1
+#else
+#define WS_STREAM              0
+#endif
+#endif
+#if WS_STREAM && !defined(CONFIG_HTTPD_WS_SUPPORT)
+#error "WS_STREAM needs CONFIG_HTTPD_WS_SUPPORT"
+#endif
+#ifndef WS_MAX_INFLIGHT
+#define WS_MAX_INFLIGHT        2
+#endif
+#ifndef WS_ACK_TIMEOUT_MS
+#define WS_ACK_TIMEOUT_MS      10000
+#endif
+#ifndef WS_STATUS_INTERVAL_MS
+#define WS_STATUS_INTERVAL_MS  1000
+#endif
+
+// Raw-capture JPEG encoder (YUV422/RGB565/grayscale sensor modes and the
+// preview stage). On the ESP32-S3, when the espressif/esp_new_jpeg component is
+// part of the build, its PIE vector code handles colour conversion and DCT;
+// otherwise the esp32-camera software encoder is used.
+#ifndef JPEG_ENCODER_SIMD
+#include "sdkconfig.h"
+#if defined(CONFIG_IDF_TARGET_ESP32S3) && __has_include("esp_jpeg_enc.h")
+#define JPEG_ENCODER_SIMD 1
+#else
+#define JPEG_ENCODER_SIMD 0
+#endif
+#endif
+
+// Preview profile (/stream?profile=preview): each full frame is decoded at
+// 1/2, 1/4 or 1/8 scale (the largest step still at least PREVIEW_TARGET_WIDTH
+// wide) and re-encoded. Runs on the httpd core, only while previews are open.
+#ifndef PREVIEW_TARGET_WIDTH
+#define PREVIEW_TARGET_WIDTH   320
+#endif
+#ifndef PREVIEW_JPEG_QUALITY
+#define PREVIEW_JPEG_QUALITY   60
+#endif
+#ifndef PREVIEW_TASK_STACK
+#define PREVIEW_TASK_STACK     8192
+#endif
+#ifndef PREVIEW_TASK_PRIORITY
+#define PREVIEW_TASK_PRIORITY  3
+#endif
+
+// Adaptive frame rate: once nothing in the scene has changed for
+// ADAPTIVE_QUIET_AFTER_MS (JPEG size moving less than ADAPTIVE_CHANGE_PERMILLE
+// between frames, and no motion events), capture drops to ADAPTIVE_QUIET_FPS.
+// Any change, new viewer or cache miss brings it straight back to full rate.
+// Runtime switch: /control var=adaptive.
+#ifndef ADAPTIVE_FPS_DEFAULT
+#define ADAPTIVE_FPS_DEFAULT     1
+#endif
+#ifndef ADAPTIVE_QUIET_FPS
+#define ADAPTIVE_QUIET_FPS       2
+#endif
+#ifndef ADAPTIVE_QUIET_AFTER_MS
+#define ADAPTIVE_QUIET_AFTER_MS  10000
+#endif
+#ifndef ADAPTIVE_CHANGE_PERMILLE
+#define ADAPTIVE_CHANGE_PERMILLE 30
+#endif
+
+// Motion detection stage: samples the latest full frame every
+// MOTION_INTERVAL_MS, decodes it at 1/8 (or 1/4) scale into a luma plane and
+// compares MOTION_BLOCK_SIZE blocks against a running background. A block whose
+// mean absolute difference exceeds MOTION_BLOCK_THRESHOLD counts as changed;
+// motion is reported once MOTION_TRIGGER_PERMILLE of the blocks have changed.
+// Sampling keeps the sensor capturing even with no viewers (no demand-driven
+// park, no quiet rate, no idle standby), which costs power and heat, so it
+// starts off unless MOTION_DEFAULT_ENABLED; /control var=motion turns it on
+// and the choice is persisted.
+#ifndef MOTION_DETECTION
+#define MOTION_DETECTION       1
+#endif
+#ifndef MOTION_DEFAULT_ENABLED
+#define MOTION_DEFAULT_ENABLED 0
+#endif
+#ifndef MOTION_INTERVAL_MS
+#define MOTION_INTERVAL_MS     200
+#endif
+#ifndef MOTION_BLOCK_SIZE
+#define MOTION_BLOCK_SIZE      8
+#endif
+#ifndef MOTION_BLOCK_THRESHOLD
+#define MOTION_BLOCK_THRESHOLD 12
+#endif
+#ifndef MOTION_TRIGGER_PERMILLE
+#define MOTION_TRIGGER_PERMILLE 10
+#endif
+#ifndef MOTION_HOLD_MS
+#define MOTION_HOLD_MS         2000
+#endif
+#ifndef MOTION_TASK_STACK
+#define MOTION_TASK_STACK      4096
+#endif
+#ifndef MOTION_TASK_PRIORITY
+#define MOTION_TASK_PRIORITY   2
+#endif
+
+// Pre-event clip recorder (/clip): keeps the last CLIP_SECONDS of JPEG frames,
+// sampled at up to CLIP_FPS, in a CLIP_BUFFER_KB PSRAM arena (one memcpy per
+// frame, oldest evicted first) and exports them as AVI or MJPEG while live
+// capture carries on. Disabled at runtime on boards without PSRAM. Recording
+// keeps the sensor capturing around the clock (no demand-driven park, no idle
+// standby) at the cost of power and heat, so it is compiled out by default.
+#ifndef CLIP_RECORDER
+#define CLIP_RECORDER          0
+#endif
+#ifndef CLIP_SECONDS
+#define CLIP_SECONDS           30
+#endif
+#ifndef CLIP_FPS
+#define CLIP_FPS               5
+#endif
+#ifndef CLIP_BUFFER_KB
+#define CLIP_BUFFER_KB         3072
+#endif
+#ifndef CLIP_TASK_STACK
+#define CLIP_TASK_STACK        4096
+#endif
+#ifndef CLIP_TASK_PRIORITY
+#define CLIP_TASK_PRIORITY     2
+#endif
+
+// SD timelapse (/timelapse): shots are taken on an interval or on demand,
+// copied into one of TIMELAPSE_STAGE_SLOTS PSRAM staging buffers and written
+// out by a low-priority task in TIMELAPSE_WRITE_CHUNK sector-aligned writes,
+// so a slow card only ever delays the writer. Needs a board with SD pins, on
+// SDMMC 1-bit or SPI. Where the card's CS is also the status LED (XIAO Sense)
+// timelapse is off by default, since it costs the connect/reconnect LED
+// feedback: define TIMELAPSE 1 to trade the LED for the card.
+#ifndef TIMELAPSE
+#if defined(SD_SPI_CS_GPIO_NUM) && defined(STATUS_LED_GPIO_NUM) && \
+    SD_SPI_CS_GPIO_NUM == STATUS_LED_GPIO_NUM
+#define TIMELAPSE 0
+#elif defined(SD_MMC_CLK_GPIO_NUM) || defined(SD_SPI_CS_GPIO_NUM)
+#define TIMELAPSE 1
+#else
+#define TIMELAPSE 0
+#endif
+#endif
+#if TIMELAPSE && defined(SD_SPI_CS_GPIO_NUM) && defined(STATUS_LED_GPIO_NUM) && \
+    SD_SPI_CS_GPIO_NUM == STATUS_LED_GPIO_NUM
+#undef STATUS_LED_GPIO_NUM
+#undef STATUS_LED_ON
+#endif
+#ifndef TIMELAPSE_STAGE_SLOTS
+#define TIMELAPSE_STAGE_SLOTS     4
+#endif
+#ifndef TIMELAPSE_WRITE_CHUNK
+#define TIMELAPSE_WRITE_CHUNK     (16 * 1024)
+#endif
+#ifndef TIMELAPSE_WRITER_PRIORITY
+#define TIMELAPSE_WRITER_PRIORITY 1
+#endif
+#ifndef TIMELAPSE_SHOT_PRIORITY
+#define TIMELAPSE_SHOT_PRIORITY   3
+#endif
+#ifndef TIMELAPSE_TASK_STACK
+#define TIMELAPSE_TASK_STACK      4096
+#endif
+
+// Wi-Fi startup: association runs while the sensor initialises, and the HTTP
+// server starts on IP_EVENT_STA_GOT_IP. WIFI_FAST_RECONNECT joins the BSSID and
+// channel cached from the last good association (no scan), falling back to a
+// normal scan if that AP does not associate within WIFI_FAST_CONNECT_TIMEOUT_MS
+// (DHCP afterwards runs on the normal attempt timeout).
+// Define WIFI_STATIC_IP / WIFI_GATEWAY / WIFI_SUBNET (e.g. "192.168.1.50") to
+// skip DHCP as well; WIFI_DNS is optional.
+#ifndef WIFI_FAST_RECONNECT
+#define WIFI_FAST_RECONNECT          1
+#endif
+#ifndef WIFI_FAST_CONNECT_TIMEOUT_MS
+#define WIFI_FAST_CONNECT_TIMEOUT_MS 3000
+#endif
+
+// Reconnect backoff: a dropped link is retried after WIFI_RECONNECT_MIN_MS,
+// doubling per failed attempt up to WIFI_RECONNECT_MAX_MS. An attempt without an
+// IP after WIFI_ATTEMPT_TIMEOUT_MS counts as failed. Streams stay open (frames
+// are skipped) for up to STREAM_LINK_HOLD_MS of downtime before being closed.
+#ifndef WIFI_RECONNECT_MIN_MS
+#define WIFI_RECONNECT_MIN_MS        500
+#endif
+#ifndef WIFI_RECONNECT_MAX_MS
+#define WIFI_RECONNECT_MAX_MS        30000
+#endif
+#ifndef WIFI_ATTEMPT_TIMEOUT_MS
+#define WIFI_ATTEMPT_TIMEOUT_MS      15000
+#endif
+#ifndef STREAM_LINK_HOLD_MS
+#define STREAM_LINK_HOLD_MS          30000
+#endif
+
+// Low-power idle: after IDLE_TIMEOUT_S without a stream, WebSocket or RTSP
+// session or a capturing request, Wi-Fi modem sleep is enabled and the CPU
+// drops to IDLE_CPU_MHZ (80 minimum, for Wi-Fi and the camera clock). If no
+// background stage (motion, clip recorder, interval timelapse) needs frames,
+// capture is also parked and the sensor put into software standby; with motion
+// and the clip recorder opt-in that is the default. The next such request has
+// loop() wake it, discarding IDLE_REWARM_FRAMES instead of the boot warm-up.
+// loop() polls every IDLE_LOOP_DELAY_MS while idle, sooner when woken.
+#ifndef IDLE_POWER_SAVE
+#define IDLE_POWER_SAVE              1
+#endif
+#ifndef IDLE_TIMEOUT_S
+#define IDLE_TIMEOUT_S               120
+#endif
+#ifndef IDLE_CPU_MHZ
+#define IDLE_CPU_MHZ                 80
+#endif
+#ifndef IDLE_REWARM_FRAMES
+#define IDLE_REWARM_FRAMES           2
+#endif
+#ifndef IDLE_LOOP_DELAY_MS
+#define IDLE_LOOP_DELAY_MS           100
+#endif
+#if IDLE_CPU_MHZ < 80
+#error "IDLE_CPU_MHZ below 80 stops Wi-Fi"
+#endif
+
+// Closed-loop JPEG quality (/control?var=rate_kbps&val=### or rate_fps): each
+// RATE_CONTROL_INTERVAL_MS the per-stream bitrate or send time is compared with
+// the target and the sensor quality is stepped within [RATE_QUALITY_MIN,
+// RATE_QUALITY_MAX]. RATE_QUALITY_MIN 0 means the sensor's own minimum. The
+// controller starts in RATE_CONTROL_DEFAULT_MODE (RATE_MODE_OFF, _BITRATE, _FPS).
+#ifndef RATE_CONTROL
+#define RATE_CONTROL                 1
+#endif
+#ifndef RATE_CONTROL_INTERVAL_MS
+#define RATE_CONTROL_INTERVAL_MS     1000
+#endif
+#ifndef RATE_QUALITY_MIN
+#define RATE_QUALITY_MIN             0
+#endif
+#ifndef RATE_QUALITY_MAX
+#define RATE_QUALITY_MAX             40
+#endif
+#ifndef RATE_CONTROL_DEFAULT_MODE
+#define RATE_CONTROL_DEFAULT_MODE    RATE_MODE_OFF
+#endif
+#ifndef RATE_CONTROL_DEFAULT_TARGET
+#define RATE_CONTROL_DEFAULT_TARGET  0
+#endif
+
+// On-device benchmark (/benchmark): sweeps framesize x quality x fb_count and
+// reports capture FPS, fb_get latency and JPEG size as JSON. Live capture is
+// paused while it runs, so it is compiled out by default.
+#ifndef CAMERA_BENCHMARK
+#define CAMERA_BENCHMARK 0
+#endif
+
 #endif  // BOARD_CONFIG_H
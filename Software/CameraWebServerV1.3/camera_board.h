@@ -0,0 +1,123 @@
+#ifndef CAMERA_BOARD_H
+#define CAMERA_BOARD_H
+
+#include "esp_camera.h"
+#include "board_config.h"
+#include <stdint.h>
+
+//
+// Compile-time board and sensor descriptors
+//
+// The board selected in board_config.h (pins from camera_pins.h) and its sensor
+// are resolved into constexpr descriptors, so initCamera, the settings defaults
+// and /control validation are specialised per build: the wrong pin set or a
+// framesize the sensor cannot produce is rejected by the compiler, not at boot.
+//
+
+typedef struct {
+  const char *name;
+  uint16_t pid;               // sensor_id_t PID the driver reports
+  framesize_t max_framesize;  // Largest native window
+  framesize_t default_framesize;
+  uint32_t xclk_freq_hz;
+  uint8_t default_quality;    // With PSRAM; DRAM-only boards use no_psram_quality
+  uint8_t no_psram_quality;
+  uint8_t min_quality;        // Lower values overflow the frame buffer at max size
+  uint8_t fb_count;           // Driver buffers with PSRAM
+  // Windowing geometry for set_res_raw (sensor_roi.cpp), from the driver's 4:3
+  // timing row; array_width 0 = the sensor's set_res_raw takes other arguments
+  uint16_t array_width, array_height; // Active pixel array
+  uint8_t margin_x, margin_y;         // ISP border read beyond the window
+  uint8_t offset_x, offset_y;
+  uint16_t total_x, total_y;          // HTS / VTS
+  // Software standby bit for set_reg (power_idle.cpp); mask 0 = none
+  uint16_t standby_reg;
+  uint8_t standby_mask;
+} camera_sensor_desc_t;
+
+typedef struct {
+  const char *name;
+  int8_t pin_pwdn, pin_reset, pin_xclk, pin_sda, pin_scl;
+  int8_t pin_d[8];            // D0..D7 (Y2..Y9)
+  int8_t pin_vsync, pin_href, pin_pclk;
+} camera_board_desc_t;
+
+// OV2640: 2 MP, JPEG engine struggles below quality 10 at UXGA; its
+// set_res_raw selects a sensor mode instead of a window, so no ROI.
+// Standby is COM2 in the sensor bank (bank bit 0x100 for set_reg).
+static constexpr camera_sensor_desc_t SENSOR_OV2640 = {
+  "OV2640", OV2640_PID, FRAMESIZE_UXGA, FRAMESIZE_SVGA, 20000000, 12, 16, 10, 2,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0x109, 0x10,
+};
+
+// OV3660: 3 MP; SYSTEM_CTROL0 power-down for standby
+static constexpr camera_sensor_desc_t SENSOR_OV3660 = {
+  "OV3660", OV3660_PID, FRAMESIZE_QXGA, FRAMESIZE_SVGA, 20000000, 12, 16, 5, 2,
+  2048, 1536, 32, 12, 16, 6, 2300, 1564,
+  0x3008, 0x40,
+};
+
+// OV5640: 5 MP; larger frames, so a third buffer keeps capture ahead of the
+// copy. Standby as OV3660.
+static constexpr camera_sensor_desc_t SENSOR_OV5640 = {
+  "OV5640", OV5640_PID, FRAMESIZE_QSXGA, FRAMESIZE_SVGA, 20000000, 12, 16, 5, 3,
+  2560, 1920, 64, 32, 32, 16, 2844, 1968,
+  0x3008, 0x40,
+};
+
+#if CAMERA_SENSOR == CAMERA_SENSOR_OV2640
+static constexpr const camera_sensor_desc_t &CAMERA_SENSOR_DESC = SENSOR_OV2640;
+#elif CAMERA_SENSOR == CAMERA_SENSOR_OV3660
+static constexpr const camera_sensor_desc_t &CAMERA_SENSOR_DESC = SENSOR_OV3660;
+#elif CAMERA_SENSOR == CAMERA_SENSOR_OV5640
+static constexpr const camera_sensor_desc_t &CAMERA_SENSOR_DESC = SENSOR_OV5640;
+#else
+#error "CAMERA_SENSOR not set for this board"
+#endif
+
+static constexpr camera_board_desc_t CAMERA_BOARD_DESC = {
+  CAMERA_BOARD_NAME,
+  PWDN_GPIO_NUM, RESET_GPIO_NUM, XCLK_GPIO_NUM, SIOD_GPIO_NUM, SIOC_GPIO_NUM,
+  {Y2_GPIO_NUM, Y3_GPIO_NUM, Y4_GPIO_NUM, Y5_GPIO_NUM, Y6_GPIO_NUM, Y7_GPIO_NUM, Y8_GPIO_NUM, Y9_GPIO_NUM},
+  VSYNC_GPIO_NUM, HREF_GPIO_NUM, PCLK_GPIO_NUM,
+};
+
+#ifdef CAMERA_FB_COUNT
+static constexpr uint8_t CAMERA_FB_COUNT_PSRAM = CAMERA_FB_COUNT;
+#else
+static constexpr uint8_t CAMERA_FB_COUNT_PSRAM = CAMERA_SENSOR_DESC.fb_count;
+#endif
+
+// Frames larger than SVGA need PSRAM-backed buffers
+static constexpr framesize_t CAMERA_NO_PSRAM_MAX_FRAMESIZE = FRAMESIZE_SVGA;
+
+static constexpr bool board_pins_valid(const camera_board_desc_t &b) {
+  return b.pin_xclk >= 0 && b.pin_pclk >= 0 && b.pin_vsync >= 0 && b.pin_href >= 0 &&
+         b.pin_sda >= 0 && b.pin_scl >= 0 && b.pin_d[0] >= 0 && b.pin_d[1] >= 0 &&
+         b.pin_d[2] >= 0 && b.pin_d[3] >= 0 && b.pin_d[4] >= 0 && b.pin_d[5] >= 0 &&
+         b.pin_d[6] >= 0 && b.pin_d[7] >= 0;
+}
+
+static_assert(board_pins_valid(CAMERA_BOARD_DESC), "Board is missing a required camera pin");
+static_assert(CAMERA_SENSOR_DESC.default_framesize <= CAMERA_SENSOR_DESC.max_framesize &&
+                  CAMERA_SENSOR_DESC.max_framesize < FRAMESIZE_INVALID,
+              "Sensor default framesize out of range");
+static_assert(CAMERA_SENSOR_DESC.min_quality <= CAMERA_SENSOR_DESC.default_quality &&
+                  CAMERA_SENSOR_DESC.default_quality <= 63,
+              "Sensor default quality out of range");
+static_assert(CAMERA_SENSOR_DESC.array_width == 0 ||
+                  (CAMERA_SENSOR_DESC.total_x > CAMERA_SENSOR_DESC.array_width + CAMERA_SENSOR_DESC.margin_x &&
+                   CAMERA_SENSOR_DESC.total_y >= CAMERA_SENSOR_DESC.array_height + CAMERA_SENSOR_DESC.margin_y),
+              "Sensor window timing smaller than its pixel array");
+static_assert(CAMERA_FB_COUNT_PSRAM >= 1 && CAMERA_FB_COUNT_PSRAM <= 3, "CAMERA_FB_COUNT must be 1-3");
+
+// Sensor windowing (digital zoom) available on this build
+static constexpr bool CAMERA_ROI_SUPPORTED = CAMERA_SENSOR_DESC.array_width != 0;
+
+// Largest framesize this build can serve with or without PSRAM
+static inline framesize_t camera_max_framesize(bool psram) {
+  return psram ? CAMERA_SENSOR_DESC.max_framesize : CAMERA_NO_PSRAM_MAX_FRAMESIZE;
+}
+
+#endif  // CAMERA_BOARD_H
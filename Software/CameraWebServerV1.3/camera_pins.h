@@ -1,4 +1,11 @@
+// Each board also names itself, its sensor (CAMERA_SENSOR, overridable for
+// boards sold with either module) and its status LED, if it has one.
+
 #if defined(CAMERA_MODEL_XIAO_ESP32S3)
+#define CAMERA_BOARD_NAME "Seeed Studio XIAO ESP32-S3 Sense"
+#ifndef CAMERA_SENSOR
+#define CAMERA_SENSOR  CAMERA_SENSOR_OV3660
+#endif
 #define PWDN_GPIO_NUM  -1
 #define RESET_GPIO_NUM -1
 #define XCLK_GPIO_NUM  10
@@ -17,6 +24,82 @@
 #define HREF_GPIO_NUM  47
 #define PCLK_GPIO_NUM  13
 
+// microSD slot on the Sense expansion board. Its CS/DAT3 line is GPIO21,
+// shared with the user LED; SDMMC would see DAT3 pulled low by the LED and the
+// card drop into SPI mode, so it is driven over SPI as in Seeed's examples
+// (so timelapse, which needs the card, is opt-in there: see board_config.h)
+#define SD_SPI_SCK_GPIO_NUM  7
+#define SD_SPI_MISO_GPIO_NUM 8
+#define SD_SPI_MOSI_GPIO_NUM 9
+#define SD_SPI_CS_GPIO_NUM   21
+
+// User LED, active LOW
+#define STATUS_LED_GPIO_NUM 21
+#define STATUS_LED_ON       LOW
+
+#elif defined(CAMERA_MODEL_AI_THINKER)
+#define CAMERA_BOARD_NAME "AI-Thinker ESP32-CAM"
+#ifndef CAMERA_SENSOR
+#define CAMERA_SENSOR  CAMERA_SENSOR_OV2640
+#endif
+#define PWDN_GPIO_NUM  32
+#define RESET_GPIO_NUM -1
+#define XCLK_GPIO_NUM  0
+#define SIOD_GPIO_NUM  26
+#define SIOC_GPIO_NUM  27
+
+#define Y9_GPIO_NUM    35
+#define Y8_GPIO_NUM    34
+#define Y7_GPIO_NUM    39
+#define Y6_GPIO_NUM    36
+#define Y5_GPIO_NUM    21
+#define Y4_GPIO_NUM    19
+#define Y3_GPIO_NUM    18
+#define Y2_GPIO_NUM    5
+#define VSYNC_GPIO_NUM 25
+#define HREF_GPIO_NUM  23
+#define PCLK_GPIO_NUM  22
+
+// microSD slot (SDMMC IOMUX pins, used 1-bit so GPIO4 stays the flash LED)
+#define SD_MMC_CLK_GPIO_NUM 14
+#define SD_MMC_CMD_GPIO_NUM 15
+#define SD_MMC_D0_GPIO_NUM  2
+
+// Flash LED
+#define LED_GPIO_NUM   4
+
+// Red LED on the back, active LOW
+#define STATUS_LED_GPIO_NUM 33
+#define STATUS_LED_ON       LOW
+
+#elif defined(CAMERA_MODEL_ESP32S3_EYE)
+#define CAMERA_BOARD_NAME "Espressif ESP32-S3-EYE"
+#ifndef CAMERA_SENSOR
+#define CAMERA_SENSOR  CAMERA_SENSOR_OV2640
+#endif
+#define PWDN_GPIO_NUM  -1
+#define RESET_GPIO_NUM -1
+#define XCLK_GPIO_NUM  15
+#define SIOD_GPIO_NUM  4
+#define SIOC_GPIO_NUM  5
+
+#define Y9_GPIO_NUM    16
+#define Y8_GPIO_NUM    17
+#define Y7_GPIO_NUM    18
+#define Y6_GPIO_NUM    12
+#define Y5_GPIO_NUM    10
+#define Y4_GPIO_NUM    8
+#define Y3_GPIO_NUM    9
+#define Y2_GPIO_NUM    11
+#define VSYNC_GPIO_NUM 6
+#define HREF_GPIO_NUM  7
+#define PCLK_GPIO_NUM  13
+
+// microSD slot (SDMMC 1-bit)
+#define SD_MMC_CLK_GPIO_NUM 39
+#define SD_MMC_CMD_GPIO_NUM 38
+#define SD_MMC_D0_GPIO_NUM  40
+
 #else
 #error "Camera model not selected"
 #endif
@@ -0,0 +1,582 @@
+#include "clip_recorder.h"
+#include "board_config.h"
+
+#if CLIP_RECORDER
+
+#include "frame_pipeline.h"
+#include "stream_writer.h"
+#include "esp_timer.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp32-hal-psram.h>
+#include "lwip/sockets.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#endif
+
+// Index capacity: the full duration at CLIP_FPS, plus slack for timing jitter
+#define CLIP_MAX_FRAMES (CLIP_SECONDS * CLIP_FPS + CLIP_FPS)
+
+// Accept frames up to one quiet-rate period old so sampling never forces captures
+static const uint32_t CLIP_MAX_FRAME_AGE_MS = 1000 / ADAPTIVE_QUIET_FPS + 1000 / CLIP_FPS;
+
+// RIFF header + hdrl list + movi list header
+#define AVI_HEADER_LEN 224
+#define AVI_HDRL_LEN   192
+#define AVIF_HASINDEX  0x10
+#define AVIIF_KEYFRAME 0x10
+
+typedef struct {
+  uint32_t id;          // Monotonic, never 0
+  size_t offset;        // Position in the arena
+  size_t len;
+  int64_t captured_us;  // Pipeline publish time
+  uint16_t width;
+  uint16_t height;
+} clip_entry_t;
+
+// Frames selected for one export; the arena entries stay pinned until sent
+typedef struct {
+  uint32_t first_id;
+  uint32_t count;
+  uint32_t *lens;       // Copied so the AVI index survives eviction of sent frames
+  uint32_t max_len;
+  int64_t first_us;
+  int64_t last_us;
+  uint16_t width;
+  uint16_t height;
+} clip_snapshot_t;
+
+static TaskHandle_t clip_task = nullptr;
+static SemaphoreHandle_t clip_lock = nullptr;
+
+// Guarded by clip_lock
+static uint8_t *arena = nullptr;
+static size_t arena_size = 0;
+static size_t head = 0;             // Next write position
+static size_t used = 0;
+static clip_entry_t entries[CLIP_MAX_FRAMES];
+static uint32_t tail_id = 1;        // Oldest held frame
+static uint32_t next_id = 1;
+static uint32_t export_floor = 0;   // Oldest frame an export still needs (0 = none)
+static uint32_t skipped = 0;
+
+static clip_entry_t *entry(uint32_t id) {
+  return &entries[id % CLIP_MAX_FRAMES];
+}
+
+// Drop the oldest frame unless an export still has to send it
+static bool evict_tail_locked() {
+  if (tail_id == next_id || (export_floor && tail_id >= export_floor)) {
+    return false;
+  }
+  used -= entry(tail_id)->len;
+  tail_id++;
+  if (tail_id == next_id) {
+    head = 0;
+  }
+  return true;
+}
+
+// Find room for len bytes, evicting from the tail; frames are laid out in
+// allocation order, so the oldest frame always sits right after head
+static bool reserve_locked(size_t len, size_t *offset) {
+  if (len > arena_size) {
+    return false;
+  }
+  if (next_id - tail_id >= CLIP_MAX_FRAMES && !evict_tail_locked()) {
+    return false;
+  }
+
+  size_t pos = head;
+  if (pos + len > arena_size) {
+    // Wrap: frames left in the gap at the end are the oldest ones
+    while (tail_id != next_id && entry(tail_id)->offset >= head) {
+      if (!evict_tail_locked()) {
+        return false;
+      }
+    }
+    pos = 0;
+  }
+  while (tail_id != next_id) {
+    const clip_entry_t *e = entry(tail_id);
+    if (e->offset >= pos + len || e->offset + e->len <= pos) {
+      break;
+    }
+    if (!evict_tail_locked()) {
+      return false;
+    }
+  }
+  *offset = pos;
+  return true;
+}
+
+static void record_frame(const frame_t *frame) {
+  int64_t now = esp_timer_get_time();
+
+  xSemaphoreTake(clip_lock, portMAX_DELAY);
+  // Age out frames beyond the configured duration first
+  while (tail_id != next_id &&
+         now - entry(tail_id)->captured_us > (int64_t)CLIP_SECONDS * 1000000 &&
+         evict_tail_locked()) {
+  }
+
+  size_t offset = 0;
+  if (!reserve_locked(frame->len, &offset)) {
+    skipped++;
+    xSemaphoreGive(clip_lock);
+    return;
+  }
+  // Single copy; the lock keeps an export from reading a half-written slot index
+  memcpy(arena + offset, frame->buf, frame->len);
+  clip_entry_t *e = entry(next_id);
+  e->id = next_id++;
+  e->offset = offset;
+  e->len = frame->len;
+  e->captured_us = frame->published_us;
+  e->width = frame->width;
+  e->height = frame->height;
+  head = offset + frame->len;
+  used += frame->len;
+  xSemaphoreGive(clip_lock);
+}
+
+static void clip_task_fn(void *arg) {
+  (void)arg;
+  uint32_t last_seq = 0;
+  TickType_t wake = xTaskGetTickCount();
+
+  while (true) {
+    frame_t *frame = frame_pipeline_get_latest(CLIP_MAX_FRAME_AGE_MS);
+    if (frame) {
+      if (frame->seq != last_seq) {
+        last_seq = frame->seq;
+        record_frame(frame);
+      }
+      frame_pipeline_release(frame);
+    }
+    vTaskDelayUntil(&wake, pdMS_TO_TICKS(1000 / CLIP_FPS));
+  }
+}
+
+// Select the last `seconds` of frames (0 = all) and pin them for export
+static esp_err_t begin_snapshot(uint32_t seconds, clip_snapshot_t *snap) {
+  memset(snap, 0, sizeof(*snap));
+  xSemaphoreTake(clip_lock, portMAX_DELAY);
+  if (export_floor) {
+    xSemaphoreGive(clip_lock);
+    return ESP_ERR_INVALID_STATE;
+  }
+  uint32_t first = tail_id;
+  if (seconds && next_id != tail_id) {
+    int64_t cutoff = entry(next_id - 1)->captured_us - (int64_t)seconds * 1000000;
+    while (first != next_id && entry(first)->captured_us < cutoff) {
+      first++;
+    }
+  }
+  uint32_t count = next_id - first;
+  uint32_t *lens = count ? (uint32_t *)malloc(count * sizeof(uint32_t)) : nullptr;
+  if (!lens) {
+    xSemaphoreGive(clip_lock);
+    return count ? ESP_ERR_NO_MEM : ESP_ERR_NOT_FOUND;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    const clip_entry_t *e = entry(first + i);
+    lens[i] = e->len;
+    if (e->len > snap->max_len) {
+      snap->max_len = e->len;
+    }
+  }
+  snap->first_id = first;
+  snap->count = count;
+  snap->lens = lens;
+  snap->first_us = entry(first)->captured_us;
+  snap->last_us = entry(next_id - 1)->captured_us;
+  snap->width = entry(first)->width;
+  snap->height = entry(first)->height;
+  export_floor = first;
+  xSemaphoreGive(clip_lock);
+  return ESP_OK;
+}
+
+static void end_snapshot(clip_snapshot_t *snap) {
+  xSemaphoreTake(clip_lock, portMAX_DELAY);
+  export_floor = 0;
+  xSemaphoreGive(clip_lock);
+  free(snap->lens);
+  snap->lens = nullptr;
+}
+
+// Arena address of a pinned frame
+static const uint8_t *pinned_frame(uint32_t id) {
+  xSemaphoreTake(clip_lock, portMAX_DELAY);
+  const uint8_t *data = arena + entry(id)->offset;
+  xSemaphoreGive(clip_lock);
+  return data;
+}
+
+// Release a sent frame back to the recorder
+static void unpin_frame(uint32_t id) {
+  xSemaphoreTake(clip_lock, portMAX_DELAY);
+  export_floor = id + 1;
+  xSemaphoreGive(clip_lock);
+}
+
+static uint32_t frame_interval_us(const clip_snapshot_t *snap) {
+  if (snap->count < 2) {
+    return 1000000 / CLIP_FPS;
+  }
+  return (uint32_t)((snap->last_us - snap->first_us) / (snap->count - 1));
+}
+
+static size_t avi_movi_len(const clip_snapshot_t *snap) {
+  size_t len = 4;
+  for (uint32_t i = 0; i < snap->count; i++) {
+    len += 8 + ((snap->lens[i] + 1) & ~1u);
+  }
+  return len;
+}
+
+static size_t avi_file_len(const clip_snapshot_t *snap) {
+  return 12 + 8 + AVI_HDRL_LEN + 8 + avi_movi_len(snap) + 8 + 16 * snap->count;
+}
+
+static uint8_t *put32(uint8_t *p, uint32_t v) {
+  p[0] = v;
+  p[1] = v >> 8;
+  p[2] = v >> 16;
+  p[3] = v >> 24;
+  return p + 4;
+}
+
+static uint8_t *putfcc(uint8_t *p, const char *fcc) {
+  memcpy(p, fcc, 4);
+  return p + 4;
+}
+
+static void build_avi_header(const clip_snapshot_t *snap, uint8_t *out) {
+  uint32_t interval = frame_interval_us(snap);
+  uint8_t *p = out;
+  p = putfcc(p, "RIFF");
+  p = put32(p, avi_file_len(snap) - 8);
+  p = putfcc(p, "AVI ");
+
+  p = putfcc(p, "LIST");
+  p = put32(p, AVI_HDRL_LEN);
+  p = putfcc(p, "hdrl");
+  p = putfcc(p, "avih");
+  p = put32(p, 56);
+  p = put32(p, interval);
+  p = put32(p, (uint32_t)((uint64_t)snap->max_len * 1000000 / (interval ? interval : 1)));
+  p = put32(p, 0);
+  p = put32(p, AVIF_HASINDEX);
+  p = put32(p, snap->count);
+  p = put32(p, 0);
+  p = put32(p, 1);
+  p = put32(p, snap->max_len);
+  p = put32(p, snap->width);
+  p = put32(p, snap->height);
+  for (int i = 0; i < 4; i++) {
+    p = put32(p, 0);
+  }
+
+  p = putfcc(p, "LIST");
+  p = put32(p, 4 + 8 + 56 + 8 + 40);
+  p = putfcc(p, "strl");
+  p = putfcc(p, "strh");
+  p = put32(p, 56);
+  p = putfcc(p, "vids");
+  p = putfcc(p, "MJPG");
+  p = put32(p, 0);             // Flags
+  p = put32(p, 0);             // Priority, language
+  p = put32(p, 0);             // Initial frames
+  p = put32(p, interval);      // Scale / rate = seconds per frame
+  p = put32(p, 1000000);
+  p = put32(p, 0);             // Start
+  p = put32(p, snap->count);   // Length in frames
+  p = put32(p, snap->max_len);
+  p = put32(p, 0xFFFFFFFF);    // Default quality
+  p = put32(p, 0);             // Sample size (varies)
+  p = put32(p, 0);             // rcFrame left, top
+  p = put32(p, ((uint32_t)snap->height << 16) | snap->width);
+
+  p = putfcc(p, "strf");
+  p = put32(p, 40);
+  p = put32(p, 40);            // BITMAPINFOHEADER
+  p = put32(p, snap->width);
+  p = put32(p, snap->height);
+  p = put32(p, (24u << 16) | 1); // Planes, bit count
+  p = putfcc(p, "MJPG");
+  p = put32(p, (uint32_t)snap->width * snap->height * 3);
+  for (int i = 0; i < 4; i++) {
+    p = put32(p, 0);
+  }
+
+  p = putfcc(p, "LIST");
+  p = put32(p, avi_movi_len(snap));
+  p = putfcc(p, "movi");
+}
+
+// Frame chunks and index; the AVI header has already gone out
+static esp_err_t send_avi(stream_writer_t *w, clip_snapshot_t *snap) {
+  esp_err_t res = ESP_OK;
+  static const uint8_t pad = 0;
+  for (uint32_t i = 0; i < snap->count && res == ESP_OK; i++) {
+    uint32_t id = snap->first_id + i;
+    uint8_t chunk[8];
+    put32(putfcc(chunk, "00dc"), snap->lens[i]);
+    res = stream_writer_send(w, chunk, sizeof(chunk));
+    if (res == ESP_OK) {
+      res = stream_writer_send(w, pinned_frame(id), snap->lens[i]);
+    }
+    if (res == ESP_OK && (snap->lens[i] & 1)) {
+      res = stream_writer_send(w, &pad, 1);
+    }
+    unpin_frame(id);
+  }
+
+  // Legacy index: offsets are relative to the "movi" fourcc
+  if (res == ESP_OK) {
+    uint8_t chunk[8];
+    put32(putfcc(chunk, "idx1"), 16 * snap->count);
+    res = stream_writer_send(w, chunk, sizeof(chunk));
+  }
+  uint32_t offset = 4;
+  for (uint32_t i = 0; i < snap->count && res == ESP_OK;) {
+    uint8_t idx[16 * 16];
+    uint8_t *p = idx;
+    for (int n = 0; n < 16 && i < snap->count; n++, i++) {
+      p = putfcc(p, "00dc");
+      p = put32(p, AVIIF_KEYFRAME);
+      p = put32(p, offset);
+      p = put32(p, snap->lens[i]);
+      offset += 8 + ((snap->lens[i] + 1) & ~1u);
+    }
+    res = stream_writer_send(w, idx, p - idx);
+  }
+  return res;
+}
+
+// Multipart replay, paced by the recorded frame times; the opening boundary
+// has already gone out
+static esp_err_t send_mjpeg(stream_writer_t *w, clip_snapshot_t *snap) {
+  esp_err_t res = ESP_OK;
+  int64_t start = esp_timer_get_time();
+  for (uint32_t i = 0; i < snap->count && res == ESP_OK; i++) {
+    uint32_t id = snap->first_id + i;
+    frame_t part = {};
+    xSemaphoreTake(clip_lock, portMAX_DELAY);
+    const clip_entry_t *e = entry(id);
+    part.buf = arena + e->offset;
+    part.len = e->len;
+    int64_t offset_us = e->captured_us - snap->first_us;
+    xSemaphoreGive(clip_lock);
+    part.timestamp.tv_sec = offset_us / 1000000;
+    part.timestamp.tv_usec = offset_us % 1000000;
+    int64_t due = start + offset_us;
+
+    int64_t wait_us = due - esp_timer_get_time();
+    if (wait_us > 1000) {
+      vTaskDelay(pdMS_TO_TICKS(wait_us / 1000));
+    }
+    res = stream_writer_send_part(w, &part);
+    unpin_frame(id);
+  }
+  return res;
+}
+
+static const char *_AVI_HEADERS =
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: video/x-msvideo\r\n"
+  "Content-Length: %u\r\n"
+  "Content-Disposition: attachment; filename=\"clip.avi\"\r\n"
+  "Access-Control-Allow-Origin: *\r\n"
+  "Connection: close\r\n"
+  "\r\n";
+
+static const char *_MJPEG_HEADERS =
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: " STREAM_CONTENT_TYPE "\r\n"
+  "Access-Control-Allow-Origin: *\r\n"
+  "Cache-Control: no-store\r\n"
+  "Connection: close\r\n"
+  "\r\n";
+
+typedef struct {
+  httpd_req_t *req;
+  bool avi;
+  clip_snapshot_t snap;
+  uint8_t intro[AVI_HEADER_LEN]; // AVI header, or the multipart opening boundary
+  size_t intro_len;
+} clip_job_t;
+
+static void build_intro(clip_job_t *job) {
+  if (job->avi) {
+    build_avi_header(&job->snap, job->intro);
+    job->intro_len = AVI_HEADER_LEN;
+  } else {
+    const char *preamble = stream_writer_preamble(&job->intro_len);
+    memcpy(job->intro, preamble, job->intro_len);
+  }
+}
+
+static esp_err_t send_body(stream_writer_t *w, clip_job_t *job) {
+  return job->avi ? send_avi(w, &job->snap) : send_mjpeg(w, &job->snap);
+}
+
+#if STREAM_RAW_SOCKET
+// Export task: owns the socket like a raw stream session, so a 30 s replay
+// never holds up the httpd worker
+static void clip_sender_task(void *arg) {
+  clip_job_t *job = (clip_job_t *)arg;
+  httpd_handle_t hd = job->req->handle;
+  int fd = httpd_req_to_sockfd(job->req);
+
+  stream_writer_t writer;
+  stream_writer_init(&writer, fd, false);
+
+  char header[256];
+  int len = job->avi ? snprintf(header, sizeof(header), _AVI_HEADERS,
+                                (unsigned)avi_file_len(&job->snap))
+                     : snprintf(header, sizeof(header), "%s", _MJPEG_HEADERS);
+  struct iovec iov[2] = {
+    {header, (size_t)len},
+    {job->intro, job->intro_len},
+  };
+  esp_err_t res = writev(fd, iov, 2) > 0 ? send_body(&writer, job) : ESP_FAIL;
+  log_i("Clip export of %u frames %s", (unsigned)job->snap.count,
+        res == ESP_OK ? "complete" : "aborted");
+
+  end_snapshot(&job->snap);
+  httpd_req_async_handler_complete(job->req);
+  httpd_sess_trigger_close(hd, fd);
+  free(job);
+  vTaskDelete(NULL);
+}
+#endif
+
+// Fallback: export on the httpd worker with chunked framing
+static esp_err_t export_on_worker(httpd_req_t *req, clip_job_t *job) {
+  httpd_resp_set_type(req, job->avi ? "video/x-msvideo" : STREAM_CONTENT_TYPE);
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+  if (job->avi) {
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"clip.avi\"");
+  }
+
+  // The first chunk flushes the response headers; the body then goes out as
+  // raw chunks straight from the arena
+  esp_err_t res = httpd_resp_send_chunk(req, (const char *)job->intro, job->intro_len);
+  stream_writer_t writer;
+  stream_writer_init(&writer, httpd_req_to_sockfd(req), true);
+  if (res == ESP_OK) {
+    res = send_body(&writer, job);
+  }
+  end_snapshot(&job->snap);
+  free(job);
+  return res == ESP_OK ? httpd_resp_send_chunk(req, NULL, 0) : res;
+}
+
+esp_err_t clip_handler(httpd_req_t *req) {
+  if (!clip_task) {
+    httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "Clip recorder needs PSRAM");
+    return ESP_FAIL;
+  }
+
+  uint32_t seconds = 0;
+  bool avi = true;
+  char query[48];
+  char value[12];
+  if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+    if (httpd_query_key_value(query, "seconds", value, sizeof(value)) == ESP_OK) {
+      seconds = strtoul(value, nullptr, 10);
+    }
+    if (httpd_query_key_value(query, "format", value, sizeof(value)) == ESP_OK) {
+      avi = strcmp(value, "mjpeg") != 0;
+    }
+  }
+
+  clip_job_t *job = (clip_job_t *)calloc(1, sizeof(clip_job_t));
+  if (!job) {
+    return httpd_resp_send_500(req);
+  }
+  job->avi = avi;
+  esp_err_t err = begin_snapshot(seconds, &job->snap);
+  if (err == ESP_OK) {
+    build_intro(job);
+  } else {
+    free(job);
+    if (err == ESP_ERR_INVALID_STATE) {
+      httpd_resp_set_status(req, "503 Service Unavailable");
+      return httpd_resp_sendstr(req, "Clip export already in progress");
+    }
+    httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "No frames recorded");
+    return ESP_FAIL;
+  }
+
+#if STREAM_RAW_SOCKET
+  if (httpd_req_async_handler_begin(req, &job->req) == ESP_OK) {
+    if (xTaskCreatePinnedToCore(clip_sender_task, "clip_tx", STREAM_SENDER_STACK, job,
+                                CLIP_TASK_PRIORITY, NULL, HTTPD_TASK_CORE) == pdPASS) {
+      return ESP_OK;
+    }
+    log_e("Failed to create clip sender task");
+    httpd_req_async_handler_complete(job->req);
+  }
+#endif
+  return export_on_worker(req, job);
+}
+
+bool clip_recorder_start() {
+  if (clip_task != nullptr) {
+    return true;
+  }
+  if (!psramFound()) {
+    log_w("No PSRAM: clip recorder disabled");
+    return false;
+  }
+
+  clip_lock = xSemaphoreCreateMutex();
+  arena_size = (size_t)CLIP_BUFFER_KB * 1024;
+  arena = (uint8_t *)ps_malloc(arena_size);
+  if (!clip_lock || !arena) {
+    log_e("Failed to allocate %u KB clip buffer", CLIP_BUFFER_KB);
+    free(arena);
+    arena = nullptr;
+    return false;
+  }
+
+  if (xTaskCreatePinnedToCore(clip_task_fn, "cam_clip", CLIP_TASK_STACK, nullptr,
+                              CLIP_TASK_PRIORITY, &clip_task, HTTPD_TASK_CORE) != pdPASS) {
+    log_e("Failed to create clip task");
+    clip_task = nullptr;
+    return false;
+  }
+  log_i("Clip recorder: %ds at %d FPS in %u KB PSRAM", CLIP_SECONDS, CLIP_FPS, CLIP_BUFFER_KB);
+  return true;
+}
+
+void clip_get_status(clip_status_t *status) {
+  memset(status, 0, sizeof(*status));
+  if (!clip_task) {
+    return;
+  }
+  xSemaphoreTake(clip_lock, portMAX_DELAY);
+  status->running = true;
+  status->frames = next_id - tail_id;
+  status->bytes = used;
+  status->capacity = arena_size;
+  if (status->frames) {
+    status->span_ms =
+        (uint32_t)((entry(next_id - 1)->captured_us - entry(tail_id)->captured_us) / 1000);
+  }
+  status->skipped = skipped;
+  xSemaphoreGive(clip_lock);
+}
+
+#endif  // CLIP_RECORDER
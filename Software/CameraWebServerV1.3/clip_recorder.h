@@ -0,0 +1,37 @@
+#ifndef CLIP_RECORDER_H
+#define CLIP_RECORDER_H
+
+#include "esp_http_server.h"
+#include <stdint.h>
+#include <stddef.h>
+
+//
+// Pre-event clip recorder
+//
+// A low-priority task samples the pipeline's latest-frame cache at CLIP_FPS
+// and copies each new JPEG once into a circular PSRAM arena, evicting frames
+// older than CLIP_SECONDS or whatever no longer fits in CLIP_BUFFER_KB.
+//
+// GET /clip[?seconds=N&format=avi|mjpeg]
+//
+// Exports the most recent N seconds (default: everything held) as an AVI
+// download (MJPEG video, with index) or as a multipart stream replayed at the
+// recorded pace. Frames are sent straight from the arena: an export pins the
+// frames it has not sent yet, so the recorder skips incoming frames rather than
+// overwrite them, and live capture is never paused.
+//
+
+typedef struct {
+  bool running;
+  uint32_t frames;     // Frames currently held
+  size_t bytes;        // Arena bytes in use
+  size_t capacity;
+  uint32_t span_ms;    // Oldest to newest held frame
+  uint32_t skipped;    // Frames not recorded because an export pinned the arena
+} clip_status_t;
+
+bool clip_recorder_start();
+void clip_get_status(clip_status_t *status);
+esp_err_t clip_handler(httpd_req_t *req);
+
+#endif  // CLIP_RECORDER_H
@@ -0,0 +1,740 @@
+#include "frame_pipeline.h"
+#include "jpeg_encoder.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "metrics.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <freertos/event_groups.h>
+#include <esp32-hal-psram.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#endif
+
+static const uint32_t CAPTURE_RETRY_DELAY_MS = 50;
+
+// Ring slots grow in steps of this size so a few larger frames don't cause churn
+static const size_t SLOT_GROW_STEP = 16 * 1024;
+
+// Quality used when the sensor delivers raw pixels
+static const uint8_t CONVERT_JPEG_QUALITY = 80;
+
+// Output size to pre-reserve when encoding raw frames: 1 byte/pixel comfortably
+// covers quality-80 JPEGs (typically 0.2-0.5 bytes/pixel)
+#define JPEG_SLOT_ESTIMATE(w, h) ((size_t)(w) * (h))
+
+#define FRAME_POOL_SIZE FRAME_RING_SLOTS
+
+static frame_t frame_pool[FRAME_POOL_SIZE];
+static bool use_ring = false; // Copy into PSRAM slots (true) or share driver buffers
+
+static frame_t *latest_frame[FRAME_PROFILE_COUNT];
+static uint32_t next_seq = 1;
+static uint32_t error_count = 0;
+static int64_t last_demand_us = 0; // Last latest-frame cache lookup
+static uint8_t suspend_count = 0;      // Outstanding suspends, guarded by pipeline_lock
+static jpeg_encoder_t capture_encoder; // Raw sensor formats only, capture task owned
+static volatile bool suspended = false;
+
+// Adaptive rate: millisecond timestamp (wrapping) of the last scene change, so
+// it can be updated from any task with a plain 32-bit store
+static volatile bool adaptive_enabled = ADAPTIVE_FPS_DEFAULT;
+static volatile uint32_t last_change_ms = 0;
+static volatile bool quiet = false;
+static size_t last_jpeg_len = 0;
+
+// Frames still to be thrown away after a sensor reconfiguration
+static volatile uint8_t flush_discard = 0;
+
+// Per-subscriber send queue: up to STREAM_CLIENT_QUEUE_DEPTH referenced frames,
+// oldest first. When a client falls behind the oldest entry is dropped (latest wins).
+typedef struct {
+  bool used;
+  frame_profile_t profile;
+  uint8_t count;
+  frame_t *queue[STREAM_CLIENT_QUEUE_DEPTH];
+  uint32_t dropped;
+} subscriber_t;
+
+// Subscriber bookkeeping: one event bit per subscriber slot
+static subscriber_t subscribers[FRAME_PIPELINE_MAX_SUBSCRIBERS];
+static uint8_t profile_subscribers[FRAME_PROFILE_COUNT];
+
+static SemaphoreHandle_t pipeline_lock = nullptr;
+static SemaphoreHandle_t sensor_lock = nullptr;
+static EventGroupHandle_t frame_events = nullptr;
+static TaskHandle_t capture_task = nullptr;
+static TaskHandle_t producers[FRAME_PROFILE_COUNT]; // Woken when a profile gains subscribers
+
+// Event bits of every subscriber of a profile (FRAME_PROFILE_COUNT = all)
+static EventBits_t subscriber_bits(int profile) {
+  EventBits_t bits = 0;
+  for (int i = 0; i < FRAME_PIPELINE_MAX_SUBSCRIBERS; i++) {
+    if (subscribers[i].used && (profile == FRAME_PROFILE_COUNT || subscribers[i].profile == profile)) {
+      bits |= (1 << i);
+    }
+  }
+  return bits;
+}
+
+// Drop one reference; must be called with pipeline_lock held.
+// Returns the frame if that was the last reference and it needs freeing.
+static frame_t *unref_locked(frame_t *frame) {
+  if (frame == nullptr || frame->refs == 0) {
+    return nullptr;
+  }
+  frame->refs--;
+  return (frame->refs == 0) ? frame : nullptr;
+}
+
+// Make an unreferenced frame reusable. Ring storage is kept for the next frame;
+// a held driver buffer is handed back. Runs outside the lock; the slot becomes
+// available again once seq is cleared.
+static void recycle_frame(frame_t *frame) {
+  if (frame == nullptr) {
+    return;
+  }
+  if (frame->fb) {
+    esp_camera_fb_return(frame->fb);
+    frame->fb = nullptr;
+  }
+  frame->buf = frame->storage;
+  frame->len = 0;
+
+  xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+  frame->seq = 0;
+  xSemaphoreGive(pipeline_lock);
+}
+
+// Remove the oldest queued frame from a subscriber; returns it if it needs recycling
+static frame_t *dequeue_oldest_locked(subscriber_t *sub) {
+  frame_t *oldest = sub->queue[0];
+  for (int i = 1; i < sub->count; i++) {
+    sub->queue[i - 1] = sub->queue[i];
+  }
+  sub->count--;
+  return oldest;
+}
+
+// Append a frame to every subscriber's queue, dropping the oldest entry of
+// clients that are still behind. Frames that lose their last reference are
+// written to stale[] for recycling outside the lock; returns how many.
+static int enqueue_all_locked(frame_t *frame, frame_profile_t profile, frame_t **stale) {
+  int n = 0;
+  for (int i = 0; i < FRAME_PIPELINE_MAX_SUBSCRIBERS; i++) {
+    subscriber_t *sub = &subscribers[i];
+    if (!sub->used || sub->profile != profile) {
+      continue;
+    }
+    if (sub->count == STREAM_CLIENT_QUEUE_DEPTH) {
+      frame_t *dropped = unref_locked(dequeue_oldest_locked(sub));
+      sub->dropped++;
+      metrics_inc(METRIC_FRAMES_DROPPED);
+      if (dropped) {
+        stale[n++] = dropped;
+      }
+    }
+    frame->refs++;
+    sub->queue[sub->count++] = frame;
+  }
+  return n;
+}
+
+// Ring exhausted: drop queued (not yet sending) frames so the slot can be reused.
+// Anything still queued is older than the frame about to be captured.
+static bool reclaim_queued() {
+  frame_t *stale[FRAME_PIPELINE_MAX_SUBSCRIBERS];
+  int n = 0;
+
+  xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+  for (int i = 0; i < FRAME_PIPELINE_MAX_SUBSCRIBERS; i++) {
+    subscriber_t *sub = &subscribers[i];
+    if (sub->used && sub->count > 0) {
+      frame_t *dropped = unref_locked(dequeue_oldest_locked(sub));
+      sub->dropped++;
+      metrics_inc(METRIC_FRAMES_DROPPED);
+      if (dropped) {
+        stale[n++] = dropped;
+      }
+    }
+  }
+  xSemaphoreGive(pipeline_lock);
+
+  for (int i = 0; i < n; i++) {
+    recycle_frame(stale[i]);
+  }
+  return n > 0;
+}
+
+// Empty every subscriber queue in one pass. A frame still being transmitted by
+// another sender keeps its reference, so nothing is recycled for it, but no
+// subscriber is left holding a frame from before the reconfiguration. Counted
+// as flushed, not dropped: no client fell behind.
+static void flush_queued() {
+  frame_t *stale[FRAME_POOL_SIZE];
+  int n = 0;
+
+  xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+  for (int i = 0; i < FRAME_PIPELINE_MAX_SUBSCRIBERS; i++) {
+    subscriber_t *sub = &subscribers[i];
+    while (sub->used && sub->count > 0) {
+      frame_t *dropped = unref_locked(dequeue_oldest_locked(sub));
+      metrics_inc(METRIC_FRAMES_FLUSHED);
+      if (dropped) {
+        stale[n++] = dropped;
+      }
+    }
+  }
+  xSemaphoreGive(pipeline_lock);
+
+  for (int i = 0; i < n; i++) {
+    recycle_frame(stale[i]);
+  }
+}
+
+static frame_t *alloc_frame_locked() {
+  for (int i = 0; i < FRAME_POOL_SIZE; i++) {
+    if (frame_pool[i].refs == 0 && frame_pool[i].seq == 0) {
+      return &frame_pool[i];
+    }
+  }
+  return nullptr;
+}
+
+// Ensure a ring slot can hold len bytes (grows in SLOT_GROW_STEP increments)
+static bool reserve_slot(frame_t *frame, size_t len) {
+  if (frame->capacity >= len) {
+    return true;
+  }
+  size_t capacity = ((len + SLOT_GROW_STEP - 1) / SLOT_GROW_STEP) * SLOT_GROW_STEP;
+  uint32_t caps = use_ring ? (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT) : MALLOC_CAP_8BIT;
+  uint8_t *buf = (uint8_t *)heap_caps_realloc(frame->storage, capacity, caps);
+  if (!buf) {
+    log_e("Frame ring: failed to grow slot to %u bytes", (unsigned)capacity);
+    return false;
+  }
+  frame->storage = buf;
+  frame->buf = buf;
+  frame->capacity = capacity;
+  return true;
+}
+
+// Copy a JPEG into the frame's ring slot
+static bool store_jpeg(frame_t *frame, const uint8_t *data, size_t len) {
+  if (!reserve_slot(frame, len)) {
+    return false;
+  }
+  memcpy(frame->storage, data, len);
+  frame->buf = frame->storage;
+  frame->len = len;
+  return true;
+}
+
+// Encode raw pixels into a slot without any intermediate heap buffer. Slots are
+// pre-sized for the current resolution so steady-state conversion never allocates;
+// a frame that still doesn't fit grows the slot once and is encoded again.
+static bool encode_into_slot(jpeg_encoder_t *enc, frame_t *frame, const uint8_t *src,
+                             size_t src_len, uint16_t width, uint16_t height, pixformat_t format,
+                             uint8_t quality) {
+  size_t need = JPEG_SLOT_ESTIMATE(width, height);
+  for (int attempt = 0; attempt < 2; attempt++) {
+    if (!reserve_slot(frame, need)) {
+      return false;
+    }
+    frame->buf = frame->storage;
+    esp_err_t err = jpeg_encoder_encode(enc, src, src_len, width, height, format, quality,
+                                        frame->storage, frame->capacity, &frame->len);
+    if (err != ESP_ERR_NO_MEM) {
+      return err == ESP_OK;
+    }
+    need = frame->capacity * 2;
+  }
+  return false;
+}
+
+// Publish a filled slot: the pipeline keeps one reference as the profile's
+// "latest", and every subscriber of that profile queues one
+static void publish_frame(frame_t *frame, frame_profile_t profile) {
+  frame_t *dropped[FRAME_PIPELINE_MAX_SUBSCRIBERS + 1];
+
+  xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+  frame->seq = next_seq++;
+  if (next_seq == 0) {
+    next_seq = 1;
+  }
+  frame->refs = 1;
+  frame->profile = profile;
+  frame->published_us = esp_timer_get_time();
+  frame_t *previous = latest_frame[profile];
+  latest_frame[profile] = frame;
+  int n = enqueue_all_locked(frame, profile, dropped);
+  frame_t *stale = unref_locked(previous);
+  if (stale) {
+    dropped[n++] = stale;
+  }
+  EventBits_t wake = subscriber_bits(profile);
+  xSemaphoreGive(pipeline_lock);
+
+  for (int i = 0; i < n; i++) {
+    recycle_frame(dropped[i]);
+  }
+  xEventGroupSetBits(frame_events, wake);
+}
+
+// Give back a reserved slot that was never published
+static void discard_slot(frame_t *frame) {
+  xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+  frame->seq = 0;
+  xSemaphoreGive(pipeline_lock);
+}
+
+// Grab one frame from the sensor into a slot (converting to JPEG if needed).
+// The driver buffer is returned before this function exits unless the ring is disabled.
+static bool capture_one(frame_t *frame) {
+  int64_t wait_start = esp_timer_get_time();
+  camera_fb_t *fb = esp_camera_fb_get();
+  metrics_observe(METRIC_HIST_CAPTURE_WAIT_US, (uint32_t)(esp_timer_get_time() - wait_start));
+  if (!fb) {
+    return false;
+  }
+
+  frame->timestamp = fb->timestamp;
+  frame->width = fb->width;
+  frame->height = fb->height;
+
+  if (fb->format == PIXFORMAT_JPEG) {
+    if (!use_ring) {
+      // No PSRAM: share the driver buffer until the last subscriber is done
+      frame->fb = fb;
+      frame->buf = fb->buf;
+      frame->len = fb->len;
+      return true;
+    }
+    bool stored = store_jpeg(frame, fb->buf, fb->len);
+    esp_camera_fb_return(fb);
+    return stored;
+  }
+
+  // Convert once here, directly into the pooled slot, so every subscriber shares
+  // the same JPEG and the hot path never touches the heap
+  bool converted = encode_into_slot(&capture_encoder, frame, fb->buf, fb->len, fb->width, fb->height, fb->format,
+                                    CONVERT_JPEG_QUALITY);
+  esp_camera_fb_return(fb);
+
+  if (!converted) {
+    log_e("JPEG compression failed");
+  }
+  return converted;
+}
+
+static uint32_t now_ms() {
+  return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+// Cheap change detector: the JPEG size of a static scene barely moves, while
+// changed content shifts it by several percent
+static void note_frame_size(size_t len) {
+  size_t prev = last_jpeg_len;
+  size_t delta = len > prev ? len - prev : prev - len;
+  if (prev == 0 || delta * 1000 > prev * ADAPTIVE_CHANGE_PERMILLE) {
+    last_change_ms = now_ms();
+  }
+  last_jpeg_len = len;
+}
+
+// Decide whether the capture task should drop to the quiet rate
+static bool update_quiet() {
+  bool now_quiet = adaptive_enabled && (now_ms() - last_change_ms) > ADAPTIVE_QUIET_AFTER_MS;
+  if (now_quiet != quiet) {
+    quiet = now_quiet;
+    log_i("Scene %s: capture at %s rate", quiet ? "static" : "changed", quiet ? "quiet" : "full");
+  }
+  return quiet;
+}
+
+static void capture_task_fn(void *arg) {
+  (void)arg;
+
+  while (true) {
+    // Sleep until someone wants frames
+    xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+    bool lingering = (esp_timer_get_time() - last_demand_us) < (int64_t)FRAME_CACHE_LINGER_MS * 1000;
+    bool parked = suspend_count > 0;
+    bool idle = ((profile_subscribers[FRAME_PROFILE_FULL] == 0) && !lingering) || parked;
+    frame_t *stale = nullptr;
+    if (idle && latest_frame[FRAME_PROFILE_FULL]) {
+      // Nobody is watching or polling: give the held buffer back to the driver
+      stale = unref_locked(latest_frame[FRAME_PROFILE_FULL]);
+      latest_frame[FRAME_PROFILE_FULL] = nullptr;
+    }
+    frame_t *frame = idle ? nullptr : alloc_frame_locked();
+    if (frame) {
+      frame->seq = next_seq; // Reserve the slot
+    }
+    xSemaphoreGive(pipeline_lock);
+    recycle_frame(stale);
+
+    if (idle) {
+      suspended = parked;
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      suspended = false;
+      last_change_ms = now_ms(); // Start each capture session at full rate
+      continue;
+    }
+
+    if (!frame) {
+      // All ring slots are held; free queued frames first, else wait for a sender
+      if (!reclaim_queued()) {
+        vTaskDelay(CAPTURE_RETRY_DELAY_MS / portTICK_PERIOD_MS);
+      }
+      continue;
+    }
+
+    if (!capture_one(frame)) {
+      error_count++;
+      metrics_inc(METRIC_CAPTURE_ERRORS);
+      log_e("Camera capture failed (error count: %u)", error_count);
+      discard_slot(frame);
+      // Wake subscribers so they can observe the error count
+      xEventGroupSetBits(frame_events, subscriber_bits(FRAME_PROFILE_COUNT));
+      vTaskDelay(CAPTURE_RETRY_DELAY_MS / portTICK_PERIOD_MS);
+      continue;
+    }
+    if (error_count > 0) {
+      metrics_inc(METRIC_CAPTURE_RECOVERED);
+      error_count = 0;
+    }
+    if (flush_discard > 0) {
+      // Sensor still settling after a reconfiguration
+      flush_discard--;
+      metrics_inc(METRIC_FRAMES_FLUSHED);
+      recycle_frame(frame);
+      continue;
+    }
+    metrics_inc(METRIC_FRAMES_CAPTURED);
+    metrics_observe(METRIC_HIST_JPEG_BYTES, frame->len);
+    note_frame_size(frame->len);
+
+    int64_t captured_us = esp_timer_get_time();
+    publish_frame(frame, FRAME_PROFILE_FULL);
+
+    if (update_quiet()) {
+      // Static scene: hold off until the next quiet-rate frame is due. A new
+      // subscriber, a cache miss or detected motion cuts the wait short.
+      int64_t remaining_us = 1000000 / ADAPTIVE_QUIET_FPS - (esp_timer_get_time() - captured_us);
+      if (remaining_us > 0) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(remaining_us / 1000));
+      }
+    }
+  }
+}
+
+bool frame_pipeline_start() {
+  if (capture_task != nullptr) {
+    return true;
+  }
+
+  pipeline_lock = xSemaphoreCreateMutex();
+  sensor_lock = xSemaphoreCreateMutex();
+  frame_events = xEventGroupCreate();
+  if (!pipeline_lock || !sensor_lock || !frame_events) {
+    log_e("Failed to create frame pipeline sync objects");
+    return false;
+  }
+
+  memset(frame_pool, 0, sizeof(frame_pool));
+  memset(subscribers, 0, sizeof(subscribers));
+  memset(latest_frame, 0, sizeof(latest_frame));
+  memset(profile_subscribers, 0, sizeof(profile_subscribers));
+  use_ring = psramFound();
+  jpeg_encoder_init(&capture_encoder, JPEG_BACKEND_DEFAULT);
+
+  if (xTaskCreatePinnedToCore(capture_task_fn, "cam_capture", CAPTURE_TASK_STACK, nullptr,
+                              CAPTURE_TASK_PRIORITY, &capture_task, CAPTURE_TASK_CORE) != pdPASS) {
+    log_e("Failed to create capture task");
+    capture_task = nullptr;
+    return false;
+  }
+
+  log_i("Frame pipeline started (core %d, %d %s slots, %s raw encoder)", CAPTURE_TASK_CORE,
+        FRAME_POOL_SIZE, use_ring ? "PSRAM ring" : "shared driver",
+        jpeg_encoder_backend_name(capture_encoder.backend));
+  return true;
+}
+
+int frame_pipeline_subscribe(frame_profile_t profile) {
+  if (!pipeline_lock) {
+    return -1;
+  }
+
+  int id = -1;
+  xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+  for (int i = 0; i < FRAME_PIPELINE_MAX_SUBSCRIBERS; i++) {
+    if (!subscribers[i].used) {
+      memset(&subscribers[i], 0, sizeof(subscribers[i]));
+      subscribers[i].used = true;
+      subscribers[i].profile = profile;
+      profile_subscribers[profile]++;
+      id = i;
+      break;
+    }
+  }
+  xSemaphoreGive(pipeline_lock);
+
+  if (id < 0) {
+    log_w("Frame pipeline full (%d subscribers)", FRAME_PIPELINE_MAX_SUBSCRIBERS);
+    return -1;
+  }
+
+  xEventGroupClearBits(frame_events, (1 << id));
+  TaskHandle_t producer = (profile == FRAME_PROFILE_FULL) ? capture_task : producers[profile];
+  if (producer) {
+    xTaskNotifyGive(producer);
+  }
+  return id;
+}
+
+void frame_pipeline_unsubscribe(int id) {
+  if (id < 0 || id >= FRAME_PIPELINE_MAX_SUBSCRIBERS) {
+    return;
+  }
+
+  frame_t *stale[STREAM_CLIENT_QUEUE_DEPTH + 1];
+  int n = 0;
+
+  xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+  subscriber_t *sub = &subscribers[id];
+  if (sub->used) {
+    while (sub->count > 0) {
+      frame_t *frame = unref_locked(dequeue_oldest_locked(sub));
+      if (frame) {
+        stale[n++] = frame;
+      }
+    }
+    sub->used = false;
+    frame_profile_t profile = sub->profile;
+    if (--profile_subscribers[profile] == 0 && profile != FRAME_PROFILE_FULL) {
+      // Derived profiles have no cache; free the slot held as their latest frame
+      frame_t *frame = unref_locked(latest_frame[profile]);
+      latest_frame[profile] = nullptr;
+      if (frame) {
+        stale[n++] = frame;
+      }
+    }
+  }
+  xSemaphoreGive(pipeline_lock);
+
+  for (int i = 0; i < n; i++) {
+    recycle_frame(stale[i]);
+  }
+}
+
+frame_t *frame_pipeline_wait(int id, uint32_t timeout_ms) {
+  if (id < 0 || id >= FRAME_PIPELINE_MAX_SUBSCRIBERS) {
+    return nullptr;
+  }
+
+  TickType_t start = xTaskGetTickCount();
+  TickType_t timeout = timeout_ms / portTICK_PERIOD_MS;
+  bool waited = false;
+
+  while (true) {
+    // Take the oldest queued frame; its queue reference passes to the caller
+    xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+    subscriber_t *sub = &subscribers[id];
+    frame_t *frame = (sub->used && sub->count > 0) ? dequeue_oldest_locked(sub) : nullptr;
+    xSemaphoreGive(pipeline_lock);
+
+    if (frame) {
+      return frame;
+    }
+
+    TickType_t elapsed = xTaskGetTickCount() - start;
+    if (elapsed >= timeout || (waited && error_count > 0)) {
+      // Timed out, or woken by a failed capture: let the caller decide
+      return nullptr;
+    }
+
+    xEventGroupWaitBits(frame_events, (1 << id), pdTRUE, pdFALSE, timeout - elapsed);
+    waited = true;
+  }
+}
+
+void frame_pipeline_release(frame_t *frame) {
+  if (frame == nullptr) {
+    return;
+  }
+
+  xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+  frame_t *stale = unref_locked(frame);
+  xSemaphoreGive(pipeline_lock);
+
+  recycle_frame(stale);
+}
+
+frame_t *frame_pipeline_get_latest(uint32_t max_age_ms) {
+  if (!pipeline_lock) {
+    return nullptr;
+  }
+
+  int64_t now = esp_timer_get_time();
+  xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+  last_demand_us = now;
+  frame_t *frame = latest_frame[FRAME_PROFILE_FULL];
+  if (frame && (now - frame->published_us) <= (int64_t)max_age_ms * 1000) {
+    frame->refs++;
+  } else {
+    frame = nullptr;
+  }
+  xSemaphoreGive(pipeline_lock);
+
+  // A miss means the capture task is parked or running at the quiet rate:
+  // wake it so the cache is refilled right away
+  if (!frame) {
+    xTaskNotifyGive(capture_task);
+  }
+  return frame;
+}
+
+bool frame_pipeline_suspend(uint32_t timeout_ms) {
+  if (!capture_task) {
+    return true;
+  }
+
+  xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+  suspend_count++;
+  xSemaphoreGive(pipeline_lock);
+  xTaskNotifyGive(capture_task);
+
+  TickType_t start = xTaskGetTickCount();
+  while (!suspended) {
+    if (xTaskGetTickCount() - start >= timeout_ms / portTICK_PERIOD_MS) {
+      // Withdraw only this request; other holders keep capture parked
+      frame_pipeline_resume();
+      return false;
+    }
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
+  return true;
+}
+
+void frame_pipeline_resume() {
+  if (!capture_task) {
+    return;
+  }
+  xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+  bool release = suspend_count > 0 && --suspend_count == 0;
+  xSemaphoreGive(pipeline_lock);
+  if (release) {
+    xTaskNotifyGive(capture_task);
+  }
+}
+
+bool frame_pipeline_suspended() {
+  if (!capture_task) {
+    return false;
+  }
+  xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+  bool parked = suspend_count > 0;
+  xSemaphoreGive(pipeline_lock);
+  return parked;
+}
+
+bool frame_pipeline_sensor_lock(uint32_t timeout_ms) {
+  if (!sensor_lock) {
+    return true;
+  }
+  TickType_t wait = timeout_ms == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+  return xSemaphoreTake(sensor_lock, wait) == pdTRUE;
+}
+
+void frame_pipeline_sensor_unlock() {
+  if (sensor_lock) {
+    xSemaphoreGive(sensor_lock);
+  }
+}
+
+void frame_pipeline_flush(uint8_t discard) {
+  flush_discard = discard;
+  last_change_ms = now_ms();
+
+  xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+  frame_t *stale = unref_locked(latest_frame[FRAME_PROFILE_FULL]);
+  latest_frame[FRAME_PROFILE_FULL] = nullptr;
+  xSemaphoreGive(pipeline_lock);
+  recycle_frame(stale);
+
+  flush_queued();
+}
+
+void frame_pipeline_set_producer(frame_profile_t profile, TaskHandle_t task) {
+  producers[profile] = task;
+}
+
+uint8_t frame_pipeline_subscriber_count(frame_profile_t profile) {
+  return profile_subscribers[profile];
+}
+
+frame_t *frame_pipeline_alloc_slot() {
+  xSemaphoreTake(pipeline_lock, portMAX_DELAY);
+  frame_t *frame = alloc_frame_locked();
+  if (frame) {
+    frame->seq = next_seq; // Reserve the slot
+  }
+  xSemaphoreGive(pipeline_lock);
+  return frame;
+}
+
+bool frame_pipeline_store(frame_t *frame, const uint8_t *data, size_t len) {
+  return store_jpeg(frame, data, len);
+}
+
+bool frame_pipeline_encode(jpeg_encoder_t *enc, frame_t *frame, const uint8_t *src,
+                           size_t src_len, uint16_t width, uint16_t height, pixformat_t format,
+                           uint8_t quality) {
+  return encode_into_slot(enc, frame, src, src_len, width, height, format, quality);
+}
+
+void frame_pipeline_publish(frame_t *frame, frame_profile_t profile) {
+  publish_frame(frame, profile);
+}
+
+void frame_pipeline_discard(frame_t *frame) {
+  discard_slot(frame);
+}
+
+uint32_t frame_pipeline_dropped(int id) {
+  if (id < 0 || id >= FRAME_PIPELINE_MAX_SUBSCRIBERS) {
+    return 0;
+  }
+  return subscribers[id].dropped;
+}
+
+uint32_t frame_pipeline_error_count() {
+  return error_count;
+}
+
+void frame_pipeline_set_adaptive(bool enabled) {
+  adaptive_enabled = enabled;
+  frame_pipeline_note_activity();
+}
+
+bool frame_pipeline_adaptive() {
+  return adaptive_enabled;
+}
+
+bool frame_pipeline_quiet() {
+  return quiet;
+}
+
+void frame_pipeline_note_activity() {
+  last_change_ms = now_ms();
+  if (quiet && capture_task) {
+    xTaskNotifyGive(capture_task);
+  }
+}
@@ -0,0 +1,120 @@
+#ifndef FRAME_PIPELINE_H
+#define FRAME_PIPELINE_H
+
+#include "esp_camera.h"
+#include "board_config.h"
+#include "jpeg_encoder.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <sys/time.h>
+
+//
+// Frame distribution layer
+//
+// A single capture task (pinned to CAPTURE_TASK_CORE) grabs each frame from the
+// sensor once, copies it into a PSRAM ring slot and returns the driver buffer
+// straight away. Subscribers (stream clients, snapshot requests) receive a
+// reference-counted handle to the slot, which is reused once the last holder
+// has released it. Without PSRAM the driver buffer itself is shared instead.
+//
+// Frames are published per output profile. The capture task feeds the
+// full-resolution profile; pipeline stages (e.g. the preview scaler) subscribe
+// to it and publish derived frames on their own profile.
+//
+
+// Maximum number of concurrent subscribers (stream clients + in-flight snapshots)
+#define FRAME_PIPELINE_MAX_SUBSCRIBERS 8
+
+// Keep capturing this long after the last cache lookup, so periodic pollers
+// (e.g. DWC hitting /snapshot every few hundred ms) always find a fresh frame
+#define FRAME_CACHE_LINGER_MS 5000
+
+typedef enum {
+  FRAME_PROFILE_FULL = 0, // Sensor resolution, straight from the capture task
+  FRAME_PROFILE_PREVIEW,  // Downscaled, re-encoded thumbnail stream
+  FRAME_PROFILE_COUNT
+} frame_profile_t;
+
+typedef struct {
+  camera_fb_t *fb;          // Driver buffer still held (no-PSRAM fallback only)
+  uint8_t *buf;             // JPEG data (points into storage, or into fb)
+  size_t len;               // JPEG length in bytes
+  uint8_t *storage;         // Ring slot storage owned by this slot
+  size_t capacity;          // Allocated size of storage
+  frame_profile_t profile;  // Profile the frame was published on
+  uint16_t width;           // Image dimensions in pixels
+  uint16_t height;
+  struct timeval timestamp; // Sensor timestamp of the frame
+  int64_t published_us;     // esp_timer time at which the frame was published
+  uint32_t seq;             // Monotonic frame number, never 0 for a valid frame
+  uint32_t refs;            // Outstanding references (guarded by the pipeline lock)
+} frame_t;
+
+// Create the capture task and sync objects (safe to call more than once)
+bool frame_pipeline_start();
+
+// Register the caller as a consumer of a profile; returns a subscriber id or -1 if full
+int frame_pipeline_subscribe(frame_profile_t profile);
+void frame_pipeline_unsubscribe(int id);
+
+// Pop the oldest frame from the subscriber's send queue, blocking up to timeout_ms
+// for one to be published. Queues hold STREAM_CLIENT_QUEUE_DEPTH frames; a client
+// that falls behind has stale frames skipped rather than queued.
+// The returned frame is referenced and must be handed back via frame_pipeline_release().
+frame_t *frame_pipeline_wait(int id, uint32_t timeout_ms);
+void frame_pipeline_release(frame_t *frame);
+
+// Latest-frame cache: returns a referenced full-resolution frame no older than max_age_ms, or NULL.
+// Each lookup also keeps the capture task running for FRAME_CACHE_LINGER_MS.
+frame_t *frame_pipeline_get_latest(uint32_t max_age_ms);
+
+// Pipeline stage API: a stage task registers for its profile and is notified
+// whenever that profile gains a subscriber. It fills slots taken from the ring
+// and publishes them (or discards them on failure).
+void frame_pipeline_set_producer(frame_profile_t profile, TaskHandle_t task);
+uint8_t frame_pipeline_subscriber_count(frame_profile_t profile);
+frame_t *frame_pipeline_alloc_slot();
+bool frame_pipeline_store(frame_t *frame, const uint8_t *data, size_t len);
+// JPEG-encode raw pixels straight into the slot's pooled storage (no heap round trip)
+bool frame_pipeline_encode(jpeg_encoder_t *enc, frame_t *frame, const uint8_t *src,
+                           size_t src_len, uint16_t width, uint16_t height, pixformat_t format,
+                           uint8_t quality);
+void frame_pipeline_publish(frame_t *frame, frame_profile_t profile);
+void frame_pipeline_discard(frame_t *frame);
+
+// Park the capture task and release the camera so another component (e.g. the
+// benchmark) can own the driver; returns false if it did not park in time.
+// Suspends nest: capture stays parked until every successful suspend has been
+// matched by a resume.
+bool frame_pipeline_suspend(uint32_t timeout_ms);
+void frame_pipeline_resume();
+
+// Someone currently holds the pipeline parked
+bool frame_pipeline_suspended();
+
+// Serialises sensor register writes between /control, the rate controller and
+// power management (SCCB writes are bank-switched, so two writers corrupt each
+// other). false if not taken within the timeout; before the pipeline starts
+// there is only the setup task and it always succeeds.
+bool frame_pipeline_sensor_lock(uint32_t timeout_ms);
+void frame_pipeline_sensor_unlock();
+
+// Drop the cached and queued full-resolution frames, and throw away the next
+// `discard` captures while the sensor settles after a reconfiguration
+void frame_pipeline_flush(uint8_t discard);
+
+// Adaptive frame rate (ADAPTIVE_FPS_DEFAULT): capture drops to ADAPTIVE_QUIET_FPS
+// while the scene is static. Stages that detect change (e.g. motion) report it
+// through frame_pipeline_note_activity(), which restores the full rate at once.
+void frame_pipeline_set_adaptive(bool enabled);
+bool frame_pipeline_adaptive();
+bool frame_pipeline_quiet();
+void frame_pipeline_note_activity();
+
+// Frames skipped for this subscriber because it fell behind
+uint32_t frame_pipeline_dropped(int id);
+
+// Consecutive capture failures seen by the capture task (0 after a good frame)
+uint32_t frame_pipeline_error_count();
+
+#endif  // FRAME_PIPELINE_H
@@ -0,0 +1,171 @@
+#include "jpeg_encoder.h"
+#include "img_converters.h"
+
+#include <string.h>
+
+#if JPEG_ENCODER_SIMD
+#include "esp_jpeg_enc.h"
+#endif
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#endif
+
+typedef struct {
+  uint8_t *out;
+  size_t cap;
+  size_t len;
+  bool overflow;
+} bounded_writer_t;
+
+// fmt2jpg_cb sink that writes into a fixed buffer and flags overflow
+static size_t bounded_write_cb(void *arg, size_t index, const void *data, size_t len) {
+  bounded_writer_t *w = (bounded_writer_t *)arg;
+  if (index + len > w->cap) {
+    w->overflow = true;
+    return 0;
+  }
+  memcpy(w->out + index, data, len);
+  w->len = index + len;
+  return len;
+}
+
+static esp_err_t encode_software(const uint8_t *src, size_t src_len, uint16_t width,
+                                 uint16_t height, pixformat_t format, uint8_t quality,
+                                 uint8_t *out, size_t out_cap, size_t *out_len) {
+  bounded_writer_t w = {out, out_cap, 0, false};
+  bool ok = fmt2jpg_cb((uint8_t *)src, src_len, width, height, format, quality,
+                       bounded_write_cb, &w);
+  if (w.overflow) {
+    return ESP_ERR_NO_MEM;
+  }
+  if (!ok || w.len == 0) {
+    return ESP_FAIL;
+  }
+  *out_len = w.len;
+  return ESP_OK;
+}
+
+#if JPEG_ENCODER_SIMD
+static bool simd_source_type(pixformat_t format, jpeg_pixel_format_t *type,
+                             jpeg_subsampling_t *subsampling) {
+  switch (format) {
+    case PIXFORMAT_YUV422:
+      *type = JPEG_PIXEL_FORMAT_YCbYCr;
+      *subsampling = JPEG_SUBSAMPLE_422;
+      return true;
+    case PIXFORMAT_RGB565:
+      // esp32-camera delivers (and jpg2rgb565 produces) big-endian RGB565
+      *type = JPEG_PIXEL_FORMAT_RGB565_BE;
+      *subsampling = JPEG_SUBSAMPLE_420;
+      return true;
+    case PIXFORMAT_RGB888:
+      *type = JPEG_PIXEL_FORMAT_RGB888;
+      *subsampling = JPEG_SUBSAMPLE_420;
+      return true;
+    case PIXFORMAT_GRAYSCALE:
+      *type = JPEG_PIXEL_FORMAT_GRAY;
+      *subsampling = JPEG_SUBSAMPLE_GRAY;
+      return true;
+    default:
+      return false;
+  }
+}
+
+static void close_simd(jpeg_encoder_t *enc) {
+  if (enc->handle) {
+    jpeg_enc_close((jpeg_enc_handle_t)enc->handle);
+    enc->handle = nullptr;
+  }
+}
+
+// (Re)open the vector encoder when the frame geometry or quality changes
+static bool open_simd(jpeg_encoder_t *enc, uint16_t width, uint16_t height, pixformat_t format,
+                      uint8_t quality) {
+  if (enc->handle && enc->width == width && enc->height == height && enc->format == format &&
+      enc->quality == quality) {
+    return true;
+  }
+  close_simd(enc);
+  // Refused before: stay on software without asking (and warning) every frame
+  if (enc->rejected && enc->rejected_width == width && enc->rejected_height == height &&
+      enc->rejected_format == format) {
+    return false;
+  }
+
+  jpeg_enc_config_t config = DEFAULT_JPEG_ENC_CONFIG();
+  if (!simd_source_type(format, &config.src_type, &config.subsampling)) {
+    enc->rejected = true;
+    enc->rejected_width = width;
+    enc->rejected_height = height;
+    enc->rejected_format = format;
+    return false;
+  }
+  config.width = width;
+  config.height = height;
+  config.quality = quality;
+  config.rotate = JPEG_ROTATE_0D;
+
+  jpeg_enc_handle_t handle = nullptr;
+  jpeg_error_t err = jpeg_enc_open(&config, &handle);
+  if (err != JPEG_ERR_OK) {
+    log_w("SIMD JPEG encoder rejected %ux%u format %d (%d), using software", width, height,
+          format, err);
+    enc->rejected = true;
+    enc->rejected_width = width;
+    enc->rejected_height = height;
+    enc->rejected_format = format;
+    return false;
+  }
+  enc->rejected = false;
+  enc->handle = handle;
+  enc->width = width;
+  enc->height = height;
+  enc->format = format;
+  enc->quality = quality;
+  return true;
+}
+#endif  // JPEG_ENCODER_SIMD
+
+void jpeg_encoder_init(jpeg_encoder_t *enc, jpeg_backend_t backend) {
+  memset(enc, 0, sizeof(*enc));
+#if JPEG_ENCODER_SIMD
+  enc->backend = backend;
+#else
+  (void)backend;
+  enc->backend = JPEG_BACKEND_SOFTWARE;
+#endif
+}
+
+void jpeg_encoder_deinit(jpeg_encoder_t *enc) {
+#if JPEG_ENCODER_SIMD
+  close_simd(enc);
+#endif
+  enc->handle = nullptr;
+}
+
+esp_err_t jpeg_encoder_encode(jpeg_encoder_t *enc, const uint8_t *src, size_t src_len,
+                              uint16_t width, uint16_t height, pixformat_t format,
+                              uint8_t quality, uint8_t *out, size_t out_cap, size_t *out_len) {
+#if JPEG_ENCODER_SIMD
+  if (enc->backend == JPEG_BACKEND_SIMD && open_simd(enc, width, height, format, quality)) {
+    int written = 0;
+    jpeg_error_t err = jpeg_enc_process((jpeg_enc_handle_t)enc->handle, src, (int)src_len, out,
+                                        (int)out_cap, &written);
+    if (err == JPEG_ERR_OK && written > 0) {
+      *out_len = written;
+      enc->last_backend = JPEG_BACKEND_SIMD;
+      return ESP_OK;
+    }
+    // The vector encoder doesn't report a short output buffer distinctly; the
+    // software path below does, so let it decide between NO_MEM and FAIL
+    log_d("SIMD JPEG encode failed (%d), retrying in software", err);
+  }
+#endif
+  enc->last_backend = JPEG_BACKEND_SOFTWARE;
+  return encode_software(src, src_len, width, height, format, quality, out, out_cap, out_len);
+}
+
+const char *jpeg_encoder_backend_name(jpeg_backend_t backend) {
+  return backend == JPEG_BACKEND_SIMD ? "simd" : "software";
+}
@@ -0,0 +1,57 @@
+#ifndef JPEG_ENCODER_H
+#define JPEG_ENCODER_H
+
+#include "esp_camera.h"
+#include "esp_err.h"
+#include "board_config.h"
+
+//
+// JPEG encoder for raw pixel frames
+//
+// Encodes YUV422, RGB565, RGB888 or grayscale pixels into a caller-provided
+// buffer. With JPEG_ENCODER_SIMD the ESP32-S3 vector backend is used and its
+// encoder instance is kept open across frames of the same geometry; any
+// format or size it rejects falls back to the esp32-camera software encoder,
+// and the rejection is remembered until the geometry or format changes.
+//
+// An encoder is not thread-safe: each task that encodes owns its own instance.
+//
+
+typedef enum {
+  JPEG_BACKEND_SOFTWARE = 0, // esp32-camera fmt2jpg
+  JPEG_BACKEND_SIMD,         // esp_new_jpeg (ESP32-S3 PIE)
+} jpeg_backend_t;
+
+#if JPEG_ENCODER_SIMD
+#define JPEG_BACKEND_DEFAULT JPEG_BACKEND_SIMD
+#else
+#define JPEG_BACKEND_DEFAULT JPEG_BACKEND_SOFTWARE
+#endif
+
+typedef struct {
+  jpeg_backend_t backend;
+  void *handle;        // Open SIMD encoder, or NULL
+  uint16_t width;      // Geometry the handle was opened for
+  uint16_t height;
+  pixformat_t format;
+  uint8_t quality;
+  bool rejected;       // The SIMD backend refused the geometry below
+  uint16_t rejected_width;
+  uint16_t rejected_height;
+  pixformat_t rejected_format;
+  jpeg_backend_t last_backend; // Backend that produced the last encoded frame
+} jpeg_encoder_t;
+
+// Initialise an encoder; backends not compiled in fall back to software
+void jpeg_encoder_init(jpeg_encoder_t *enc, jpeg_backend_t backend);
+void jpeg_encoder_deinit(jpeg_encoder_t *enc);
+
+// Encode one frame into out. Returns ESP_ERR_NO_MEM if out_cap was too small
+// (the caller may grow the buffer and retry) and ESP_FAIL on other errors.
+esp_err_t jpeg_encoder_encode(jpeg_encoder_t *enc, const uint8_t *src, size_t src_len,
+                              uint16_t width, uint16_t height, pixformat_t format,
+                              uint8_t quality, uint8_t *out, size_t out_cap, size_t *out_len);
+
+const char *jpeg_encoder_backend_name(jpeg_backend_t backend);
+
+#endif  // JPEG_ENCODER_H
@@ -0,0 +1,152 @@
+#include "metrics.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define METRICS_BUCKETS 10
+
+typedef struct {
+  const char *name;
+  const char *help;
+  uint32_t bounds[METRICS_BUCKETS]; // Upper bounds; an implicit +Inf bucket follows
+} hist_def_t;
+
+typedef struct {
+  uint32_t buckets[METRICS_BUCKETS + 1];
+  uint32_t count;
+  uint64_t sum;
+} hist_t;
+
+static const char *counter_names[METRIC_COUNTER_COUNT][2] = {
+  {"cam_frames_captured_total", "Frames published by the capture task"},
+  {"cam_frames_sent_total", "Stream parts written to clients"},
+  {"cam_frames_dropped_total", "Stale frames skipped for slow stream clients"},
+  {"cam_frames_flushed_total", "Frames discarded after a sensor reconfiguration"},
+  {"cam_capture_errors_total", "Failed captures or conversions"},
+  {"cam_capture_recovered_total", "Capture error streaks ended by a good frame"},
+  {"cam_snapshot_cache_hits_total", "Snapshots served from the latest-frame cache"},
+  {"cam_snapshot_cache_misses_total", "Snapshots that waited for a new frame"},
+};
+
+static const hist_def_t hist_defs[METRIC_HIST_COUNT] = {
+  {"cam_capture_wait_us", "Time blocked in esp_camera_fb_get",
+   {1000, 2000, 5000, 10000, 20000, 33000, 50000, 100000, 200000, 500000}},
+  {"cam_send_us", "Time to write one stream part",
+   {1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000, 500000, 1000000}},
+  {"cam_jpeg_bytes", "Size of each captured JPEG",
+   {8192, 16384, 32768, 49152, 65536, 98304, 131072, 196608, 262144, 524288}},
+};
+
+static const hist_def_t request_def = {
+  "cam_request_us", "Request handling latency per endpoint",
+  {500, 1000, 2000, 5000, 10000, 20000, 50000, 100000, 250000, 1000000}};
+
+static const char *endpoint_names[METRIC_EP_COUNT] = {
+  "/", "/status", "/control", "/capture", "/health", "/metrics", "/events",
+};
+
+static uint32_t counters[METRIC_COUNTER_COUNT];
+static hist_t hists[METRIC_HIST_COUNT];
+static hist_t request_hists[METRIC_EP_COUNT];
+
+static void hist_record(hist_t *h, const hist_def_t *def, uint32_t value) {
+  int i = 0;
+  while (i < METRICS_BUCKETS && value > def->bounds[i]) {
+    i++;
+  }
+  __atomic_fetch_add(&h->buckets[i], 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&h->count, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&h->sum, (uint64_t)value, __ATOMIC_RELAXED);
+}
+
+void metrics_inc(metric_counter_t counter) {
+  __atomic_fetch_add(&counters[counter], 1, __ATOMIC_RELAXED);
+}
+
+void metrics_observe(metric_hist_t hist, uint32_t value) {
+  hist_record(&hists[hist], &hist_defs[hist], value);
+}
+
+void metrics_observe_endpoint(metric_endpoint_t endpoint, uint32_t latency_us) {
+  hist_record(&request_hists[endpoint], &request_def, latency_us);
+}
+
+// Emit one histogram; labels is either "" or a `key="value",` prefix
+static void render_hist(metrics_emit_fn emit, void *ctx, const hist_def_t *def, const hist_t *h,
+                        const char *labels) {
+  char line[160];
+  int len;
+  uint32_t cumulative = 0;
+
+  for (int i = 0; i <= METRICS_BUCKETS; i++) {
+    cumulative += __atomic_load_n(&h->buckets[i], __ATOMIC_RELAXED);
+    if (i < METRICS_BUCKETS) {
+      len = snprintf(line, sizeof(line), "%s_bucket{%sle=\"%u\"} %u\n", def->name, labels,
+                     (unsigned)def->bounds[i], (unsigned)cumulative);
+    } else {
+      len = snprintf(line, sizeof(line), "%s_bucket{%sle=\"+Inf\"} %u\n", def->name, labels,
+                     (unsigned)cumulative);
+    }
+    emit(ctx, line, len);
+  }
+
+  // Trim the trailing comma for the plain series
+  char plain[48] = "";
+  if (labels[0]) {
+    snprintf(plain, sizeof(plain), "{%s", labels);
+    plain[strlen(plain) - 1] = '}';
+  }
+  len = snprintf(line, sizeof(line), "%s_sum%s %llu\n%s_count%s %u\n", def->name, plain,
+                 (unsigned long long)__atomic_load_n(&h->sum, __ATOMIC_RELAXED), def->name, plain,
+                 (unsigned)__atomic_load_n(&h->count, __ATOMIC_RELAXED));
+  emit(ctx, line, len);
+}
+
+static void render_gauge(metrics_emit_fn emit, void *ctx, const char *name, const char *help,
+                         unsigned long long value) {
+  char line[192];
+  int len = snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s gauge\n%s %llu\n", name, help,
+                     name, name, value);
+  emit(ctx, line, len);
+}
+
+void metrics_render(metrics_emit_fn emit, void *ctx) {
+  char line[192];
+  int len;
+
+  for (int i = 0; i < METRIC_COUNTER_COUNT; i++) {
+    len = snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s counter\n%s %u\n",
+                   counter_names[i][0], counter_names[i][1], counter_names[i][0],
+                   counter_names[i][0], (unsigned)__atomic_load_n(&counters[i], __ATOMIC_RELAXED));
+    emit(ctx, line, len);
+  }
+
+  for (int i = 0; i < METRIC_HIST_COUNT; i++) {
+    len = snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s histogram\n", hist_defs[i].name,
+                   hist_defs[i].help, hist_defs[i].name);
+    emit(ctx, line, len);
+    render_hist(emit, ctx, &hist_defs[i], &hists[i], "");
+  }
+
+  len = snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s histogram\n", request_def.name,
+                 request_def.help, request_def.name);
+  emit(ctx, line, len);
+  for (int i = 0; i < METRIC_EP_COUNT; i++) {
+    char labels[40];
+    snprintf(labels, sizeof(labels), "endpoint=\"%s\",", endpoint_names[i]);
+    render_hist(emit, ctx, &request_def, &request_hists[i], labels);
+  }
+
+  // Memory: current free and low-water mark (i.e. peak usage) per heap
+  render_gauge(emit, ctx, "cam_dram_free_bytes", "Free internal RAM",
+               heap_caps_get_free_size(MALLOC_CAP_INTERNAL));
+  render_gauge(emit, ctx, "cam_dram_min_free_bytes", "Lowest free internal RAM since boot",
+               heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL));
+  render_gauge(emit, ctx, "cam_psram_free_bytes", "Free PSRAM",
+               heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
+  render_gauge(emit, ctx, "cam_psram_min_free_bytes", "Lowest free PSRAM since boot",
+               heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM));
+  render_gauge(emit, ctx, "cam_uptime_seconds", "Seconds since boot", esp_timer_get_time() / 1000000);
+}
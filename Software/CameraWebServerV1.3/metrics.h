@@ -0,0 +1,52 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+//
+// Hot-path instrumentation
+//
+// Counters and fixed-bucket histograms updated with relaxed atomics, so any task
+// can record without locks. /metrics renders them in Prometheus text format.
+//
+
+typedef enum {
+  METRIC_FRAMES_CAPTURED,   // Frames published by the capture task
+  METRIC_FRAMES_SENT,       // Stream parts written to clients
+  METRIC_FRAMES_DROPPED,    // Stale frames skipped for slow clients
+  METRIC_FRAMES_FLUSHED,    // Frames discarded by a reconfiguration flush
+  METRIC_CAPTURE_ERRORS,    // esp_camera_fb_get() / conversion failures
+  METRIC_CAPTURE_RECOVERED, // Error streaks ended by a good frame (error_count reset)
+  METRIC_SNAPSHOT_CACHE_HITS,
+  METRIC_SNAPSHOT_CACHE_MISSES,
+  METRIC_COUNTER_COUNT
+} metric_counter_t;
+
+typedef enum {
+  METRIC_HIST_CAPTURE_WAIT_US, // Time blocked in esp_camera_fb_get()
+  METRIC_HIST_SEND_US,         // Time to write one stream part
+  METRIC_HIST_JPEG_BYTES,      // Size of each captured JPEG
+  METRIC_HIST_COUNT
+} metric_hist_t;
+
+typedef enum {
+  METRIC_EP_INDEX,
+  METRIC_EP_STATUS,
+  METRIC_EP_CONTROL,
+  METRIC_EP_CAPTURE,
+  METRIC_EP_HEALTH,
+  METRIC_EP_METRICS,
+  METRIC_EP_EVENTS,
+  METRIC_EP_COUNT
+} metric_endpoint_t;
+
+void metrics_inc(metric_counter_t counter);
+void metrics_observe(metric_hist_t hist, uint32_t value);
+void metrics_observe_endpoint(metric_endpoint_t endpoint, uint32_t latency_us);
+
+// Render every metric; emit() is called once per chunk of text
+typedef void (*metrics_emit_fn)(void *ctx, const char *text, size_t len);
+void metrics_render(metrics_emit_fn emit, void *ctx);
+
+#endif  // METRICS_H
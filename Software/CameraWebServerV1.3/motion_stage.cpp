@@ -0,0 +1,341 @@
+#include "motion_stage.h"
+#include "board_config.h"
+
+#if MOTION_DETECTION
+
+#include "frame_pipeline.h"
+#include "img_converters.h"
+#include "esp_timer.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp32-hal-psram.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#endif
+
+// Narrowest luma plane worth analysing; picks 1/8 scale for SVGA and above
+static const uint16_t MOTION_MIN_WIDTH = 80;
+
+// Frames are only published at ADAPTIVE_QUIET_FPS in a static scene; accept
+// those rather than waking the capture task on every sample
+static const uint32_t MOTION_MAX_FRAME_AGE_MS = 1000 / ADAPTIVE_QUIET_FPS + MOTION_INTERVAL_MS;
+
+// Background adapts by 1/16 of the difference per sample (~3 s at 5 Hz)
+static const int MOTION_BACKGROUND_SHIFT = 4;
+
+static TaskHandle_t motion_task = nullptr;
+static SemaphoreHandle_t motion_lock = nullptr;
+static volatile bool motion_enabled = MOTION_DEFAULT_ENABLED;
+
+// Guarded by motion_lock
+static motion_status_t state;
+static motion_event_t event_log[MOTION_EVENT_LOG];
+static uint32_t next_event_id = 1;
+
+// Owned by the motion task
+static uint8_t *rgb_buf = nullptr;
+static size_t rgb_capacity = 0;
+static uint8_t *luma = nullptr;
+static uint16_t *background = nullptr; // 8.8 fixed point running average
+static size_t plane_capacity = 0;
+static uint16_t plane_width = 0;
+static uint16_t plane_height = 0;
+static bool have_background = false;
+
+// Largest JPEG decode step that keeps the plane at least MOTION_MIN_WIDTH wide
+static jpg_scale_t pick_scale(uint16_t width, uint16_t *divisor) {
+  int step = JPG_SCALE_8X;
+  while (step > JPG_SCALE_NONE && (width >> step) < MOTION_MIN_WIDTH) {
+    step--;
+  }
+  *divisor = 1 << step;
+  return (jpg_scale_t)step;
+}
+
+static void *alloc_scratch(void *old, size_t len) {
+  free(old);
+  return psramFound() ? ps_malloc(len) : malloc(len);
+}
+
+static bool ensure_buffers(uint16_t width, uint16_t height) {
+  size_t pixels = (size_t)width * height;
+  if (rgb_capacity < pixels * 2) {
+    rgb_buf = (uint8_t *)alloc_scratch(rgb_buf, pixels * 2);
+    rgb_capacity = rgb_buf ? pixels * 2 : 0;
+  }
+  if (plane_capacity < pixels) {
+    luma = (uint8_t *)alloc_scratch(luma, pixels);
+    background = (uint16_t *)alloc_scratch(background, pixels * sizeof(uint16_t));
+    plane_capacity = (luma && background) ? pixels : 0;
+    have_background = false;
+  }
+  if (width != plane_width || height != plane_height) {
+    plane_width = width;
+    plane_height = height;
+    have_background = false;
+  }
+  return rgb_capacity && plane_capacity;
+}
+
+static void free_buffers() {
+  free(rgb_buf);
+  free(luma);
+  free(background);
+  rgb_buf = luma = nullptr;
+  background = nullptr;
+  rgb_capacity = plane_capacity = 0;
+  plane_width = plane_height = 0;
+  have_background = false;
+}
+
+// Big-endian RGB565 (as produced by jpg2rgb565) to 8-bit luma
+static void rgb565_to_luma(const uint8_t *rgb, uint8_t *out, size_t pixels) {
+  for (size_t i = 0; i < pixels; i++, rgb += 2) {
+    uint32_t r = rgb[0] & 0xF8;
+    uint32_t g = ((rgb[0] & 0x07) << 5) | ((rgb[1] & 0xE0) >> 3);
+    uint32_t b = (rgb[1] & 0x1F) << 3;
+    out[i] = (uint8_t)((r * 77 + g * 150 + b * 29) >> 8);
+  }
+}
+
+// Sum of absolute differences between one block and the background, adapting
+// the background towards the current frame in the same pass
+static uint32_t block_sad(int x0, int y0, int bw, int bh) {
+  uint32_t sad = 0;
+  for (int y = y0; y < y0 + bh; y++) {
+    const uint8_t *cur = luma + (size_t)y * plane_width + x0;
+    uint16_t *bg = background + (size_t)y * plane_width + x0;
+    int x = 0;
+    // Four pixels per iteration keeps the loop body branch-free
+    for (; x + 4 <= bw; x += 4) {
+      int d0 = cur[x] - (bg[x] >> 8);
+      int d1 = cur[x + 1] - (bg[x + 1] >> 8);
+      int d2 = cur[x + 2] - (bg[x + 2] >> 8);
+      int d3 = cur[x + 3] - (bg[x + 3] >> 8);
+      sad += abs(d0) + abs(d1) + abs(d2) + abs(d3);
+      bg[x] += ((int)(cur[x] << 8) - bg[x]) >> MOTION_BACKGROUND_SHIFT;
+      bg[x + 1] += ((int)(cur[x + 1] << 8) - bg[x + 1]) >> MOTION_BACKGROUND_SHIFT;
+      bg[x + 2] += ((int)(cur[x + 2] << 8) - bg[x + 2]) >> MOTION_BACKGROUND_SHIFT;
+      bg[x + 3] += ((int)(cur[x + 3] << 8) - bg[x + 3]) >> MOTION_BACKGROUND_SHIFT;
+    }
+    for (; x < bw; x++) {
+      sad += abs(cur[x] - (bg[x] >> 8));
+      bg[x] += ((int)(cur[x] << 8) - bg[x]) >> MOTION_BACKGROUND_SHIFT;
+    }
+  }
+  return sad;
+}
+
+static void box_union(motion_box_t *a, const motion_box_t *b) {
+  if (a->w == 0 || a->h == 0) {
+    *a = *b;
+    return;
+  }
+  uint16_t x1 = a->x + a->w > b->x + b->w ? a->x + a->w : b->x + b->w;
+  uint16_t y1 = a->y + a->h > b->y + b->h ? a->y + a->h : b->y + b->h;
+  a->x = a->x < b->x ? a->x : b->x;
+  a->y = a->y < b->y ? a->y : b->y;
+  a->w = x1 - a->x;
+  a->h = y1 - a->y;
+}
+
+// Close the open event at its last motion; caller holds motion_lock
+static void close_event_locked(motion_event_t *current) {
+  current->end_us = state.last_motion_us;
+  state.active = false;
+  log_i("Motion event %u ended (peak %u)", current->id, current->peak);
+}
+
+static motion_event_t *current_event_locked() {
+  return &event_log[(next_event_id - 2 + MOTION_EVENT_LOG) % MOTION_EVENT_LOG];
+}
+
+// Fold one analysed frame into the status and event log
+static void record_result(uint16_t score, const motion_box_t *box) {
+  int64_t now = esp_timer_get_time();
+  bool motion = score >= MOTION_TRIGGER_PERMILLE;
+
+  xSemaphoreTake(motion_lock, portMAX_DELAY);
+  state.score = score;
+  state.box = motion ? *box : motion_box_t{0, 0, 0, 0};
+  state.analysed++;
+
+  motion_event_t *current = current_event_locked();
+  if (motion) {
+    state.last_motion_us = now;
+    if (!state.active) {
+      current = &event_log[(next_event_id - 1) % MOTION_EVENT_LOG];
+      current->id = next_event_id++;
+      current->start_us = now;
+      current->end_us = 0;
+      current->peak = score;
+      current->box = *box;
+      state.active = true;
+      state.events++;
+      log_i("Motion event %u started (score %u)", current->id, score);
+    } else {
+      if (score > current->peak) {
+        current->peak = score;
+      }
+      box_union(&current->box, box);
+    }
+  } else if (state.active && now - state.last_motion_us > (int64_t)MOTION_HOLD_MS * 1000) {
+    close_event_locked(current);
+  }
+  xSemaphoreGive(motion_lock);
+
+  if (motion) {
+    // Motion at the quiet rate should bring streams back to full rate at once
+    frame_pipeline_note_activity();
+  }
+}
+
+static void analyse(frame_t *frame) {
+  uint16_t div = 1;
+  jpg_scale_t scale = pick_scale(frame->width, &div);
+  uint16_t width = frame->width / div;
+  uint16_t height = frame->height / div;
+
+  bool decoded = ensure_buffers(width, height) &&
+                 jpg2rgb565(frame->buf, frame->len, rgb_buf, scale);
+  frame_pipeline_release(frame);
+  if (!decoded) {
+    log_e("Motion decode failed");
+    return;
+  }
+
+  size_t pixels = (size_t)width * height;
+  rgb565_to_luma(rgb_buf, luma, pixels);
+  if (!have_background) {
+    for (size_t i = 0; i < pixels; i++) {
+      background[i] = luma[i] << 8;
+    }
+    have_background = true;
+    return;
+  }
+
+  uint32_t blocks = 0;
+  uint32_t changed = 0;
+  int bx0 = width, by0 = height, bx1 = 0, by1 = 0;
+  for (int y = 0; y < height; y += MOTION_BLOCK_SIZE) {
+    int bh = height - y < MOTION_BLOCK_SIZE ? height - y : MOTION_BLOCK_SIZE;
+    for (int x = 0; x < width; x += MOTION_BLOCK_SIZE) {
+      int bw = width - x < MOTION_BLOCK_SIZE ? width - x : MOTION_BLOCK_SIZE;
+      blocks++;
+      if (block_sad(x, y, bw, bh) > (uint32_t)MOTION_BLOCK_THRESHOLD * bw * bh) {
+        changed++;
+        if (x < bx0) bx0 = x;
+        if (y < by0) by0 = y;
+        if (x + bw > bx1) bx1 = x + bw;
+        if (y + bh > by1) by1 = y + bh;
+      }
+    }
+  }
+
+  motion_box_t box = {0, 0, 0, 0};
+  if (changed) {
+    box = {(uint16_t)(bx0 * div), (uint16_t)(by0 * div), (uint16_t)((bx1 - bx0) * div),
+           (uint16_t)((by1 - by0) * div)};
+  }
+  record_result((uint16_t)(changed * 1000 / blocks), &box);
+}
+
+static void motion_task_fn(void *arg) {
+  (void)arg;
+  uint32_t last_seq = 0;
+  TickType_t wake = xTaskGetTickCount();
+
+  while (true) {
+    if (!motion_enabled) {
+      free_buffers();
+      xSemaphoreTake(motion_lock, portMAX_DELAY);
+      // An event open when detection stops ends there, not "ongoing" forever
+      if (state.active) {
+        close_event_locked(current_event_locked());
+      }
+      state.score = 0;
+      state.box = motion_box_t{0, 0, 0, 0};
+      xSemaphoreGive(motion_lock);
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      wake = xTaskGetTickCount();
+      continue;
+    }
+
+    // Cache lookups keep the capture task lingering, but never queue frames
+    frame_t *frame = frame_pipeline_get_latest(MOTION_MAX_FRAME_AGE_MS);
+    if (frame && frame->seq != last_seq) {
+      last_seq = frame->seq;
+      analyse(frame);
+    } else if (frame) {
+      frame_pipeline_release(frame);
+    }
+    vTaskDelayUntil(&wake, pdMS_TO_TICKS(MOTION_INTERVAL_MS));
+  }
+}
+
+bool motion_stage_start() {
+  if (motion_task != nullptr) {
+    return true;
+  }
+
+  motion_lock = xSemaphoreCreateMutex();
+  if (!motion_lock) {
+    return false;
+  }
+  memset(&state, 0, sizeof(state));
+
+  if (xTaskCreatePinnedToCore(motion_task_fn, "cam_motion", MOTION_TASK_STACK, nullptr,
+                              MOTION_TASK_PRIORITY, &motion_task, HTTPD_TASK_CORE) != pdPASS) {
+    log_e("Failed to create motion task");
+    motion_task = nullptr;
+    return false;
+  }
+  log_i("Motion detection every %dms", MOTION_INTERVAL_MS);
+  return true;
+}
+
+void motion_set_enabled(bool enabled) {
+  motion_enabled = enabled;
+  if (enabled && motion_task) {
+    xTaskNotifyGive(motion_task);
+  }
+}
+
+bool motion_is_enabled() {
+  return motion_enabled;
+}
+
+void motion_get_status(motion_status_t *status) {
+  if (!motion_lock) {
+    memset(status, 0, sizeof(*status));
+    return;
+  }
+  xSemaphoreTake(motion_lock, portMAX_DELAY);
+  *status = state;
+  xSemaphoreGive(motion_lock);
+  status->enabled = motion_enabled;
+}
+
+int motion_get_events(uint32_t since, motion_event_t *events, int max) {
+  if (!motion_lock) {
+    return 0;
+  }
+  int count = 0;
+  xSemaphoreTake(motion_lock, portMAX_DELAY);
+  uint32_t first = next_event_id > MOTION_EVENT_LOG ? next_event_id - MOTION_EVENT_LOG : 1;
+  if (since + 1 > first) {
+    first = since + 1;
+  }
+  for (uint32_t id = first; id < next_event_id && count < max; id++) {
+    events[count++] = event_log[(id - 1) % MOTION_EVENT_LOG];
+  }
+  xSemaphoreGive(motion_lock);
+  return count;
+}
+
+#endif  // MOTION_DETECTION
@@ -0,0 +1,52 @@
+#ifndef MOTION_STAGE_H
+#define MOTION_STAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+//
+// Motion detection pipeline stage
+//
+// Samples the latest full-resolution frame from the pipeline cache (never a
+// stream queue, so /stream output is unaffected), diffs a downscaled luma plane
+// against a slowly adapting background with per-block SAD, and tracks motion
+// events: an event opens when enough blocks change and closes after
+// MOTION_HOLD_MS without motion.
+//
+
+#define MOTION_EVENT_LOG 16
+
+typedef struct {
+  uint16_t x, y, w, h; // Changed region in full-frame pixels (0x0 when quiet)
+} motion_box_t;
+
+typedef struct {
+  bool enabled;
+  bool active;            // An event is currently open
+  uint16_t score;         // Changed blocks, per mille of the frame
+  motion_box_t box;       // Region of the last analysed frame
+  uint32_t events;        // Events opened since boot
+  int64_t last_motion_us; // esp_timer time of the last frame with motion
+  uint32_t analysed;      // Frames analysed since boot
+} motion_status_t;
+
+typedef struct {
+  uint32_t id;        // 1-based, increments per event
+  int64_t start_us;   // esp_timer time the event opened
+  int64_t end_us;     // 0 while still open
+  uint16_t peak;      // Highest per-mille score during the event
+  motion_box_t box;   // Union of changed regions over the event
+} motion_event_t;
+
+bool motion_stage_start();
+
+// Runtime switch (/control var=motion); disabling resets the background
+void motion_set_enabled(bool enabled);
+bool motion_is_enabled();
+
+void motion_get_status(motion_status_t *status);
+
+// Copy up to max logged events with id > since, oldest first; returns the count
+int motion_get_events(uint32_t since, motion_event_t *events, int max);
+
+#endif  // MOTION_STAGE_H
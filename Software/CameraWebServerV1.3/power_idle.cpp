@@ -0,0 +1,241 @@
+#include "power_idle.h"
+#include "board_config.h"
+
+#if IDLE_POWER_SAVE
+
+#include "esp_camera.h"
+#include "camera_board.h"
+#include "frame_pipeline.h"
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#endif
+
+// Capture normally parks within one frame; a longer wait means another
+// component holds the pipeline, so standby is retried on a later poll
+#define IDLE_SUSPEND_TIMEOUT_MS 500
+// A request waits this long for loop() to bring the camera back; past it the
+// request is served anyway, just on the idle clock
+#define IDLE_WAKE_TIMEOUT_MS 1000
+
+#define AWAKE_BIT (1 << 0)
+
+static SemaphoreHandle_t power_lock = nullptr;
+static portMUX_TYPE power_init_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Guarded by power_lock
+static power_status_t power = {POWER_ACTIVE, 0, 0, 0, 0};
+static uint32_t last_activity_ms = 0;
+static uint32_t active_cpu_mhz = 0;
+static bool wake_requested = false;
+
+// Set once by the first power_idle_poll(). The clock, modem and sensor are only
+// changed from loop(): setCpuFrequencyMhz() and WiFi.setSleep() are not safe
+// to call from the httpd, RTSP or stream tasks that serve requests.
+static TaskHandle_t loop_task = nullptr;
+static EventGroupHandle_t power_events = nullptr; // AWAKE_BIT while active
+
+static bool ensure_lock() {
+  if (power_lock) {
+    return true;
+  }
+  SemaphoreHandle_t lock = xSemaphoreCreateMutex();
+  if (!lock) {
+    return false;
+  }
+  portENTER_CRITICAL(&power_init_mux);
+  if (!power_lock) {
+    power_lock = lock;
+    lock = nullptr;
+  }
+  portEXIT_CRITICAL(&power_init_mux);
+  if (lock) {
+    vSemaphoreDelete(lock);
+  }
+  return true;
+}
+
+// Software standby keeps the register file (exposure, gains, window), so the
+// sensor comes back in a few frames without being reprogrammed
+static void sensor_standby(bool standby) {
+  if (CAMERA_SENSOR_DESC.standby_mask == 0) {
+    return;
+  }
+  sensor_t *s = esp_camera_sensor_get();
+  if (!s || !s->set_reg) {
+    return;
+  }
+  // Held for a whole benchmark sweep, which re-inits the sensor out of standby anyway
+  if (!frame_pipeline_sensor_lock(IDLE_SUSPEND_TIMEOUT_MS)) {
+    log_w("Sensor busy, standby %s skipped", standby ? "entry" : "exit");
+    return;
+  }
+  int res = s->set_reg(s, CAMERA_SENSOR_DESC.standby_reg, CAMERA_SENSOR_DESC.standby_mask,
+                       standby ? CAMERA_SENSOR_DESC.standby_mask : 0);
+  frame_pipeline_sensor_unlock();
+  if (res != 0) {
+    log_w("Sensor standby %s failed", standby ? "entry" : "exit");
+  }
+}
+
+static void enter_idle_locked(uint32_t now) {
+  active_cpu_mhz = getCpuFrequencyMhz();
+  WiFi.setSleep(true);
+  if (active_cpu_mhz > IDLE_CPU_MHZ) {
+    setCpuFrequencyMhz(IDLE_CPU_MHZ);
+  }
+  if (power_events) {
+    xEventGroupClearBits(power_events, AWAKE_BIT);
+  }
+  power.state = POWER_IDLE;
+  power.idle_entries++;
+  power.idle_since_ms = now;
+  log_i("Idle: modem sleep, CPU %u MHz", (unsigned)getCpuFrequencyMhz());
+}
+
+static void enter_standby_locked() {
+  // Parked by someone else (benchmark, reconfiguration): the driver may be
+  // half way through a re-init, so leave the sensor alone until they are done
+  if (frame_pipeline_suspended()) {
+    log_d("Capture parked elsewhere, standby deferred");
+    return;
+  }
+  if (!frame_pipeline_suspend(IDLE_SUSPEND_TIMEOUT_MS)) {
+    log_d("Capture busy, standby deferred");
+    return;
+  }
+  sensor_standby(true);
+  power.state = POWER_STANDBY;
+  log_i("Sensor standby");
+}
+
+// Short re-warm instead of the boot warm-up: only the frames exposed across
+// the standby exit are thrown away
+static void leave_standby_locked() {
+  sensor_standby(false);
+  frame_pipeline_flush(IDLE_REWARM_FRAMES);
+  frame_pipeline_resume();
+  power.state = POWER_IDLE;
+}
+
+static void wake_locked() {
+  uint32_t start = millis();
+  // Clock first, so the rest of the wake-up runs at full speed
+  if (active_cpu_mhz > IDLE_CPU_MHZ) {
+    setCpuFrequencyMhz(active_cpu_mhz);
+  }
+  if (power.state == POWER_STANDBY) {
+    leave_standby_locked();
+  }
+  WiFi.setSleep(false);
+  power.state = POWER_ACTIVE;
+  if (power_events) {
+    xEventGroupSetBits(power_events, AWAKE_BIT);
+  }
+  power.wakeups++;
+  power.last_wake_ms = millis() - start;
+  log_i("Awake after %u s idle (%u ms)", (unsigned)((start - power.idle_since_ms) / 1000),
+        (unsigned)power.last_wake_ms);
+}
+
+void power_idle_touch() {
+  if (!ensure_lock()) {
+    return;
+  }
+  xSemaphoreTake(power_lock, portMAX_DELAY);
+  last_activity_ms = millis();
+  bool wake = power.state != POWER_ACTIVE;
+  if (wake) {
+    wake_requested = true;
+  }
+  xSemaphoreGive(power_lock);
+
+  TaskHandle_t task = __atomic_load_n(&loop_task, __ATOMIC_ACQUIRE);
+  if (wake && task && task != xTaskGetCurrentTaskHandle()) {
+    // loop() does the wake-up; the request goes on once it is done
+    xTaskNotifyGive(task);
+    if (!(xEventGroupWaitBits(power_events, AWAKE_BIT, pdFALSE, pdTRUE,
+                              pdMS_TO_TICKS(IDLE_WAKE_TIMEOUT_MS)) & AWAKE_BIT)) {
+      log_w("Wake-up not done within %u ms", IDLE_WAKE_TIMEOUT_MS);
+    }
+  }
+}
+
+void power_idle_sleep(uint32_t ms) {
+  if (__atomic_load_n(&loop_task, __ATOMIC_ACQUIRE)) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+  } else {
+    delay(ms);
+  }
+}
+
+void power_idle_poll(uint32_t sessions, bool background) {
+  if (!ensure_lock()) {
+    return;
+  }
+  if (!loop_task) {
+    power_events = xEventGroupCreate();
+    if (power_events) {
+      xEventGroupSetBits(power_events, AWAKE_BIT);
+      __atomic_store_n(&loop_task, xTaskGetCurrentTaskHandle(), __ATOMIC_RELEASE);
+    }
+  }
+  uint32_t now = millis();
+
+  xSemaphoreTake(power_lock, portMAX_DELAY);
+  bool wake = wake_requested;
+  wake_requested = false;
+  if (sessions > 0 || wake) {
+    if (sessions > 0) {
+      last_activity_ms = now;
+    }
+    if (power.state != POWER_ACTIVE) {
+      wake_locked();
+    }
+  } else if (power.state == POWER_ACTIVE && now - last_activity_ms >= IDLE_TIMEOUT_S * 1000UL) {
+    enter_idle_locked(now);
+  }
+
+  // A background stage turned on or off while idle moves between the two levels
+  if (power.state == POWER_IDLE && !background) {
+    enter_standby_locked();
+  } else if (power.state == POWER_STANDBY && background) {
+    leave_standby_locked();
+  }
+  xSemaphoreGive(power_lock);
+}
+
+bool power_idle_active() {
+  return __atomic_load_n(&power.state, __ATOMIC_RELAXED) != POWER_ACTIVE;
+}
+
+void power_get_status(power_status_t *status) {
+  if (!ensure_lock()) {
+    *status = {};
+    return;
+  }
+  xSemaphoreTake(power_lock, portMAX_DELAY);
+  *status = power;
+  xSemaphoreGive(power_lock);
+}
+
+const char *power_state_name(power_state_t state) {
+  switch (state) {
+    case POWER_ACTIVE:
+      return "active";
+    case POWER_IDLE:
+      return "idle";
+    case POWER_STANDBY:
+      return "standby";
+  }
+  return "unknown";
+}
+
+#endif  // IDLE_POWER_SAVE
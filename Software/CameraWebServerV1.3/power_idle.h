@@ -0,0 +1,56 @@
+#ifndef POWER_IDLE_H
+#define POWER_IDLE_H
+
+#include <stdint.h>
+
+//
+// Low-power idle
+//
+// loop() reports the open stream, WebSocket and RTSP sessions and whether a
+// background stage (motion, clip recorder, interval timelapse) still needs
+// frames. After IDLE_TIMEOUT_S with no session and no waking request the
+// camera goes idle: Wi-Fi modem sleep on, CPU down to IDLE_CPU_MHZ. Without
+// background demand the capture task is parked and the sensor put into
+// software standby as well (standby), keeping its exposure and white balance.
+//
+// Requests that need the camera call power_idle_touch(), which has loop() undo
+// all of it and waits until it has, so the request is served awake: clock and
+// modem back to normal, sensor awake, IDLE_REWARM_FRAMES discarded while it
+// settles, capture resumed. Every transition runs in loop(); request tasks
+// only post the wake-up. Monitoring (/status, /metrics, /health) does not wake
+// the camera, so a scraper does not keep it awake.
+//
+// Motion detection and the clip recorder are off by default, so an unattended
+// camera reaches standby unless one of them or an interval timelapse is on.
+//
+
+typedef enum {
+  POWER_ACTIVE = 0,
+  POWER_IDLE,       // Modem sleep and low CPU clock, sensor still capturing
+  POWER_STANDBY,    // As idle, with capture parked and the sensor in standby
+} power_state_t;
+
+typedef struct {
+  power_state_t state;
+  uint32_t idle_entries;   // Times the camera went idle since boot
+  uint32_t wakeups;        // Times a request brought it back
+  uint32_t last_wake_ms;   // Duration of the last wake-up
+  uint32_t idle_since_ms;  // millis() when the current idle period began
+} power_status_t;
+
+// Restart the idle timer, waking the camera first if it is idle; call before
+// serving a request that captures or configures
+void power_idle_touch();
+
+// Idle timer and transitions; call from loop(), the only task that changes
+// the power state
+void power_idle_poll(uint32_t sessions, bool background);
+
+// loop()'s delay between polls; returns early when a request asks for a wake-up
+void power_idle_sleep(uint32_t ms);
+
+bool power_idle_active();
+void power_get_status(power_status_t *status);
+const char *power_state_name(power_state_t state);
+
+#endif  // POWER_IDLE_H
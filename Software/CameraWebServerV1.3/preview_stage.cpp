@@ -0,0 +1,123 @@
+#include "preview_stage.h"
+#include "frame_pipeline.h"
+#include "img_converters.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp32-hal-psram.h>
+#include <stdlib.h>
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#endif
+
+static const uint32_t PREVIEW_WAIT_TIMEOUT_MS = 1000;
+
+static TaskHandle_t preview_task = nullptr;
+
+// Decoded RGB565 scratch buffer, grown to the largest preview seen
+static uint8_t *rgb_buf = nullptr;
+static size_t rgb_capacity = 0;
+static jpeg_encoder_t preview_encoder;
+
+// Largest decoder scale step that keeps the preview at least PREVIEW_TARGET_WIDTH wide
+static jpg_scale_t pick_scale(uint16_t width, uint16_t *divisor) {
+  int step = 0;
+  uint16_t div = 1;
+  while (step < JPG_SCALE_8X && width / (div * 2) >= PREVIEW_TARGET_WIDTH) {
+    div *= 2;
+    step++;
+  }
+  *divisor = div;
+  return (jpg_scale_t)step;
+}
+
+static bool ensure_rgb_buf(size_t len) {
+  if (rgb_capacity >= len) {
+    return true;
+  }
+  free(rgb_buf);
+  rgb_buf = (uint8_t *)(psramFound() ? ps_malloc(len) : malloc(len));
+  rgb_capacity = rgb_buf ? len : 0;
+  return rgb_buf != nullptr;
+}
+
+// Downscale one full frame and publish it on the preview profile
+static void make_preview(frame_t *src) {
+  uint16_t div = 1;
+  jpg_scale_t scale = pick_scale(src->width, &div);
+  uint16_t width = src->width / div;
+  uint16_t height = src->height / div;
+  struct timeval timestamp = src->timestamp;
+
+  bool decoded = ensure_rgb_buf((size_t)width * height * 2) &&
+                 jpg2rgb565(src->buf, src->len, rgb_buf, scale);
+  frame_pipeline_release(src);
+  if (!decoded) {
+    log_e("Preview decode failed");
+    return;
+  }
+
+  frame_t *frame = frame_pipeline_alloc_slot();
+  if (!frame) {
+    return;
+  }
+  frame->timestamp = timestamp;
+  frame->width = width;
+  frame->height = height;
+  if (frame_pipeline_encode(&preview_encoder, frame, rgb_buf, (size_t)width * height * 2, width, height,
+                            PIXFORMAT_RGB565, PREVIEW_JPEG_QUALITY)) {
+    frame_pipeline_publish(frame, FRAME_PROFILE_PREVIEW);
+  } else {
+    log_e("Preview encode failed");
+    frame_pipeline_discard(frame);
+  }
+}
+
+static void preview_task_fn(void *arg) {
+  (void)arg;
+  int sub = -1;
+
+  while (true) {
+    if (frame_pipeline_subscriber_count(FRAME_PROFILE_PREVIEW) == 0) {
+      // No preview viewers: stop pulling full frames and sleep until one arrives
+      if (sub >= 0) {
+        frame_pipeline_unsubscribe(sub);
+        sub = -1;
+        jpeg_encoder_deinit(&preview_encoder);
+      }
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
+    }
+
+    if (sub < 0) {
+      sub = frame_pipeline_subscribe(FRAME_PROFILE_FULL);
+      if (sub < 0) {
+        vTaskDelay(PREVIEW_WAIT_TIMEOUT_MS / portTICK_PERIOD_MS);
+        continue;
+      }
+    }
+
+    frame_t *src = frame_pipeline_wait(sub, PREVIEW_WAIT_TIMEOUT_MS);
+    if (src) {
+      make_preview(src);
+    }
+  }
+}
+
+bool preview_stage_start() {
+  if (preview_task != nullptr) {
+    return true;
+  }
+
+  jpeg_encoder_init(&preview_encoder, JPEG_BACKEND_DEFAULT);
+  if (xTaskCreatePinnedToCore(preview_task_fn, "cam_preview", PREVIEW_TASK_STACK, nullptr,
+                              PREVIEW_TASK_PRIORITY, &preview_task, HTTPD_TASK_CORE) != pdPASS) {
+    log_e("Failed to create preview task");
+    preview_task = nullptr;
+    return false;
+  }
+
+  frame_pipeline_set_producer(FRAME_PROFILE_PREVIEW, preview_task);
+  return true;
+}
@@ -0,0 +1,14 @@
+#ifndef PREVIEW_STAGE_H
+#define PREVIEW_STAGE_H
+
+//
+// Preview pipeline stage
+//
+// Subscribes to full-resolution frames while anyone is watching the preview
+// profile, downscales them during JPEG decode and publishes a re-encoded
+// low-resolution frame on FRAME_PROFILE_PREVIEW.
+//
+
+bool preview_stage_start();
+
+#endif  // PREVIEW_STAGE_H
@@ -0,0 +1,234 @@
+#include "rate_control.h"
+#include "board_config.h"
+
+#if RATE_CONTROL
+
+#include "esp_camera.h"
+#include "esp_timer.h"
+#include "camera_board.h"
+#include "frame_pipeline.h"
+#include "settings.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#endif
+
+static const uint8_t QUALITY_MIN =
+  RATE_QUALITY_MIN > CAMERA_SENSOR_DESC.min_quality ? RATE_QUALITY_MIN : CAMERA_SENSOR_DESC.min_quality;
+static const uint8_t QUALITY_MAX = RATE_QUALITY_MAX;
+static_assert(RATE_QUALITY_MAX <= 63 && RATE_QUALITY_MAX > CAMERA_SENSOR_DESC.min_quality,
+              "RATE_QUALITY_MAX out of range");
+
+static SemaphoreHandle_t rate_lock = nullptr;
+static portMUX_TYPE rate_init_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Guarded by rate_lock
+static rate_status_t rate = {RATE_MODE_OFF, 0, 0, 0, 0, RATE_DECISION_IDLE, 0};
+static int64_t window_start_us = 0;
+static uint64_t window_bytes = 0;
+static uint64_t window_send_us = 0;
+static uint32_t window_parts = 0;
+static uint32_t window_streams = 0;
+
+static bool ensure_lock() {
+  if (rate_lock) {
+    return true;
+  }
+  SemaphoreHandle_t lock = xSemaphoreCreateMutex();
+  if (!lock) {
+    return false;
+  }
+  portENTER_CRITICAL(&rate_init_mux);
+  if (!rate_lock) {
+    rate_lock = lock;
+    lock = nullptr;
+  }
+  portEXIT_CRITICAL(&rate_init_mux);
+  if (lock) {
+    vSemaphoreDelete(lock);
+  }
+  return true;
+}
+
+static void reset_window(int64_t now) {
+  window_start_us = now;
+  window_bytes = 0;
+  window_send_us = 0;
+  window_parts = 0;
+  window_streams = 0;
+}
+
+// One control step over the finished window (rate_lock held). Runs on a sender
+// task, so it never waits for the sensor: while /control holds it the step is
+// skipped and the next window decides.
+static void step(int64_t now) {
+  sensor_t *s = esp_camera_sensor_get();
+  int64_t elapsed_us = now - window_start_us;
+  if (!s || window_parts == 0 || elapsed_us <= 0) {
+    rate.decision = RATE_DECISION_IDLE;
+    return;
+  }
+
+  uint32_t streams = window_streams ? window_streams : 1;
+  rate.kbps = (uint32_t)(window_bytes * 8000 / (uint64_t)elapsed_us / streams);
+  rate.send_us = (uint32_t)(window_send_us / window_parts);
+
+  // Load relative to the target, in per mille
+  uint32_t load;
+  if (rate.mode == RATE_MODE_BITRATE) {
+    load = rate.kbps * 1000 / rate.target;
+  } else {
+    // Leave a fifth of each frame period for capture and pacing
+    uint32_t budget_us = 800000 / rate.target;
+    load = (uint32_t)((uint64_t)rate.send_us * 1000 / budget_us);
+  }
+
+  if (!frame_pipeline_sensor_lock(0)) {
+    return;
+  }
+  int quality = s->status.quality;
+  int next = quality;
+  if (load > 1100) {
+    next += load > 1500 ? 3 : 1;
+    rate.decision = RATE_DECISION_COMPRESS;
+  } else if (load < 750) {
+    next -= 1;
+    rate.decision = RATE_DECISION_RELAX;
+  } else {
+    rate.decision = RATE_DECISION_HOLD;
+  }
+  if (next < QUALITY_MIN) {
+    next = QUALITY_MIN;
+  } else if (next > QUALITY_MAX) {
+    next = QUALITY_MAX;
+  }
+
+  if (next == quality) {
+    if (rate.decision != RATE_DECISION_HOLD) {
+      rate.decision = RATE_DECISION_LIMIT;
+    }
+  } else if (s->set_quality(s, next) == 0) {
+    rate.changes++;
+    log_d("Rate control: %u kbps, %u us/part, load %u, quality %d -> %d", rate.kbps,
+          rate.send_us, load, quality, next);
+  }
+  rate.quality = s->status.quality;
+  frame_pipeline_sensor_unlock();
+}
+
+void rate_control_observe(size_t len, uint32_t send_us, uint32_t streams) {
+  if (!rate_lock) {
+    return;
+  }
+
+  int64_t now = esp_timer_get_time();
+  xSemaphoreTake(rate_lock, portMAX_DELAY);
+  if (rate.mode != RATE_MODE_OFF) {
+    if (window_start_us == 0) {
+      reset_window(now);
+    }
+    window_bytes += len;
+    window_send_us += send_us;
+    window_parts++;
+    if (streams > window_streams) {
+      window_streams = streams;
+    }
+    if (now - window_start_us >= (int64_t)RATE_CONTROL_INTERVAL_MS * 1000) {
+      step(now);
+      reset_window(now);
+    }
+  }
+  xSemaphoreGive(rate_lock);
+}
+
+void rate_control_set(rate_mode_t mode, uint16_t target) {
+  if (!ensure_lock()) {
+    return;
+  }
+  if (target == 0) {
+    mode = RATE_MODE_OFF;
+  }
+
+  xSemaphoreTake(rate_lock, portMAX_DELAY);
+  bool was_on = rate.mode != RATE_MODE_OFF;
+  rate.mode = mode;
+  rate.target = mode == RATE_MODE_OFF ? 0 : target;
+  rate.decision = RATE_DECISION_IDLE;
+  window_start_us = 0;
+  xSemaphoreGive(rate_lock);
+  log_i("Rate control %s (target %u)", rate_mode_name(mode), target);
+
+  // Hand the sensor back at the user's quality, not wherever the last step left it
+  sensor_t *s = esp_camera_sensor_get();
+  if (was_on && mode == RATE_MODE_OFF && s) {
+    if (frame_pipeline_sensor_lock(1000)) {
+      if (s->status.quality != camera_settings.quality) {
+        s->set_quality(s, camera_settings.quality);
+        log_i("Quality restored to %u", camera_settings.quality);
+      }
+      frame_pipeline_sensor_unlock();
+    } else {
+      log_w("Sensor busy, quality %u not restored", camera_settings.quality);
+    }
+  }
+}
+
+void rate_control_restart() {
+  if (!rate_lock) {
+    return;
+  }
+  xSemaphoreTake(rate_lock, portMAX_DELAY);
+  window_start_us = 0;
+  rate.decision = RATE_DECISION_IDLE;
+  xSemaphoreGive(rate_lock);
+}
+
+void rate_control_get_status(rate_status_t *status) {
+  if (!ensure_lock()) {
+    *status = rate;
+    return;
+  }
+  xSemaphoreTake(rate_lock, portMAX_DELAY);
+  *status = rate;
+  // A window with no traffic never reaches step(); report it as idle
+  if (status->mode != RATE_MODE_OFF && window_start_us != 0 &&
+      esp_timer_get_time() - window_start_us > 2 * (int64_t)RATE_CONTROL_INTERVAL_MS * 1000) {
+    status->decision = RATE_DECISION_IDLE;
+  }
+  xSemaphoreGive(rate_lock);
+  sensor_t *s = esp_camera_sensor_get();
+  if (s) {
+    status->quality = s->status.quality;
+  }
+}
+
+const char *rate_mode_name(rate_mode_t mode) {
+  switch (mode) {
+    case RATE_MODE_BITRATE:
+      return "bitrate";
+    case RATE_MODE_FPS:
+      return "fps";
+    default:
+      return "off";
+  }
+}
+
+const char *rate_decision_name(rate_decision_t decision) {
+  switch (decision) {
+    case RATE_DECISION_HOLD:
+      return "hold";
+    case RATE_DECISION_COMPRESS:
+      return "compress";
+    case RATE_DECISION_RELAX:
+      return "relax";
+    case RATE_DECISION_LIMIT:
+      return "limit";
+    default:
+      return "idle";
+  }
+}
+
+#endif  // RATE_CONTROL
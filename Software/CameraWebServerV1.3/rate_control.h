@@ -0,0 +1,59 @@
+#ifndef RATE_CONTROL_H
+#define RATE_CONTROL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+//
+// Closed-loop JPEG quality controller
+//
+// Stream senders report every part they write (size and send time). Once per
+// RATE_CONTROL_INTERVAL_MS the window is compared with the target and the
+// sensor's JPEG quality is nudged within [RATE_QUALITY_MIN, RATE_QUALITY_MAX]:
+//   bitrate mode: per-stream kbit/s against rate_kbps
+//   fps mode:     mean send time against the frame budget at rate_fps
+// Over target by more than 10% raises the quality number (smaller frames), in
+// bigger steps when far over; under by 25% lowers it again by one. The band in
+// between holds, so the quality settles instead of oscillating.
+//
+// A quality set through /control while the controller is on is not rejected:
+// it becomes the controller's starting point, with a fresh window measured at
+// that quality before the next step. Turning the controller off puts the
+// user's quality (camera_settings.quality) back on the sensor.
+//
+
+typedef enum {
+  RATE_MODE_OFF = 0,
+  RATE_MODE_BITRATE,
+  RATE_MODE_FPS,
+} rate_mode_t;
+
+typedef enum {
+  RATE_DECISION_IDLE = 0, // Off, or no stream traffic in the last window
+  RATE_DECISION_HOLD,     // Within the dead band
+  RATE_DECISION_COMPRESS, // Quality number raised
+  RATE_DECISION_RELAX,    // Quality number lowered
+  RATE_DECISION_LIMIT,    // Wanted to move but sits at a bound
+} rate_decision_t;
+
+typedef struct {
+  rate_mode_t mode;
+  uint16_t target;        // kbit/s or frames per second, by mode
+  uint32_t kbps;          // Per-stream bitrate over the last window
+  uint32_t send_us;       // Mean part send time over the last window
+  uint8_t quality;        // Sensor quality after the last decision
+  rate_decision_t decision;
+  uint32_t changes;       // Quality changes made since boot
+} rate_status_t;
+
+void rate_control_set(rate_mode_t mode, uint16_t target);
+// The user just set the quality: discard the window measured at the old one
+void rate_control_restart();
+void rate_control_get_status(rate_status_t *status);
+const char *rate_decision_name(rate_decision_t decision);
+const char *rate_mode_name(rate_mode_t mode);
+
+// Called by each stream sender after writing a part; streams = open sessions
+void rate_control_observe(size_t len, uint32_t send_us, uint32_t streams);
+
+#endif  // RATE_CONTROL_H
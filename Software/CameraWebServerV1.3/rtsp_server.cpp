@@ -0,0 +1,740 @@
+#include "rtsp_server.h"
+#include "board_config.h"
+
+#if RTSP_SERVER
+
+#include "frame_pipeline.h"
+#include "metrics.h"
+#include "power_idle.h"
+#include "wifi_link.h"
+#include "esp_timer.h"
+#include "lwip/sockets.h"
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#endif
+
+#define RTP_PT_JPEG      26
+#define RTP_HEADER_LEN   12
+#define RTP_JPEG_HDR_LEN 8
+#define RTP_RST_HDR_LEN  4
+#define RTP_QT_HDR_LEN   4
+
+// Largest dimension the 8-bit width/8, height/8 fields can describe
+#define RTP_JPEG_MAX_DIM 2040
+
+static const size_t RX_BUFFER = 1024;
+static const size_t URL_MAX = 160;
+static const uint32_t TX_FRAME_WAIT_MS = 100;
+static const uint32_t TX_STOP_TIMEOUT_MS = 2000;
+static const uint32_t SELECT_INTERVAL_MS = 200;
+static const uint32_t RTSP_TASK_STACK = 6144;
+
+// Baseline JPEG as RFC 2435 wants it: two 8-bit quantisation tables and the
+// entropy-coded scan, everything else is rebuilt by the receiver
+typedef struct {
+  const uint8_t *scan;
+  size_t scan_len;
+  const uint8_t *qt[2];
+  uint16_t width;
+  uint16_t height;
+  uint8_t type;          // 0: 4:2:2, 1: 4:2:0, +64 with restart markers
+  uint16_t restart_interval;
+} rtp_jpeg_t;
+
+typedef struct {
+  int fd;                    // RTSP control connection, -1 when the slot is free
+  char rx[RX_BUFFER];
+  size_t rx_len;
+  char url[URL_MAX];         // Request URL of the last DESCRIBE/SETUP
+  uint32_t session_id;       // 0 until SETUP
+  int rtp_fd;                // UDP socket on the slot's server port, -1 until SETUP
+  int rtcp_fd;               // Server port + 1, receives the client's RTCP reports
+  struct sockaddr_in dest;   // Client RTP address
+  uint16_t server_port;
+  uint32_t ssrc;
+  uint16_t seq;              // Next RTP sequence number (sender task while playing)
+  int64_t last_seen_us;      // Last request on the control connection
+  TaskHandle_t tx_task;      // Sender task while playing or still stopping
+  SemaphoreHandle_t tx_done; // Given by the sender task as it exits
+  bool stop;                 // Ask the sender task to exit
+} rtsp_client_t;
+
+static int listen_fd = -1;
+static TaskHandle_t rtsp_task = nullptr;
+static rtsp_client_t clients[RTSP_MAX_SESSIONS];
+
+static uint8_t stat_sessions = 0;
+static uint32_t stat_frames = 0;
+static uint32_t stat_packets = 0;
+static uint32_t stat_skipped = 0;
+
+// Pick the tables, dimensions and scan out of a baseline JPEG
+static bool parse_jpeg(const uint8_t *buf, size_t len, rtp_jpeg_t *out) {
+  memset(out, 0, sizeof(*out));
+  if (len < 4 || buf[0] != 0xFF || buf[1] != 0xD8) {
+    return false;
+  }
+
+  bool have_sof = false;
+  size_t pos = 2;
+  while (pos + 4 <= len) {
+    if (buf[pos] != 0xFF) {
+      return false;
+    }
+    uint8_t marker = buf[pos + 1];
+    if (marker == 0xFF) {
+      pos++; // Fill byte
+      continue;
+    }
+    size_t seg_len = (buf[pos + 2] << 8) | buf[pos + 3];
+    if (seg_len < 2 || pos + 2 + seg_len > len) {
+      return false;
+    }
+    const uint8_t *seg = buf + pos + 4;
+    size_t body = seg_len - 2;
+
+    switch (marker) {
+      case 0xDB: // DQT: one or more tables
+        for (size_t i = 0; i + 65 <= body; i += 65) {
+          uint8_t pq_tq = seg[i];
+          if ((pq_tq >> 4) != 0 || (pq_tq & 0x0F) > 1) {
+            return false; // 16-bit tables or ids RFC 2435 has no slot for
+          }
+          out->qt[pq_tq & 0x0F] = seg + i + 1;
+        }
+        break;
+      case 0xC0: // SOF0: baseline, Y + Cb + Cr
+        if (body < 15 || seg[5] != 3 || seg[8] != 0 || seg[10] != 0x11 || seg[13] != 0x11) {
+          return false;
+        }
+        out->height = (seg[1] << 8) | seg[2];
+        out->width = (seg[3] << 8) | seg[4];
+        if (seg[7] == 0x21) {
+          out->type = 0;
+        } else if (seg[7] == 0x22) {
+          out->type = 1;
+        } else {
+          return false;
+        }
+        have_sof = true;
+        break;
+      case 0xC1: case 0xC2: case 0xC3: case 0xC5: case 0xC6: case 0xC7:
+      case 0xC9: case 0xCA: case 0xCB: case 0xCD: case 0xCE: case 0xCF:
+        return false; // Extended, progressive, lossless or arithmetic
+      case 0xDD: // DRI
+        if (body >= 2) {
+          out->restart_interval = (seg[0] << 8) | seg[1];
+        }
+        break;
+      case 0xDA: { // SOS: the scan runs up to the EOI, which may be followed by padding
+        size_t start = pos + 2 + seg_len;
+        size_t floor = len - start > 64 ? len - 64 : start;
+        size_t end = len;
+        while (end >= floor + 2 && !(buf[end - 2] == 0xFF && buf[end - 1] == 0xD9)) {
+          end--;
+        }
+        end = end >= floor + 2 ? end - 2 : len;
+        out->scan = buf + start;
+        out->scan_len = end - start;
+        if (out->restart_interval) {
+          out->type += 64;
+        }
+        return have_sof && out->qt[0] && out->qt[1] && out->scan_len > 0;
+      }
+      default:
+        break;
+    }
+    pos += 2 + seg_len;
+  }
+  return false;
+}
+
+// Split one frame into RTP packets; tables ride in the first one
+static void send_frame(rtsp_client_t *c, const frame_t *frame, const rtp_jpeg_t *jpeg) {
+  uint32_t rtp_ts = (uint32_t)((uint64_t)frame->timestamp.tv_sec * 90000 +
+                               (uint64_t)frame->timestamp.tv_usec * 9 / 100);
+  uint8_t header[RTP_HEADER_LEN + RTP_JPEG_HDR_LEN + RTP_RST_HDR_LEN + RTP_QT_HDR_LEN];
+  size_t offset = 0;
+
+  while (offset < jpeg->scan_len) {
+    bool first = offset == 0;
+    size_t hlen = RTP_HEADER_LEN + RTP_JPEG_HDR_LEN + (jpeg->type >= 64 ? RTP_RST_HDR_LEN : 0);
+    size_t tables = first ? RTP_QT_HDR_LEN + 128 : 0;
+    size_t chunk = RTSP_RTP_PAYLOAD - (hlen - RTP_HEADER_LEN) - tables;
+    if (chunk > jpeg->scan_len - offset) {
+      chunk = jpeg->scan_len - offset;
+    }
+    bool last = offset + chunk == jpeg->scan_len;
+
+    uint8_t *h = header;
+    h[0] = 0x80; // V=2
+    h[1] = RTP_PT_JPEG | (last ? 0x80 : 0);
+    h[2] = c->seq >> 8;
+    h[3] = c->seq & 0xFF;
+    h[4] = rtp_ts >> 24;
+    h[5] = rtp_ts >> 16;
+    h[6] = rtp_ts >> 8;
+    h[7] = rtp_ts;
+    h[8] = c->ssrc >> 24;
+    h[9] = c->ssrc >> 16;
+    h[10] = c->ssrc >> 8;
+    h[11] = c->ssrc;
+    h += RTP_HEADER_LEN;
+    h[0] = 0; // Type-specific
+    h[1] = offset >> 16;
+    h[2] = offset >> 8;
+    h[3] = offset;
+    h[4] = jpeg->type;
+    h[5] = 255; // Tables in-band with every frame
+    h[6] = jpeg->width / 8;
+    h[7] = jpeg->height / 8;
+    h += RTP_JPEG_HDR_LEN;
+    if (jpeg->type >= 64) {
+      // Whole scan in restart intervals: F = L = 1, count 0x3FFF
+      h[0] = jpeg->restart_interval >> 8;
+      h[1] = jpeg->restart_interval;
+      h[2] = 0xFF;
+      h[3] = 0xFF;
+      h += RTP_RST_HDR_LEN;
+    }
+    if (first) {
+      h[0] = 0;   // MBZ
+      h[1] = 0;   // 8-bit tables
+      h[2] = 0;
+      h[3] = 128; // Luma + chroma
+      h += RTP_QT_HDR_LEN;
+    }
+
+    struct iovec iov[4];
+    int iovcnt = 0;
+    iov[iovcnt].iov_base = header;
+    iov[iovcnt++].iov_len = h - header;
+    if (first) {
+      iov[iovcnt].iov_base = (void *)jpeg->qt[0];
+      iov[iovcnt++].iov_len = 64;
+      iov[iovcnt].iov_base = (void *)jpeg->qt[1];
+      iov[iovcnt++].iov_len = 64;
+    }
+    iov[iovcnt].iov_base = (void *)(jpeg->scan + offset);
+    iov[iovcnt++].iov_len = chunk;
+
+    struct msghdr msg = {};
+    msg.msg_name = &c->dest;
+    msg.msg_namelen = sizeof(c->dest);
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovcnt;
+    ssize_t sent = sendmsg(c->rtp_fd, &msg, 0);
+    if (sent < 0 && errno == ENOMEM) {
+      // Wi-Fi TX buffers full: give the driver a tick, then try once more
+      vTaskDelay(1);
+      sent = sendmsg(c->rtp_fd, &msg, 0);
+    }
+    c->seq++;
+    if (sent < 0) {
+      // UDP is best effort; the receiver drops the incomplete frame
+      log_d("RTP send failed (errno %d), frame truncated", errno);
+      return;
+    }
+    __atomic_fetch_add(&stat_packets, 1, __ATOMIC_RELAXED);
+    offset += chunk;
+  }
+  __atomic_fetch_add(&stat_frames, 1, __ATOMIC_RELAXED);
+  metrics_inc(METRIC_FRAMES_SENT);
+}
+
+static void tx_task_fn(void *arg) {
+  rtsp_client_t *c = (rtsp_client_t *)arg;
+  int sub = frame_pipeline_subscribe(FRAME_PROFILE_FULL);
+  bool warned = false;
+  if (sub < 0) {
+    log_e("RTSP: no pipeline subscriber slot");
+  }
+
+  while (sub >= 0 && !__atomic_load_n(&c->stop, __ATOMIC_ACQUIRE)) {
+    frame_t *frame = frame_pipeline_wait(sub, TX_FRAME_WAIT_MS);
+    if (!frame) {
+      continue;
+    }
+    // Nothing to send into while Wi-Fi reconnects
+    if (wifi_link_up()) {
+      rtp_jpeg_t jpeg;
+      if (parse_jpeg(frame->buf, frame->len, &jpeg) && jpeg.width <= RTP_JPEG_MAX_DIM &&
+          jpeg.height <= RTP_JPEG_MAX_DIM) {
+        send_frame(c, frame, &jpeg);
+      } else {
+        __atomic_fetch_add(&stat_skipped, 1, __ATOMIC_RELAXED);
+        if (!warned) {
+          log_w("RTSP: %ux%u frame cannot be sent as RTP/JPEG, skipping", frame->width,
+                frame->height);
+          warned = true;
+        }
+      }
+    }
+    frame_pipeline_release(frame);
+  }
+
+  if (sub >= 0) {
+    frame_pipeline_unsubscribe(sub);
+  }
+  xSemaphoreGive(c->tx_done);
+  vTaskDelete(NULL);
+}
+
+// Sender asked to stop but not yet gone: it may still be inside sendmsg() on
+// rtp_fd, so the socket and the slot stay reserved until tx_done arrives
+static bool stopping(const rtsp_client_t *c) {
+  return c->tx_task && __atomic_load_n(&c->stop, __ATOMIC_ACQUIRE);
+}
+
+// Finish a session once its sender has exited; false while it is still running
+static bool release_session(rtsp_client_t *c, TickType_t wait) {
+  if (c->tx_task) {
+    if (xSemaphoreTake(c->tx_done, wait) != pdTRUE) {
+      return false;
+    }
+    c->tx_task = nullptr;
+    __atomic_fetch_sub(&stat_sessions, 1, __ATOMIC_RELAXED);
+  }
+  if (c->rtp_fd >= 0) {
+    close(c->rtp_fd);
+    c->rtp_fd = -1;
+  }
+  if (c->rtcp_fd >= 0) {
+    close(c->rtcp_fd);
+    c->rtcp_fd = -1;
+  }
+  c->session_id = 0;
+  return true;
+}
+
+static void close_session(rtsp_client_t *c) {
+  if (c->tx_task) {
+    __atomic_store_n(&c->stop, true, __ATOMIC_RELEASE);
+  }
+  if (!release_session(c, pdMS_TO_TICKS(TX_STOP_TIMEOUT_MS))) {
+    // The RTSP task sweeps it up once the sender gives tx_done
+    log_w("RTSP sender still stopping, deferring session teardown");
+  }
+}
+
+static void close_client(rtsp_client_t *c) {
+  close_session(c);
+  if (c->fd >= 0) {
+    close(c->fd);
+    c->fd = -1;
+  }
+  c->rx_len = 0;
+  log_i("RTSP client disconnected");
+}
+
+static bool send_all(int fd, const char *data, size_t len) {
+  while (len > 0) {
+    ssize_t sent = send(fd, data, len, 0);
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += sent;
+    len -= sent;
+  }
+  return true;
+}
+
+static void respond(rtsp_client_t *c, const char *status, int cseq, const char *headers,
+                    const char *body) {
+  char buf[768];
+  size_t body_len = body ? strlen(body) : 0;
+  int len = snprintf(buf, sizeof(buf), "RTSP/1.0 %s\r\nCSeq: %d\r\n%s", status, cseq,
+                     headers ? headers : "");
+  if (body_len) {
+    len += snprintf(buf + len, sizeof(buf) - len, "Content-Length: %u\r\n",
+                    (unsigned)body_len);
+  }
+  len += snprintf(buf + len, sizeof(buf) - len, "\r\n");
+  if (len >= (int)sizeof(buf) || !send_all(c->fd, buf, len) ||
+      (body_len && !send_all(c->fd, body, body_len))) {
+    log_w("RTSP response not sent");
+  }
+}
+
+// Value of a request header, or NULL; matched case-insensitively at line starts
+static const char *find_header(const char *req, const char *name, char *value, size_t size) {
+  size_t name_len = strlen(name);
+  for (const char *line = strstr(req, "\r\n"); line; line = strstr(line, "\r\n")) {
+    line += 2;
+    if (strncasecmp(line, name, name_len) == 0 && line[name_len] == ':') {
+      const char *v = line + name_len + 1;
+      while (*v == ' ') {
+        v++;
+      }
+      size_t n = strcspn(v, "\r\n");
+      if (n >= size) {
+        n = size - 1;
+      }
+      memcpy(value, v, n);
+      value[n] = '\0';
+      return value;
+    }
+  }
+  return nullptr;
+}
+
+static void local_ip(int fd, char *out, size_t size) {
+  struct sockaddr_in addr = {};
+  socklen_t len = sizeof(addr);
+  if (getsockname(fd, (struct sockaddr *)&addr, &len) != 0 ||
+      !inet_ntop(AF_INET, &addr.sin_addr, out, size)) {
+    snprintf(out, size, "0.0.0.0");
+  }
+}
+
+static void handle_describe(rtsp_client_t *c, int cseq) {
+  char ip[16];
+  local_ip(c->fd, ip, sizeof(ip));
+
+  char sdp[320];
+  snprintf(sdp, sizeof(sdp),
+           "v=0\r\n"
+           "o=- %u 1 IN IP4 %s\r\n"
+           "s=" CAMERA_BOARD_NAME "\r\n"
+           "c=IN IP4 0.0.0.0\r\n"
+           "t=0 0\r\n"
+           "a=control:*\r\n"
+           "m=video 0 RTP/AVP %u\r\n"
+           "a=rtpmap:%u JPEG/90000\r\n"
+           "a=control:track1\r\n",
+           (unsigned)esp_random(), ip, RTP_PT_JPEG, RTP_PT_JPEG);
+
+  char headers[256];
+  size_t url_len = strlen(c->url);
+  snprintf(headers, sizeof(headers), "Content-Type: application/sdp\r\nContent-Base: %s%s\r\n",
+           c->url, url_len && c->url[url_len - 1] == '/' ? "" : "/");
+  respond(c, "200 OK", cseq, headers, sdp);
+}
+
+// UDP socket bound to a local port, -1 on failure
+static int bind_udp(uint16_t port) {
+  int fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  struct sockaddr_in bind_addr = {};
+  bind_addr.sin_family = AF_INET;
+  bind_addr.sin_port = htons(port);
+  bind_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (fd >= 0 && bind(fd, (struct sockaddr *)&bind_addr, sizeof(bind_addr)) != 0) {
+    close(fd);
+    fd = -1;
+  }
+  if (fd < 0) {
+    log_e("RTSP: cannot bind UDP port %u (errno %d)", port, errno);
+  }
+  return fd;
+}
+
+static void handle_setup(rtsp_client_t *c, int cseq, const char *req) {
+  char transport[128];
+  if (!find_header(req, "Transport", transport, sizeof(transport)) ||
+      strstr(transport, "RTP/AVP/TCP") || strstr(transport, "multicast")) {
+    respond(c, "461 Unsupported Transport", cseq, nullptr, nullptr);
+    return;
+  }
+  const char *ports = strstr(transport, "client_port=");
+  if (!ports) {
+    respond(c, "461 Unsupported Transport", cseq, nullptr, nullptr);
+    return;
+  }
+  uint16_t client_rtp = (uint16_t)atoi(ports + strlen("client_port="));
+  if (client_rtp == 0) {
+    respond(c, "400 Bad Request", cseq, nullptr, nullptr);
+    return;
+  }
+
+  // Re-SETUP of a running session just updates the destination
+  // Both advertised ports are bound: RTCP receiver reports to port + 1 would
+  // otherwise draw ICMP port-unreachable
+  if (c->rtp_fd < 0) {
+    c->rtp_fd = bind_udp(c->server_port);
+    c->rtcp_fd = c->rtp_fd >= 0 ? bind_udp(c->server_port + 1) : -1;
+    if (c->rtcp_fd < 0) {
+      if (c->rtp_fd >= 0) {
+        close(c->rtp_fd);
+        c->rtp_fd = -1;
+      }
+      respond(c, "500 Internal Server Error", cseq, nullptr, nullptr);
+      return;
+    }
+    c->session_id = esp_random() | 1;
+    c->ssrc = esp_random();
+    c->seq = (uint16_t)esp_random();
+  }
+
+  socklen_t len = sizeof(c->dest);
+  getpeername(c->fd, (struct sockaddr *)&c->dest, &len);
+  c->dest.sin_port = htons(client_rtp);
+
+  char headers[256];
+  snprintf(headers, sizeof(headers),
+           "Transport: RTP/AVP;unicast;client_port=%u-%u;server_port=%u-%u;ssrc=%08X\r\n"
+           "Session: %08X;timeout=%u\r\n",
+           client_rtp, client_rtp + 1, c->server_port, c->server_port + 1, (unsigned)c->ssrc,
+           (unsigned)c->session_id, RTSP_SESSION_TIMEOUT_S);
+  respond(c, "200 OK", cseq, headers, nullptr);
+}
+
+static void handle_play(rtsp_client_t *c, int cseq) {
+  if (c->rtp_fd < 0) {
+    respond(c, "455 Method Not Valid in This State", cseq, nullptr, nullptr);
+    return;
+  }
+
+  uint16_t first_seq = c->seq;
+  if (!c->tx_task) {
+#if IDLE_POWER_SAVE
+    power_idle_touch();
+#endif
+    __atomic_store_n(&c->stop, false, __ATOMIC_RELEASE);
+    if (xTaskCreatePinnedToCore(tx_task_fn, "rtsp_tx", STREAM_SENDER_STACK, c,
+                                STREAM_SENDER_PRIORITY, &c->tx_task, HTTPD_TASK_CORE) != pdPASS) {
+      log_e("Failed to create RTSP sender task");
+      c->tx_task = nullptr;
+      respond(c, "500 Internal Server Error", cseq, nullptr, nullptr);
+      return;
+    }
+    __atomic_fetch_add(&stat_sessions, 1, __ATOMIC_RELAXED);
+    log_i("RTSP session %08X playing to %s:%u", (unsigned)c->session_id,
+          inet_ntoa(c->dest.sin_addr), ntohs(c->dest.sin_port));
+  }
+
+  char headers[256];
+  snprintf(headers, sizeof(headers),
+           "Session: %08X;timeout=%u\r\nRange: npt=0.000-\r\nRTP-Info: url=%s;seq=%u\r\n",
+           (unsigned)c->session_id, RTSP_SESSION_TIMEOUT_S, c->url, first_seq);
+  respond(c, "200 OK", cseq, headers, nullptr);
+}
+
+static void handle_request(rtsp_client_t *c, const char *req) {
+  char method[16];
+  char url[URL_MAX];
+  if (sscanf(req, "%15s %159s RTSP/1.0", method, url) != 2) {
+    respond(c, "400 Bad Request", 0, nullptr, nullptr);
+    return;
+  }
+  char value[64];
+  int cseq = find_header(req, "CSeq", value, sizeof(value)) ? atoi(value) : 0;
+  c->last_seen_us = esp_timer_get_time();
+
+  // Requests after SETUP must name this session
+  if (c->session_id && strcasecmp(method, "OPTIONS") != 0 &&
+      find_header(req, "Session", value, sizeof(value)) &&
+      strtoul(value, nullptr, 16) != c->session_id) {
+    respond(c, "454 Session Not Found", cseq, nullptr, nullptr);
+    return;
+  }
+
+  if (stopping(c) && (strcasecmp(method, "SETUP") == 0 || strcasecmp(method, "PLAY") == 0)) {
+    respond(c, "503 Service Unavailable", cseq, nullptr, nullptr);
+  } else if (strcasecmp(method, "OPTIONS") == 0) {
+    respond(c, "200 OK", cseq, "Public: OPTIONS, DESCRIBE, SETUP, PLAY, TEARDOWN, GET_PARAMETER\r\n",
+            nullptr);
+  } else if (strcasecmp(method, "DESCRIBE") == 0) {
+    strcpy(c->url, url);
+    handle_describe(c, cseq);
+  } else if (strcasecmp(method, "SETUP") == 0) {
+    handle_setup(c, cseq, req);
+  } else if (strcasecmp(method, "PLAY") == 0) {
+    if (!c->url[0]) {
+      strcpy(c->url, url);
+    }
+    handle_play(c, cseq);
+  } else if (strcasecmp(method, "TEARDOWN") == 0) {
+    close_session(c);
+    respond(c, "200 OK", cseq, nullptr, nullptr);
+  } else if (strcasecmp(method, "GET_PARAMETER") == 0 || strcasecmp(method, "SET_PARAMETER") == 0) {
+    respond(c, "200 OK", cseq, nullptr, nullptr);
+  } else {
+    respond(c, "501 Not Implemented", cseq, nullptr, nullptr);
+  }
+}
+
+// Read what arrived and handle every complete request in the buffer
+static void read_client(rtsp_client_t *c) {
+  ssize_t n = recv(c->fd, c->rx + c->rx_len, sizeof(c->rx) - 1 - c->rx_len, 0);
+  if (n <= 0) {
+    close_client(c);
+    return;
+  }
+  c->rx_len += n;
+  c->rx[c->rx_len] = '\0';
+
+  char *end;
+  while (c->fd >= 0 && (end = strstr(c->rx, "\r\n\r\n")) != nullptr) {
+    size_t head_len = end + 4 - c->rx;
+    char value[16];
+    end[2] = '\0'; // Keep the last header's CRLF for find_header
+    size_t body_len = find_header(c->rx, "Content-Length", value, sizeof(value)) ? atoi(value) : 0;
+    if (head_len + body_len > c->rx_len) {
+      end[2] = '\r';
+      break; // Body (GET_PARAMETER) still on its way
+    }
+    handle_request(c, c->rx);
+    if (c->fd < 0) {
+      return;
+    }
+    size_t used = head_len + body_len;
+    memmove(c->rx, c->rx + used, c->rx_len - used + 1);
+    c->rx_len -= used;
+  }
+
+  if (c->rx_len == sizeof(c->rx) - 1) {
+    log_w("RTSP request too large, closing");
+    close_client(c);
+  }
+}
+
+// Receiver reports are not parsed, but they prove the player is still there:
+// players that send no RTSP keep-alive are not timed out while they report
+static void drain_rtcp(rtsp_client_t *c) {
+  uint8_t report[256];
+  while (recv(c->rtcp_fd, report, sizeof(report), MSG_DONTWAIT) > 0) {
+    c->last_seen_us = esp_timer_get_time();
+  }
+}
+
+static void accept_client() {
+  struct sockaddr_in addr;
+  socklen_t len = sizeof(addr);
+  int fd = accept(listen_fd, (struct sockaddr *)&addr, &len);
+  if (fd < 0) {
+    return;
+  }
+  for (int i = 0; i < RTSP_MAX_SESSIONS; i++) {
+    rtsp_client_t *c = &clients[i];
+    if (c->fd < 0 && !c->tx_task) {
+      c->fd = fd;
+      c->rx_len = 0;
+      c->url[0] = '\0';
+      c->last_seen_us = esp_timer_get_time();
+      log_i("RTSP client %s connected", inet_ntoa(addr.sin_addr));
+      return;
+    }
+  }
+  static const char busy[] = "RTSP/1.0 453 Not Enough Bandwidth\r\n\r\n";
+  send(fd, busy, sizeof(busy) - 1, 0);
+  close(fd);
+  log_w("RTSP session limit (%u) reached", RTSP_MAX_SESSIONS);
+}
+
+static void rtsp_task_fn(void *arg) {
+  for (;;) {
+    fd_set readable;
+    FD_ZERO(&readable);
+    FD_SET(listen_fd, &readable);
+    int max_fd = listen_fd;
+    for (int i = 0; i < RTSP_MAX_SESSIONS; i++) {
+      if (clients[i].fd >= 0) {
+        FD_SET(clients[i].fd, &readable);
+        max_fd = clients[i].fd > max_fd ? clients[i].fd : max_fd;
+      }
+      if (clients[i].fd >= 0 && clients[i].rtcp_fd >= 0) {
+        FD_SET(clients[i].rtcp_fd, &readable);
+        max_fd = clients[i].rtcp_fd > max_fd ? clients[i].rtcp_fd : max_fd;
+      }
+    }
+
+    struct timeval tv = {0, SELECT_INTERVAL_MS * 1000};
+    if (select(max_fd + 1, &readable, nullptr, nullptr, &tv) > 0) {
+      if (FD_ISSET(listen_fd, &readable)) {
+        accept_client();
+      }
+      for (int i = 0; i < RTSP_MAX_SESSIONS; i++) {
+        if (clients[i].fd >= 0 && clients[i].rtcp_fd >= 0 &&
+            FD_ISSET(clients[i].rtcp_fd, &readable)) {
+          drain_rtcp(&clients[i]);
+        }
+        if (clients[i].fd >= 0 && FD_ISSET(clients[i].fd, &readable)) {
+          read_client(&clients[i]);
+        }
+      }
+    }
+
+    // Clients that vanished without closing the connection, set up or not,
+    // and senders whose teardown had to be deferred
+    int64_t now = esp_timer_get_time();
+    for (int i = 0; i < RTSP_MAX_SESSIONS; i++) {
+      rtsp_client_t *c = &clients[i];
+      if (stopping(c)) {
+        release_session(c, 0);
+      }
+      if (c->fd >= 0 && now - c->last_seen_us > (int64_t)RTSP_SESSION_TIMEOUT_S * 1000000) {
+        log_w("RTSP client timed out (session %08X)", (unsigned)c->session_id);
+        close_client(c);
+      }
+    }
+  }
+}
+
+bool rtsp_server_start() {
+  if (rtsp_task) {
+    return true;
+  }
+
+  for (int i = 0; i < RTSP_MAX_SESSIONS; i++) {
+    clients[i].fd = -1;
+    clients[i].rtp_fd = -1;
+    clients[i].rtcp_fd = -1;
+    clients[i].server_port = RTSP_RTP_PORT + 2 * i;
+    clients[i].tx_done = xSemaphoreCreateBinary();
+    if (!clients[i].tx_done) {
+      log_e("Failed to allocate RTSP sessions");
+      return false;
+    }
+  }
+
+  listen_fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(RTSP_PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  int reuse = 1;
+  if (listen_fd < 0 ||
+      setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+      bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(listen_fd, 2) != 0) {
+    log_e("RTSP: cannot listen on port %u (errno %d)", RTSP_PORT, errno);
+    if (listen_fd >= 0) {
+      close(listen_fd);
+      listen_fd = -1;
+    }
+    return false;
+  }
+
+  if (xTaskCreatePinnedToCore(rtsp_task_fn, "rtsp", RTSP_TASK_STACK, nullptr, RTSP_TASK_PRIORITY,
+                              &rtsp_task, HTTPD_TASK_CORE) != pdPASS) {
+    log_e("Failed to create RTSP task");
+    close(listen_fd);
+    listen_fd = -1;
+    rtsp_task = nullptr;
+    return false;
+  }
+  log_i("RTSP server started on port %u (RTP/JPEG over UDP)", RTSP_PORT);
+  return true;
+}
+
+void rtsp_get_status(rtsp_status_t *status) {
+  status->sessions = __atomic_load_n(&stat_sessions, __ATOMIC_RELAXED);
+  status->frames = __atomic_load_n(&stat_frames, __ATOMIC_RELAXED);
+  status->packets = __atomic_load_n(&stat_packets, __ATOMIC_RELAXED);
+  status->skipped = __atomic_load_n(&stat_skipped, __ATOMIC_RELAXED);
+}
+
+#endif  // RTSP_SERVER
@@ -0,0 +1,31 @@
+#ifndef RTSP_SERVER_H
+#define RTSP_SERVER_H
+
+#include <stdint.h>
+
+//
+// RTSP server with RTP/JPEG payloading
+//
+// rtsp://<ip>:RTSP_PORT/<any path> answers OPTIONS, DESCRIBE, SETUP, PLAY,
+// TEARDOWN and GET_PARAMETER (keep-alive) for one track, payload type 26
+// (RFC 2435) over UDP unicast. One task parses every control connection; each
+// playing session gets a sender task subscribed to the full-resolution
+// profile, which splits the scan data of each pipeline frame into RTP packets
+// without re-encoding. The quantisation tables go in-band (Q = 255) with the
+// first packet of every frame, so the receiver needs nothing from the SDP.
+// Both server ports are bound; RTCP reports are drained unparsed and count
+// as session liveness like a keep-alive.
+//
+
+typedef struct {
+  uint8_t sessions;   // Sessions currently playing
+  uint32_t frames;    // Frames sent since boot
+  uint32_t packets;   // RTP packets sent since boot
+  uint32_t skipped;   // Frames RTP/JPEG cannot carry (too large, not baseline)
+} rtsp_status_t;
+
+// Bind RTSP_PORT and start the control task (safe to call more than once)
+bool rtsp_server_start();
+void rtsp_get_status(rtsp_status_t *status);
+
+#endif  // RTSP_SERVER_H
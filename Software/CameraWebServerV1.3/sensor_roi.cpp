@@ -0,0 +1,107 @@
+#include "sensor_roi.h"
+#include "camera_board.h"
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#endif
+
+// Written from the httpd worker (/control) only
+static camera_roi_t current = {ROI_ZOOM_MIN, 500, 500};
+static roi_window_t window = {0, 0, CAMERA_SENSOR_DESC.array_width, CAMERA_SENSOR_DESC.array_height,
+                              ROI_ZOOM_MIN};
+
+static uint32_t clamp_u32(uint32_t v, uint32_t lo, uint32_t hi) {
+  return v < lo ? lo : (v > hi ? hi : v);
+}
+
+// Window for the region at the given output size (array pixels, even-aligned)
+static roi_window_t compute_window(const camera_roi_t *roi, framesize_t size) {
+  const camera_sensor_desc_t &d = CAMERA_SENSOR_DESC;
+  uint32_t out_w = resolution[size].width;
+  uint32_t out_h = resolution[size].height;
+
+  // Largest window with the output's aspect ratio
+  uint32_t full_w = d.array_width;
+  uint32_t full_h = full_w * out_h / out_w;
+  if (full_h > d.array_height) {
+    full_h = d.array_height;
+    full_w = full_h * out_w / out_h;
+  }
+
+  uint32_t w = full_w * 100 / roi->zoom;
+  uint32_t h = full_h * 100 / roi->zoom;
+  if (w < out_w || h < out_h) {
+    // The ISP scales down only
+    w = out_w;
+    h = out_h;
+  }
+  w &= ~1u;
+  h &= ~1u;
+
+  uint32_t cx = (uint32_t)d.array_width * roi->x / 1000;
+  uint32_t cy = (uint32_t)d.array_height * roi->y / 1000;
+  roi_window_t win;
+  win.x = clamp_u32(cx > w / 2 ? cx - w / 2 : 0, 0, d.array_width - w) & ~1u;
+  win.y = clamp_u32(cy > h / 2 ? cy - h / 2 : 0, 0, d.array_height - h) & ~1u;
+  win.w = w;
+  win.h = h;
+  win.zoom = full_w * 100 / w;
+  return win;
+}
+
+// Outputs the driver reads out 2x2 binned
+static bool driver_bins(framesize_t size) {
+  return resolution[size].width <= CAMERA_SENSOR_DESC.array_width / 2 &&
+         resolution[size].height <= CAMERA_SENSOR_DESC.array_height / 2;
+}
+
+static int program(sensor_t *s) {
+  framesize_t size = s->status.framesize;
+  if (!CAMERA_ROI_SUPPORTED || !s->set_res_raw || current.zoom <= ROI_ZOOM_MIN ||
+      driver_bins(size)) {
+    if (current.zoom > ROI_ZOOM_MIN && window.zoom > ROI_ZOOM_MIN) {
+      log_i("ROI not applied at binned %ux%u output", resolution[size].width,
+            resolution[size].height);
+    }
+    window = {0, 0, CAMERA_SENSOR_DESC.array_width, CAMERA_SENSOR_DESC.array_height, ROI_ZOOM_MIN};
+    return 0;
+  }
+
+  const camera_sensor_desc_t &d = CAMERA_SENSOR_DESC;
+  roi_window_t win = compute_window(&current, size);
+  int res = s->set_res_raw(s, win.x, win.y, win.x + win.w + d.margin_x - 1,
+                           win.y + win.h + d.margin_y - 1, d.offset_x, d.offset_y, d.total_x,
+                           d.total_y, resolution[size].width, resolution[size].height,
+                           true, false);  // Unbinned, as the driver runs this size
+  if (res == 0) {
+    window = win;
+    log_i("ROI %ux%u at %u,%u (zoom %u%%)", win.w, win.h, win.x, win.y, win.zoom);
+  }
+  return res;
+}
+
+int roi_set(sensor_t *s, const camera_roi_t *roi) {
+  bool was_zoomed = current.zoom > ROI_ZOOM_MIN;
+  current.zoom = (uint16_t)clamp_u32(roi->zoom, ROI_ZOOM_MIN, ROI_ZOOM_MAX);
+  current.x = (uint16_t)clamp_u32(roi->x, 0, 1000);
+  current.y = (uint16_t)clamp_u32(roi->y, 0, 1000);
+
+  if (current.zoom <= ROI_ZOOM_MIN) {
+    // Back to the driver's own (possibly binned) full-frame window
+    program(s);
+    return was_zoomed ? s->set_framesize(s, s->status.framesize) : 0;
+  }
+  return program(s);
+}
+
+int roi_reapply(sensor_t *s) {
+  return current.zoom > ROI_ZOOM_MIN ? program(s) : 0;
+}
+
+void roi_get(camera_roi_t *roi) {
+  *roi = current;
+}
+
+void roi_get_window(roi_window_t *win) {
+  *win = window;
+}
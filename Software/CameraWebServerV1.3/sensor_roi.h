@@ -0,0 +1,48 @@
+#ifndef SENSOR_ROI_H
+#define SENSOR_ROI_H
+
+#include "esp_camera.h"
+#include <stdint.h>
+
+//
+// Region of interest (digital zoom) by sensor windowing
+//
+// Instead of reading out the whole array and scaling it down to the framesize,
+// the sensor is told via set_res_raw() to read only a window around the chosen
+// centre and scale that to the output size. Zoom 2x at SVGA reads an 1024x768
+// window, so the view is twice as sharp for the same JPEG size. The window
+// keeps the output's aspect ratio and never drops below the output size (the
+// ISP only scales down), which caps the zoom per framesize. Zoom 100 hands the
+// window back to the driver's own framesize setup.
+//
+// The window is always read unbinned. The drivers switch to 2x2 binning for
+// outputs that fit in half the array, and a window programmed without binning
+// in such a mode leaves the sensor's timing and its framesize setup out of
+// step, so those framesizes stay full frame (zoom 100) while the region is
+// kept for the next larger size.
+//
+
+#define ROI_ZOOM_MIN 100   // Percent; 100 = full frame
+#define ROI_ZOOM_MAX 800
+
+typedef struct {
+  uint16_t zoom;   // Percent (ROI_ZOOM_MIN..ROI_ZOOM_MAX)
+  uint16_t x, y;   // Centre in per mille of the array width / height
+} camera_roi_t;
+
+typedef struct {
+  uint16_t x, y, w, h; // Window read out, in array pixels
+  uint16_t zoom;       // Zoom actually applied after the output-size cap
+} roi_window_t;
+
+// Store the region and program the sensor for its current framesize. Call with
+// the frame pipeline suspended; returns 0 or the driver's error.
+int roi_set(sensor_t *s, const camera_roi_t *roi);
+
+// Re-program the stored region after a framesize change (which resets the window)
+int roi_reapply(sensor_t *s);
+
+void roi_get(camera_roi_t *roi);
+void roi_get_window(roi_window_t *window);
+
+#endif  // SENSOR_ROI_H
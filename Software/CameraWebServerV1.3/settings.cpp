@@ -0,0 +1,148 @@
+#include "settings.h"
+#include "board_config.h"
+#include "camera_board.h"
+#include "esp_camera.h"
+#include "sensor_roi.h"
+
+#include <Preferences.h>
+#include <esp32-hal-psram.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#endif
+
+static const char *SETTINGS_NAMESPACE = "camera";
+static const char *SETTINGS_KEY = "settings";
+static const char *WIFI_CACHE_KEY = "wifi";
+
+// Version 1 records end before the ROI fields
+static const size_t SETTINGS_V1_SIZE = offsetof(camera_settings_t, roi_zoom);
+
+static camera_settings_t defaults() {
+  camera_settings_t d;
+  memset(&d, 0, sizeof(d));
+  d.version = SETTINGS_VERSION;
+  d.framesize = CAMERA_SENSOR_DESC.default_framesize;
+  d.quality = psramFound() ? CAMERA_SENSOR_DESC.default_quality : CAMERA_SENSOR_DESC.no_psram_quality;
+  d.adaptive = ADAPTIVE_FPS_DEFAULT;
+  d.motion = MOTION_DEFAULT_ENABLED;
+  d.interval_ms = 0;
+  d.snapshot_max_age = 250;
+  d.roi_zoom = ROI_ZOOM_MIN;
+  d.roi_x = 500;
+  d.roi_y = 500;
+  return d;
+}
+
+camera_settings_t camera_settings;
+
+// Stored copy, to skip flash writes when nothing changed
+static camera_settings_t stored;
+static bool have_stored = false;
+
+bool settings_load() {
+  camera_settings = defaults();
+
+  Preferences prefs;
+  if (!prefs.begin(SETTINGS_NAMESPACE, true)) {
+    return false;
+  }
+  // Fields a shorter (older) record lacks keep their defaults
+  camera_settings_t loaded = camera_settings;
+  size_t stored_len = prefs.getBytesLength(SETTINGS_KEY);
+  size_t len = stored_len == sizeof(loaded) || stored_len == SETTINGS_V1_SIZE
+                   ? prefs.getBytes(SETTINGS_KEY, &loaded, stored_len)
+                   : 0;
+  prefs.end();
+
+  bool current = len == sizeof(loaded) && loaded.version == SETTINGS_VERSION;
+  bool v1 = len == SETTINGS_V1_SIZE && loaded.version == 1;
+  if ((!current && !v1) || loaded.framesize >= FRAMESIZE_INVALID || loaded.quality > 63) {
+    return false;
+  }
+  if (loaded.roi_zoom < ROI_ZOOM_MIN || loaded.roi_zoom > ROI_ZOOM_MAX || loaded.roi_x > 1000 ||
+      loaded.roi_y > 1000) {
+    loaded.roi_zoom = ROI_ZOOM_MIN;
+    loaded.roi_x = 500;
+    loaded.roi_y = 500;
+  }
+  // A record from another board/sensor build may hold a size this one cannot do
+  framesize_t max_size = camera_max_framesize(psramFound());
+  if (loaded.framesize > max_size) {
+    loaded.framesize = max_size;
+  }
+  if (loaded.quality < CAMERA_SENSOR_DESC.min_quality) {
+    loaded.quality = CAMERA_SENSOR_DESC.min_quality;
+  }
+  loaded.version = SETTINGS_VERSION;
+  camera_settings = loaded;
+  stored = loaded;
+  have_stored = current; // An upgraded record is rewritten on the next save
+  log_i("Loaded stored settings (framesize %u, quality %u)", loaded.framesize, loaded.quality);
+  return true;
+}
+
+bool settings_save() {
+  camera_settings.version = SETTINGS_VERSION;
+  if (have_stored && memcmp(&stored, &camera_settings, sizeof(stored)) == 0) {
+    return true;
+  }
+
+  Preferences prefs;
+  if (!prefs.begin(SETTINGS_NAMESPACE, false)) {
+    log_e("Failed to open settings namespace");
+    return false;
+  }
+  bool ok = prefs.putBytes(SETTINGS_KEY, &camera_settings, sizeof(camera_settings)) ==
+            sizeof(camera_settings);
+  prefs.end();
+  if (ok) {
+    stored = camera_settings;
+    have_stored = true;
+  } else {
+    log_e("Failed to store settings");
+  }
+  return ok;
+}
+
+bool settings_load_wifi(wifi_cache_t *cache) {
+  memset(cache, 0, sizeof(*cache));
+
+  Preferences prefs;
+  if (!prefs.begin(SETTINGS_NAMESPACE, true)) {
+    return false;
+  }
+  size_t len = prefs.getBytesLength(WIFI_CACHE_KEY) == sizeof(*cache)
+                   ? prefs.getBytes(WIFI_CACHE_KEY, cache, sizeof(*cache))
+                   : 0;
+  prefs.end();
+
+  if (len != sizeof(*cache) || !cache->valid || cache->channel == 0 || cache->channel > 14) {
+    memset(cache, 0, sizeof(*cache));
+    return false;
+  }
+  return true;
+}
+
+bool settings_save_wifi(const wifi_cache_t *cache) {
+  wifi_cache_t current;
+  bool have = settings_load_wifi(&current);
+  if (cache->valid ? (have && memcmp(&current, cache, sizeof(current)) == 0) : !have) {
+    return true;
+  }
+
+  Preferences prefs;
+  if (!prefs.begin(SETTINGS_NAMESPACE, false)) {
+    log_e("Failed to open settings namespace");
+    return false;
+  }
+  bool ok = cache->valid ? prefs.putBytes(WIFI_CACHE_KEY, cache, sizeof(*cache)) == sizeof(*cache)
+                         : prefs.remove(WIFI_CACHE_KEY);
+  prefs.end();
+  if (!ok) {
+    log_e("Failed to store Wi-Fi association");
+  }
+  return ok;
+}
@@ -0,0 +1,55 @@
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <stdint.h>
+
+//
+// Persisted camera and stream configuration
+//
+// Loaded from NVS (Preferences namespace "camera") before the camera driver is
+// initialised, so the sensor starts at the stored framesize and quality and the
+// first frame already uses them. /control saves the settings after every
+// successful change; a record with the wrong version or size is ignored and
+// the built-in defaults are used. Version 1 records (no ROI) are upgraded.
+//
+
+#define SETTINGS_VERSION 2
+
+typedef struct {
+  uint8_t version;
+  uint8_t framesize;          // framesize_t
+  uint8_t quality;            // Sensor JPEG quality, 5-63
+  uint8_t vflip;
+  uint8_t hmirror;
+  uint8_t adaptive;           // Adaptive frame rate on/off
+  uint8_t motion;             // Motion detection on/off
+  uint8_t reserved;
+  uint16_t interval_ms;       // Stream frame interval (0 = unpaced)
+  uint16_t snapshot_max_age;  // Snapshot cache age in ms
+  // Since version 2
+  uint16_t roi_zoom;          // Sensor window zoom in percent (100 = full frame)
+  uint16_t roi_x, roi_y;      // Window centre, per mille of the array
+} camera_settings_t;
+
+// Current settings, filled in by settings_load() (stored record or defaults)
+extern camera_settings_t camera_settings;
+
+// Read the stored record into camera_settings; false if defaults are in use
+bool settings_load();
+
+// Write camera_settings to NVS if it differs from what is stored
+bool settings_save();
+
+// Last good Wi-Fi association: lets the next boot join the same AP on the same
+// channel without scanning (WIFI_FAST_RECONNECT)
+typedef struct {
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint8_t valid;
+} wifi_cache_t;
+
+bool settings_load_wifi(wifi_cache_t *cache);
+// Store the association if it differs; an invalid record clears the cache
+bool settings_save_wifi(const wifi_cache_t *cache);
+
+#endif  // SETTINGS_H
@@ -0,0 +1,115 @@
+#include "stream_writer.h"
+
+#include "lwip/sockets.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#endif
+
+static const char *_STREAM_BOUNDARY = "\r\n--" PART_BOUNDARY "\r\n";
+static const char *_STREAM_PART = "Content-Type: image/jpeg\r\nContent-Length: %u\r\nX-Timestamp: %d.%06d\r\n\r\n";
+static const char *_CHUNK_END = "\r\n";
+
+void stream_writer_init(stream_writer_t *w, int fd, bool chunked) {
+  w->fd = fd;
+  w->chunked = chunked;
+}
+
+const char *stream_writer_preamble(size_t *len) {
+  *len = strlen(_STREAM_BOUNDARY);
+  return _STREAM_BOUNDARY;
+}
+
+// writev() until every iovec has gone out, resuming after partial writes
+static esp_err_t writev_all(int fd, struct iovec *iov, int iovcnt) {
+  while (iovcnt > 0) {
+    ssize_t sent = writev(fd, iov, iovcnt);
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return ESP_FAIL;
+    }
+    while (iovcnt > 0 && (size_t)sent >= iov->iov_len) {
+      sent -= iov->iov_len;
+      iov++;
+      iovcnt--;
+    }
+    if (iovcnt > 0) {
+      iov->iov_base = (char *)iov->iov_base + sent;
+      iov->iov_len -= sent;
+    }
+  }
+  return ESP_OK;
+}
+
+esp_err_t stream_writer_send_head(stream_writer_t *w, const char *headers) {
+  struct iovec iov[2] = {
+    {(void *)headers, strlen(headers)},
+    {(void *)_STREAM_BOUNDARY, strlen(_STREAM_BOUNDARY)},
+  };
+  return writev_all(w->fd, iov, 2);
+}
+
+esp_err_t stream_writer_send_part(stream_writer_t *w, const frame_t *frame) {
+  char part_buf[128];
+  char chunk_buf[16];
+
+  int hlen = snprintf(part_buf, sizeof(part_buf), _STREAM_PART, (unsigned)frame->len,
+                      (int)frame->timestamp.tv_sec, (int)frame->timestamp.tv_usec);
+  if (hlen < 0 || hlen >= (int)sizeof(part_buf)) {
+    log_e("Header buffer overflow");
+    return ESP_FAIL;
+  }
+
+  // Trailing boundary closes this part, so clients can render it without waiting
+  // for the next frame to arrive
+  size_t blen = strlen(_STREAM_BOUNDARY);
+
+  struct iovec iov[5];
+  int iovcnt = 0;
+
+  if (w->chunked) {
+    int clen = snprintf(chunk_buf, sizeof(chunk_buf), "%x\r\n", (unsigned)(hlen + frame->len + blen));
+    iov[iovcnt].iov_base = chunk_buf;
+    iov[iovcnt++].iov_len = clen;
+  }
+  iov[iovcnt].iov_base = part_buf;
+  iov[iovcnt++].iov_len = hlen;
+  iov[iovcnt].iov_base = frame->buf;
+  iov[iovcnt++].iov_len = frame->len;
+  iov[iovcnt].iov_base = (void *)_STREAM_BOUNDARY;
+  iov[iovcnt++].iov_len = blen;
+  if (w->chunked) {
+    iov[iovcnt].iov_base = (void *)_CHUNK_END;
+    iov[iovcnt++].iov_len = strlen(_CHUNK_END);
+  }
+
+  return writev_all(w->fd, iov, iovcnt);
+}
+
+esp_err_t stream_writer_send(stream_writer_t *w, const void *data, size_t len) {
+  char chunk_buf[16];
+  struct iovec iov[3];
+  int iovcnt = 0;
+
+  if (len == 0) {
+    return ESP_OK;
+  }
+  if (w->chunked) {
+    int clen = snprintf(chunk_buf, sizeof(chunk_buf), "%x\r\n", (unsigned)len);
+    iov[iovcnt].iov_base = chunk_buf;
+    iov[iovcnt++].iov_len = clen;
+  }
+  iov[iovcnt].iov_base = (void *)data;
+  iov[iovcnt++].iov_len = len;
+  if (w->chunked) {
+    iov[iovcnt].iov_base = (void *)_CHUNK_END;
+    iov[iovcnt++].iov_len = strlen(_CHUNK_END);
+  }
+
+  return writev_all(w->fd, iov, iovcnt);
+}
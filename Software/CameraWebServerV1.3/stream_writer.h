@@ -0,0 +1,38 @@
+#ifndef STREAM_WRITER_H
+#define STREAM_WRITER_H
+
+#include "esp_err.h"
+#include "frame_pipeline.h"
+
+//
+// MJPEG part writer
+//
+// Each frame goes out as a single scatter/gather write straight from the frame
+// buffer: part header, JPEG body and the following boundary, optionally wrapped
+// in HTTP/1.1 chunk framing. The JPEG itself is never copied.
+//
+
+#define PART_BOUNDARY "123456789000000000000987654321"
+#define STREAM_CONTENT_TYPE "multipart/x-mixed-replace;boundary=" PART_BOUNDARY
+
+typedef struct {
+  int fd;       // Connected client socket
+  bool chunked; // Wrap each part in a Transfer-Encoding: chunked chunk
+} stream_writer_t;
+
+void stream_writer_init(stream_writer_t *w, int fd, bool chunked);
+
+// Opening boundary, sent once before the first part
+const char *stream_writer_preamble(size_t *len);
+
+// Raw-socket streams: the HTTP response head and the opening boundary in one
+// write, never chunk-framed (blocking)
+esp_err_t stream_writer_send_head(stream_writer_t *w, const char *headers);
+
+// Write one complete multipart part for the frame (blocking)
+esp_err_t stream_writer_send_part(stream_writer_t *w, const frame_t *frame);
+
+// Write arbitrary body bytes, chunk-framed if the writer is chunked (blocking)
+esp_err_t stream_writer_send(stream_writer_t *w, const void *data, size_t len);
+
+#endif  // STREAM_WRITER_H
@@ -0,0 +1,417 @@
+#include "timelapse.h"
+#include "board_config.h"
+
+#if TIMELAPSE
+
+#include "frame_pipeline.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#if defined(SD_SPI_CS_GPIO_NUM)
+#include "SD.h"
+#include "SPI.h"
+#define CARD SD
+#else
+#include "SD_MMC.h"
+#define CARD SD_MMC
+#endif
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <esp32-hal-psram.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#endif
+
+#define TIMELAPSE_MOUNT "/sdcard"
+#define TIMELAPSE_DIR   "/timelapse"
+
+static const uint32_t SHOT_FRAME_TIMEOUT_MS = 1000;
+static const uint32_t SHOT_MAX_AGE_MS = 250;
+
+// One staged frame, handed from the shot task to the writer
+typedef struct {
+  uint8_t slot;
+  uint16_t session;
+  uint32_t index;
+  size_t len;
+} staged_frame_t;
+
+typedef struct {
+  uint8_t *data;      // PSRAM, grown on demand
+  size_t capacity;
+} stage_slot_t;
+
+static stage_slot_t stage[TIMELAPSE_STAGE_SLOTS];
+static QueueHandle_t free_slots = nullptr;  // uint8_t slot numbers
+static QueueHandle_t ready_frames = nullptr;
+static uint8_t *bounce = nullptr;           // Internal DMA-capable write buffer
+static QueueHandle_t commands = nullptr;    // tl_command_t, run by the shot task
+static TaskHandle_t shot_task = nullptr;
+static TaskHandle_t writer_task = nullptr;
+static SemaphoreHandle_t tl_lock = nullptr;
+static bool card_mounted = false;
+
+typedef enum {
+  TL_START = 0,
+  TL_STOP,
+  TL_SHOT,
+} tl_action_t;
+
+typedef struct {
+  tl_action_t action;
+  uint32_t interval_s;
+} tl_command_t;
+
+// Guarded by tl_lock
+static timelapse_status_t state;
+
+// Shot task only
+static uint32_t interval_ms = 0;
+
+static bool session_active() {
+  xSemaphoreTake(tl_lock, portMAX_DELAY);
+  bool active = state.active;
+  xSemaphoreGive(tl_lock);
+  return active;
+}
+
+// Runs on the shot task: a card that is slow to answer holds up shots, never
+// the httpd worker
+static bool mount_card() {
+  if (card_mounted) {
+    return true;
+  }
+#if defined(SD_SPI_CS_GPIO_NUM)
+  SPI.begin(SD_SPI_SCK_GPIO_NUM, SD_SPI_MISO_GPIO_NUM, SD_SPI_MOSI_GPIO_NUM, SD_SPI_CS_GPIO_NUM);
+  bool mounted = SD.begin(SD_SPI_CS_GPIO_NUM, SPI, 20000000, TIMELAPSE_MOUNT);
+#else
+  SD_MMC.setPins(SD_MMC_CLK_GPIO_NUM, SD_MMC_CMD_GPIO_NUM, SD_MMC_D0_GPIO_NUM);
+  bool mounted = SD_MMC.begin(TIMELAPSE_MOUNT, true);
+#endif
+  if (!mounted || CARD.cardType() == CARD_NONE) {
+    log_e("SD card mount failed");
+    return false;
+  }
+  if (!CARD.exists(TIMELAPSE_DIR)) {
+    CARD.mkdir(TIMELAPSE_DIR);
+  }
+  card_mounted = true;
+  log_i("SD card mounted (%u MB)", (unsigned)(CARD.cardSize() / (1024 * 1024)));
+  return true;
+}
+
+// Create the next free /timelapse/NNNN directory
+static uint16_t open_session_dir() {
+  char path[32];
+  for (uint16_t n = 1; n < 10000; n++) {
+    snprintf(path, sizeof(path), TIMELAPSE_DIR "/%04u", n);
+    if (!CARD.exists(path)) {
+      return CARD.mkdir(path) ? n : 0;
+    }
+  }
+  return 0;
+}
+
+static bool begin_session(uint32_t interval_s) {
+  uint16_t session = mount_card() ? open_session_dir() : 0;
+  if (!session) {
+    log_e("Could not open a timelapse session on the card");
+    xSemaphoreTake(tl_lock, portMAX_DELAY);
+    state.card_error = true;
+    xSemaphoreGive(tl_lock);
+    return false;
+  }
+
+  xSemaphoreTake(tl_lock, portMAX_DELAY);
+  memset(&state, 0, sizeof(state));
+  state.active = true;
+  state.session = session;
+  state.interval_s = interval_s;
+  xSemaphoreGive(tl_lock);
+  interval_ms = interval_s * 1000;
+
+  log_i("Timelapse session %04u started (interval %us)", session, (unsigned)interval_s);
+  return true;
+}
+
+static void end_session() {
+  xSemaphoreTake(tl_lock, portMAX_DELAY);
+  bool was_active = state.active;
+  state.active = false;
+  interval_ms = 0;
+  uint16_t session = state.session;
+  uint32_t shots = state.shots;
+  xSemaphoreGive(tl_lock);
+  if (was_active) {
+    log_i("Timelapse session %04u stopped after %u shots", session, (unsigned)shots);
+  }
+}
+
+// A fresh frame: the cached one if recent enough, else the next one captured
+static frame_t *fresh_frame() {
+  frame_t *frame = frame_pipeline_get_latest(SHOT_MAX_AGE_MS);
+  if (frame) {
+    return frame;
+  }
+  int sub = frame_pipeline_subscribe(FRAME_PROFILE_FULL);
+  if (sub < 0) {
+    return nullptr;
+  }
+  frame = frame_pipeline_wait(sub, SHOT_FRAME_TIMEOUT_MS);
+  frame_pipeline_unsubscribe(sub);
+  return frame;
+}
+
+// Stage one frame for the writer; never waits on the card
+static void take_shot() {
+  uint8_t slot;
+  frame_t *frame = nullptr;
+  bool staged = false;
+
+  staged_frame_t staged_frame;
+  if (xQueueReceive(free_slots, &slot, 0) == pdTRUE) {
+    frame = fresh_frame();
+    stage_slot_t *s = &stage[slot];
+    if (frame && s->capacity < frame->len) {
+      uint8_t *grown = (uint8_t *)heap_caps_realloc(s->data, frame->len,
+                                                    MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+      if (grown) {
+        s->data = grown;
+        s->capacity = frame->len;
+      }
+    }
+    if (frame && s->capacity >= frame->len) {
+      memcpy(s->data, frame->buf, frame->len);
+      xSemaphoreTake(tl_lock, portMAX_DELAY);
+      staged_frame = {slot, state.session, state.shots + 1, frame->len};
+      xSemaphoreGive(tl_lock);
+      staged = xQueueSend(ready_frames, &staged_frame, 0) == pdTRUE;
+    }
+    if (!staged) {
+      xQueueSend(free_slots, &slot, 0);
+    }
+  }
+  if (frame) {
+    frame_pipeline_release(frame);
+  }
+  // Only the shot task stages frames, so the index taken above is still next
+  xSemaphoreTake(tl_lock, portMAX_DELAY);
+  if (!staged) {
+    state.dropped++;
+  } else if (staged_frame.session == state.session) {
+    state.shots = staged_frame.index;
+  }
+  xSemaphoreGive(tl_lock);
+  if (!staged) {
+    log_w("Timelapse shot dropped (staging full or no frame)");
+  }
+}
+
+static void shot_task_fn(void *arg) {
+  (void)arg;
+  TickType_t next_due = xTaskGetTickCount();
+
+  while (true) {
+    TickType_t wait = portMAX_DELAY;
+    if (interval_ms) {
+      int32_t remaining = (int32_t)(next_due - xTaskGetTickCount());
+      wait = remaining > 0 ? (TickType_t)remaining : 0;
+    }
+
+    bool triggered = false;
+    tl_command_t cmd;
+    if (xQueueReceive(commands, &cmd, wait) == pdTRUE) {
+      if (cmd.action == TL_STOP) {
+        end_session();
+        continue;
+      }
+      if (cmd.action == TL_START) {
+        end_session();
+        if (!begin_session(cmd.interval_s)) {
+          continue;
+        }
+        // New session: the first interval shot is due right away
+        next_due = xTaskGetTickCount();
+      } else {
+        // Layer-change macros just fire shots; open a manual session on the first one
+        if (!session_active() && !begin_session(0)) {
+          continue;
+        }
+        triggered = true;
+      }
+    }
+    if (!session_active()) {
+      continue;
+    }
+
+    TickType_t now = xTaskGetTickCount();
+    if (interval_ms && (int32_t)(now - next_due) >= 0) {
+      next_due = now + pdMS_TO_TICKS(interval_ms);
+      take_shot();
+    } else if (triggered) {
+      take_shot();
+    }
+  }
+}
+
+// Stream one staged frame to the card: whole bounce-buffer writes keep FATFS on
+// its multi-sector path, and the bounce buffer is DMA-capable for the SDMMC host
+static bool write_frame(const staged_frame_t *f) {
+  char path[48];
+  snprintf(path, sizeof(path), TIMELAPSE_MOUNT TIMELAPSE_DIR "/%04u/%06u.jpg", f->session,
+           (unsigned)f->index);
+  int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    log_e("Timelapse open failed: %s", path);
+    return false;
+  }
+
+  const uint8_t *data = stage[f->slot].data;
+  bool ok = true;
+  for (size_t off = 0; off < f->len && ok;) {
+    size_t n = f->len - off < TIMELAPSE_WRITE_CHUNK ? f->len - off : TIMELAPSE_WRITE_CHUNK;
+    memcpy(bounce, data + off, n);
+    ok = write(fd, bounce, n) == (ssize_t)n;
+    off += n;
+  }
+  ok = (close(fd) == 0) && ok;
+  if (!ok) {
+    log_e("Timelapse write failed: %s", path);
+  }
+  return ok;
+}
+
+static void writer_task_fn(void *arg) {
+  (void)arg;
+  staged_frame_t f;
+
+  while (true) {
+    if (xQueueReceive(ready_frames, &f, portMAX_DELAY) != pdTRUE) {
+      continue;
+    }
+    int64_t start = esp_timer_get_time();
+    bool ok = write_frame(&f);
+    uint32_t ms = (uint32_t)((esp_timer_get_time() - start) / 1000);
+    xQueueSend(free_slots, &f.slot, 0);
+
+    xSemaphoreTake(tl_lock, portMAX_DELAY);
+    if (f.session == state.session) {
+      if (ok) {
+        state.written++;
+      } else {
+        state.errors++;
+      }
+      if (ms > state.max_write_ms) {
+        state.max_write_ms = ms;
+      }
+    }
+    xSemaphoreGive(tl_lock);
+  }
+}
+
+bool timelapse_init() {
+  if (shot_task != nullptr) {
+    return true;
+  }
+  if (!psramFound()) {
+    log_w("No PSRAM: timelapse disabled");
+    return false;
+  }
+
+  tl_lock = xSemaphoreCreateMutex();
+  free_slots = xQueueCreate(TIMELAPSE_STAGE_SLOTS, sizeof(uint8_t));
+  ready_frames = xQueueCreate(TIMELAPSE_STAGE_SLOTS, sizeof(staged_frame_t));
+  commands = xQueueCreate(4, sizeof(tl_command_t));
+  bounce = (uint8_t *)heap_caps_malloc(TIMELAPSE_WRITE_CHUNK, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+  if (!tl_lock || !free_slots || !ready_frames || !commands || !bounce) {
+    log_e("Failed to allocate timelapse buffers");
+    return false;
+  }
+  for (uint8_t i = 0; i < TIMELAPSE_STAGE_SLOTS; i++) {
+    xQueueSend(free_slots, &i, 0);
+  }
+
+  if (xTaskCreatePinnedToCore(writer_task_fn, "tl_write", TIMELAPSE_TASK_STACK, nullptr,
+                              TIMELAPSE_WRITER_PRIORITY, &writer_task, HTTPD_TASK_CORE) != pdPASS ||
+      xTaskCreatePinnedToCore(shot_task_fn, "tl_shot", TIMELAPSE_TASK_STACK, nullptr,
+                              TIMELAPSE_SHOT_PRIORITY, &shot_task, HTTPD_TASK_CORE) != pdPASS) {
+    log_e("Failed to create timelapse tasks");
+    shot_task = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void timelapse_get_status(timelapse_status_t *status) {
+  if (!tl_lock) {
+    memset(status, 0, sizeof(*status));
+    return;
+  }
+  xSemaphoreTake(tl_lock, portMAX_DELAY);
+  *status = state;
+  xSemaphoreGive(tl_lock);
+}
+
+esp_err_t timelapse_handler(httpd_req_t *req) {
+  if (!shot_task) {
+    httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "Timelapse needs PSRAM");
+    return ESP_FAIL;
+  }
+
+  char query[64];
+  char action[12] = "status";
+  char value[12];
+  uint32_t interval_s = 0;
+  if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+    httpd_query_key_value(query, "action", action, sizeof(action));
+    if (httpd_query_key_value(query, "interval", value, sizeof(value)) == ESP_OK) {
+      interval_s = strtoul(value, nullptr, 10);
+    }
+  }
+
+  tl_command_t cmd = {TL_SHOT, interval_s};
+  bool command = true;
+  if (!strcmp(action, "start")) {
+    cmd.action = TL_START;
+  } else if (!strcmp(action, "stop")) {
+    cmd.action = TL_STOP;
+  } else if (!strcmp(action, "shot")) {
+    cmd.action = TL_SHOT;
+  } else if (!strcmp(action, "status")) {
+    command = false;
+  } else {
+    httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Unknown action");
+    return ESP_FAIL;
+  }
+  bool ok = !command || xQueueSend(commands, &cmd, 0) == pdTRUE;
+
+  timelapse_status_t s;
+  timelapse_get_status(&s);
+  char json[256];
+  int len = snprintf(json, sizeof(json),
+                     "{\"ok\":%s,\"pending\":%u,\"active\":%s,\"session\":%u,\"interval\":%u,"
+                     "\"shots\":%u,\"written\":%u,\"queued\":%u,\"dropped\":%u,\"errors\":%u,"
+                     "\"card_error\":%s,\"max_write_ms\":%u}",
+                     ok ? "true" : "false", (unsigned)uxQueueMessagesWaiting(commands),
+                     s.active ? "true" : "false", s.session, (unsigned)s.interval_s,
+                     (unsigned)s.shots, (unsigned)s.written,
+                     (unsigned)uxQueueMessagesWaiting(ready_frames), (unsigned)s.dropped,
+                     (unsigned)s.errors, s.card_error ? "true" : "false",
+                     (unsigned)s.max_write_ms);
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+  if (!ok) {
+    httpd_resp_set_status(req, "503 Service Unavailable");
+  }
+  return httpd_resp_send(req, json, len);
+}
+
+#endif  // TIMELAPSE
@@ -0,0 +1,45 @@
+#ifndef TIMELAPSE_H
+#define TIMELAPSE_H
+
+#include "esp_http_server.h"
+#include <stdint.h>
+
+//
+// SD card timelapse recorder
+//
+// GET /timelapse[?action=start|stop|shot|status&interval=S]
+//
+//   start    Mount the card if needed and open a new session directory
+//            (/timelapse/NNNN); with interval=S a frame is taken every S seconds
+//   shot     Take one frame now (e.g. from a layer-change macro); opens a
+//            manual session first if none is running
+//   stop     Close the session once queued frames are written
+//
+// Each shot waits for a fresh frame from the pipeline and copies it into a
+// PSRAM staging slot; a low-priority writer streams staged frames to the card
+// through a DMA-capable bounce buffer in TIMELAPSE_WRITE_CHUNK writes. Shots
+// that find every staging slot busy are dropped and counted, never blocking
+// capture or streaming. Actions are queued to the shot task, which also mounts
+// the card, so a slow card never holds the httpd worker; responses carry the
+// recorder status as JSON at the time the action was accepted, with "pending"
+// actions still to run and "card_error" set when a session could not be opened.
+//
+
+typedef struct {
+  bool active;
+  uint16_t session;
+  uint32_t interval_s;
+  uint32_t shots;       // Frames staged in this session
+  uint32_t written;     // Frames on the card
+  uint32_t dropped;     // Shots lost to a full staging area or missing frame
+  uint32_t errors;      // Failed card writes
+  uint32_t max_write_ms;
+  bool card_error;      // Last session start failed (no card, mount or mkdir error)
+} timelapse_status_t;
+
+// Create the staging buffers and tasks; the card is mounted on the first session
+bool timelapse_init();
+void timelapse_get_status(timelapse_status_t *status);
+esp_err_t timelapse_handler(httpd_req_t *req);
+
+#endif  // TIMELAPSE_H
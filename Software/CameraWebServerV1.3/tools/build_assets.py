@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""Build the embedded web UI tables (web_assets.h) from the sketch sources.
+
+Each asset is gzip-compressed (deterministically, so unchanged sources give a
+byte-identical header) and tagged with a hash of its content, which the server
+sends as a strong ETag. Run after editing any asset:
+
+    python3 tools/build_assets.py
+
+Adding an asset: list it in ASSETS with the URI it is served on and its type,
+and make sure that URI is registered in startCameraServer().
+"""
+
+import gzip
+import hashlib
+import os
+import sys
+
+SKETCH_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+OUTPUT = os.path.join(SKETCH_DIR, "web_assets.h")
+
+# (source file, URI, content type)
+ASSETS = [
+    ("index.html", "/", "text/html"),
+]
+
+
+def c_name(path):
+    return "asset_" + "".join(c if c.isalnum() else "_" for c in path)
+
+
+def render(assets):
+    out = []
+    out.append("// Generated by tools/build_assets.py from the sketch sources. Do not edit.")
+    out.append("#ifndef WEB_ASSETS_H")
+    out.append("#define WEB_ASSETS_H")
+    out.append("")
+    out.append("#include <pgmspace.h>")
+    out.append("#include <stddef.h>")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("typedef struct {")
+    out.append("  const char *uri;          // Path the asset is served on")
+    out.append("  const char *type;         // Content-Type")
+    out.append("  const char *etag;         // Quoted strong ETag (content hash)")
+    out.append("  const uint8_t *data;      // gzip-compressed body")
+    out.append("  size_t len;")
+    out.append("} web_asset_t;")
+    out.append("")
+
+    entries = []
+    for source, uri, ctype in assets:
+        with open(os.path.join(SKETCH_DIR, source), "rb") as f:
+            raw = f.read()
+        # mtime=0 keeps the output stable across rebuilds
+        packed = gzip.compress(raw, compresslevel=9, mtime=0)
+        etag = hashlib.sha256(raw).hexdigest()[:16]
+        name = c_name(source)
+
+        out.append("// %s: %u bytes, %u gzipped" % (source, len(raw), len(packed)))
+        out.append("static const uint8_t %s[] PROGMEM = {" % name)
+        for i in range(0, len(packed), 20):
+            row = ", ".join("0x%02x" % b for b in packed[i:i + 20])
+            out.append("  %s," % row)
+        out.append("};")
+        out.append("")
+        entries.append('  {"%s", "%s", "\\"%s\\"", %s, sizeof(%s)},' % (uri, ctype, etag, name, name))
+
+    out.append("static const web_asset_t web_assets[] = {")
+    out.extend(entries)
+    out.append("};")
+    out.append("")
+    out.append("#define WEB_ASSET_COUNT (sizeof(web_assets) / sizeof(web_assets[0]))")
+    out.append("")
+    out.append("#endif  // WEB_ASSETS_H")
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    content = render(ASSETS)
+    try:
+        with open(OUTPUT) as f:
+            if f.read() == content:
+                print("web_assets.h is up to date")
+                return 0
+    except FileNotFoundError:
+        pass
+    with open(OUTPUT, "w") as f:
+        f.write(content)
+    print("Wrote %s" % os.path.relpath(OUTPUT, SKETCH_DIR))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,339 @@
+#include "http_client.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0  // macOS: SIGPIPE is ignored by the caller instead
+#endif
+
+http_conn::http_conn()
+    : fd_(-1), pos_(0), len_(0), eof_(false), chunked_(false), body_left_(-1),
+      body_done_(false), body_error_(false) {}
+
+http_conn::~http_conn() { close(); }
+
+void http_conn::close() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  pos_ = len_ = 0;
+  eof_ = false;
+}
+
+// Non-blocking connect bounded by the timeout, then blocking I/O with the
+// same timeout on every read and write
+static int connect_timeout(const std::string &host, uint16_t port, uint32_t timeout_ms) {
+  char port_str[8];
+  snprintf(port_str, sizeof(port_str), "%u", port);
+  struct addrinfo hints = {};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  struct addrinfo *res = nullptr;
+  if (getaddrinfo(host.c_str(), port_str, &hints, &res) != 0 || !res) {
+    return -1;
+  }
+
+  int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+  if (fd < 0) {
+    freeaddrinfo(res);
+    return -1;
+  }
+  int flags = fcntl(fd, F_GETFL, 0);
+  fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+  int rc = connect(fd, res->ai_addr, res->ai_addrlen);
+  freeaddrinfo(res);
+  if (rc < 0 && errno != EINPROGRESS) {
+    ::close(fd);
+    return -1;
+  }
+  if (rc < 0) {
+    struct pollfd pfd = {fd, POLLOUT, 0};
+    int err = 0;
+    socklen_t err_len = sizeof(err);
+    if (poll(&pfd, 1, (int)timeout_ms) != 1 ||
+        getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &err_len) != 0 || err != 0) {
+      ::close(fd);
+      return -1;
+    }
+  }
+  fcntl(fd, F_SETFL, flags);
+
+  struct timeval tv = {(time_t)(timeout_ms / 1000), (suseconds_t)((timeout_ms % 1000) * 1000)};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+  int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  return fd;
+}
+
+bool http_conn::open(const std::string &host, uint16_t port, const std::string &path,
+                     uint32_t timeout_ms) {
+  close();
+  fd_ = connect_timeout(host, port, timeout_ms);
+  if (fd_ < 0) {
+    return false;
+  }
+
+  std::string req = "GET " + path + " HTTP/1.1\r\nHost: " + host +
+                    "\r\nUser-Agent: cam-loadtest\r\nConnection: close\r\n\r\n";
+  size_t off = 0;
+  while (off < req.size()) {
+    ssize_t n = send(fd_, req.data() + off, req.size() - off, MSG_NOSIGNAL);
+    if (n <= 0) {
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      close();
+      return false;
+    }
+    off += (size_t)n;
+  }
+  return true;
+}
+
+bool http_conn::fill() {
+  if (fd_ < 0) {
+    return false;
+  }
+  for (;;) {
+    ssize_t n = recv(fd_, buf_, sizeof(buf_), 0);
+    if (n > 0) {
+      pos_ = 0;
+      len_ = (size_t)n;
+      return true;
+    }
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    eof_ = n == 0;
+    return false;  // Closed, reset or timed out
+  }
+}
+
+int http_conn::raw_getc() {
+  if (pos_ == len_ && !fill()) {
+    return -1;
+  }
+  return (unsigned char)buf_[pos_++];
+}
+
+// CRLF (or bare LF) terminated line without the terminator; bounded so a
+// binary stream without line breaks cannot grow it forever
+bool http_conn::raw_read_line(std::string *line) {
+  line->clear();
+  for (;;) {
+    int c = raw_getc();
+    if (c < 0) {
+      return false;
+    }
+    if (c == '\n') {
+      if (!line->empty() && line->back() == '\r') {
+        line->pop_back();
+      }
+      return true;
+    }
+    if (line->size() >= 1024) {
+      return false;
+    }
+    line->push_back((char)c);
+  }
+}
+
+bool http_conn::read_head(http_response_t *resp) {
+  resp->status = 0;
+  resp->content_type.clear();
+  resp->content_length = -1;
+  resp->chunked = false;
+
+  std::string line;
+  if (!raw_read_line(&line) || strncmp(line.c_str(), "HTTP/1.", 7) != 0 || line.size() < 12) {
+    return false;
+  }
+  resp->status = atoi(line.c_str() + 9);
+
+  for (;;) {
+    if (!raw_read_line(&line)) {
+      return false;
+    }
+    if (line.empty()) {
+      break;
+    }
+    size_t colon = line.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    std::string name = line.substr(0, colon);
+    size_t start = line.find_first_not_of(" \t", colon + 1);
+    std::string value = start == std::string::npos ? "" : line.substr(start);
+    if (strcasecmp(name.c_str(), "Content-Type") == 0) {
+      resp->content_type = value;
+    } else if (strcasecmp(name.c_str(), "Content-Length") == 0) {
+      resp->content_length = atol(value.c_str());
+    } else if (strcasecmp(name.c_str(), "Transfer-Encoding") == 0) {
+      resp->chunked = strcasestr(value.c_str(), "chunked") != nullptr;
+    }
+  }
+
+  chunked_ = resp->chunked;
+  body_done_ = false;
+  body_error_ = false;
+  if (chunked_) {
+    body_left_ = 0;
+  } else {
+    body_left_ = resp->content_length;
+    body_done_ = body_left_ == 0;
+  }
+  return true;
+}
+
+// Chunk framing: CRLF after the previous chunk's data, a hex size line, and a
+// trailer after the zero-size chunk
+bool http_conn::next_chunk() {
+  std::string line;
+  for (;;) {
+    if (!raw_read_line(&line)) {
+      body_done_ = body_error_ = true;
+      return false;
+    }
+    if (!line.empty()) {
+      break;  // Skip the CRLF that ends the previous chunk's data
+    }
+  }
+  char *end = nullptr;
+  long size = strtol(line.c_str(), &end, 16);
+  if (end == line.c_str() || size < 0) {
+    body_done_ = body_error_ = true;
+    return false;
+  }
+  if (size == 0) {
+    while (raw_read_line(&line) && !line.empty()) {
+    }
+    body_done_ = true;
+    return false;
+  }
+  body_left_ = size;
+  return true;
+}
+
+// The socket ran dry: only a close ends a body that has no framing
+void http_conn::end_of_data() {
+  body_done_ = true;
+  body_error_ = chunked_ || body_left_ > 0 || !eof_;
+}
+
+int http_conn::body_getc() {
+  if (body_done_) {
+    return -1;
+  }
+  if (chunked_ && body_left_ == 0 && !next_chunk()) {
+    return -1;
+  }
+  if (body_left_ == 0) {
+    body_done_ = true;
+    return -1;
+  }
+  int c = raw_getc();
+  if (c < 0) {
+    end_of_data();
+    return -1;
+  }
+  if (body_left_ > 0) {
+    body_left_--;
+    if (body_left_ == 0 && !chunked_) {
+      body_done_ = true;
+    }
+  }
+  return c;
+}
+
+bool http_conn::read_line(std::string *line) {
+  line->clear();
+  for (;;) {
+    int c = body_getc();
+    if (c < 0) {
+      return false;
+    }
+    if (c == '\n') {
+      if (!line->empty() && line->back() == '\r') {
+        line->pop_back();
+      }
+      return true;
+    }
+    if (line->size() >= 1024) {
+      return false;
+    }
+    line->push_back((char)c);
+  }
+}
+
+// Append up to `want` body bytes straight from the socket buffer; 0 at the end
+// of the body or on a transport error
+size_t http_conn::body_take(std::string *out, size_t want) {
+  if (body_done_ || want == 0) {
+    return 0;
+  }
+  if (chunked_ && body_left_ == 0 && !next_chunk()) {
+    return 0;
+  }
+  if (pos_ == len_ && !fill()) {
+    end_of_data();
+    return 0;
+  }
+  size_t take = want;
+  if (take > len_ - pos_) {
+    take = len_ - pos_;
+  }
+  if (body_left_ >= 0 && take > (size_t)body_left_) {
+    take = (size_t)body_left_;
+  }
+  out->append(buf_ + pos_, take);
+  pos_ += take;
+  if (body_left_ > 0) {
+    body_left_ -= (long)take;
+    if (body_left_ == 0 && !chunked_) {
+      body_done_ = true;
+    }
+  }
+  return take;
+}
+
+bool http_conn::read_exact(std::string *out, size_t len) {
+  out->clear();
+  out->reserve(len);
+  while (out->size() < len) {
+    if (body_take(out, len - out->size()) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool http_conn::read_body(std::string *out, size_t max) {
+  out->clear();
+  while (out->size() < max && body_take(out, max - out->size()) > 0) {
+  }
+  // Complete when the framing said so, or the server closed an unframed body
+  return body_done_ && !body_error_;
+}
+
+bool http_get(const std::string &host, uint16_t port, const std::string &path, uint32_t timeout_ms,
+              http_response_t *resp, std::string *body, size_t max_body) {
+  http_conn conn;
+  resp->status = 0;
+  if (!conn.open(host, port, path, timeout_ms) || !conn.read_head(resp)) {
+    return false;
+  }
+  return conn.read_body(body, max_body);
+}
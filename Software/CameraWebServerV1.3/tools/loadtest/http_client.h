@@ -0,0 +1,66 @@
+#ifndef LOADTEST_HTTP_CLIENT_H
+#define LOADTEST_HTTP_CLIENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+//
+// Minimal blocking HTTP/1.1 client for the load test
+//
+// One request per connection (Connection: close). Bodies are read by
+// Content-Length, chunked transfer coding or until the server closes, so both
+// the raw-socket and the httpd-chunked /stream variants parse the same way.
+// Every socket read is bounded by the connection's timeout.
+//
+
+typedef struct {
+  int status;                // 0 if no valid status line arrived
+  std::string content_type;
+  long content_length;       // -1 when absent
+  bool chunked;
+} http_response_t;
+
+class http_conn {
+ public:
+  http_conn();
+  ~http_conn();
+  http_conn(const http_conn &) = delete;
+  http_conn &operator=(const http_conn &) = delete;
+
+  // Connect and send GET path; false on connect/send failure or timeout
+  bool open(const std::string &host, uint16_t port, const std::string &path, uint32_t timeout_ms);
+  // Status line and headers
+  bool read_head(http_response_t *resp);
+  void close();
+
+  // Body access, de-chunked when the response is chunked
+  bool read_line(std::string *line);
+  bool read_exact(std::string *out, size_t len);
+  // Rest of the body (Content-Length, chunks or until close), up to max bytes
+  bool read_body(std::string *out, size_t max);
+
+ private:
+  bool fill();
+  int raw_getc();
+  bool raw_read_line(std::string *line);
+  bool next_chunk();
+  int body_getc();
+  size_t body_take(std::string *out, size_t want);
+  void end_of_data();
+
+  int fd_;
+  char buf_[16384];
+  size_t pos_, len_;
+  bool eof_;         // Peer closed (as opposed to a reset or timeout)
+  bool chunked_;
+  long body_left_;   // Bytes left in the current chunk, or of Content-Length; -1 = until close
+  bool body_done_;
+  bool body_error_;  // Body cut short or badly framed
+};
+
+// GET host:port/path in one go; false on transport error (resp->status 0)
+bool http_get(const std::string &host, uint16_t port, const std::string &path, uint32_t timeout_ms,
+              http_response_t *resp, std::string *body, size_t max_body = 1 << 20);
+
+#endif  // LOADTEST_HTTP_CLIENT_H
@@ -0,0 +1,703 @@
+//
+// Camera load and soak test (host side)
+//
+// Drives a running camera the way a busy deployment does, all at once:
+//   - N concurrent /stream viewers, each parsing the multipart stream
+//   - a Duet Web Control style poller on :81/snapshot
+//   - /status and /control requests on port 80 alongside the streams
+//   - /metrics sampled for free heap over the whole run
+// and reports per-viewer FPS and inter-frame jitter, snapshot / status /
+// control latency percentiles, multipart parse errors and heap drift. Run it
+// against each firmware build with the same options and --report, then pass
+// the previous report as --baseline to print the differences:
+//
+//   cmake -S tools/loadtest -B build/loadtest && cmake --build build/loadtest
+//   build/loadtest/cam_loadtest --host 192.168.1.50 --streams 3 --duration 600
+//       --label v1.3-rc2 --report rc2.json --baseline rc1.json
+//
+// Exit status is 0 for a clean run, 2 if any stream or snapshot was malformed,
+// a viewer never got a frame or a /status or /control request failed, and 1
+// for bad arguments.
+//
+
+#include "http_client.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock clock_type;
+
+typedef struct {
+  std::string host = "";
+  uint16_t port = 80;
+  uint16_t snapshot_port = 81;         // 0 = no snapshot poller
+  std::string stream_path = "/stream";
+  std::string snapshot_path = "/snapshot";
+  std::string control_query = "";     // Default: rewrite the current quality
+  unsigned streams = 2;
+  unsigned duration_s = 60;
+  unsigned snapshot_ms = 250;          // DWC polls its webcam URL at 4 Hz or slower
+  unsigned status_ms = 1000;
+  unsigned control_ms = 2000;
+  unsigned heap_ms = 5000;
+  unsigned timeout_ms = 5000;
+  std::string label = "unlabelled";
+  std::string report_path = "";
+  std::string baseline_path = "";
+  std::string heap_csv_path = "";
+} options_t;
+
+typedef struct {
+  uint64_t frames = 0;
+  uint64_t bytes = 0;
+  uint32_t parse_errors = 0;   // Missing boundary, headers or Content-Length, short part
+  uint32_t bad_jpeg = 0;       // Part without SOI/EOI markers
+  uint32_t reconnects = 0;
+  uint32_t http_errors = 0;    // Non-200 answers (e.g. 503 at the stream limit)
+  double first_frame_ms = -1;  // Connect to first complete part
+  double first_s = 0, last_s = 0;
+  std::vector<double> gaps_ms; // Between consecutive parts of one connection
+} stream_stats_t;
+
+typedef struct {
+  std::vector<double> latency_ms;     // Successful requests
+  std::vector<double> all_ms;         // Every request, failed ones included
+  uint32_t errors = 0;         // Transport failures and timeouts
+  uint32_t timeouts = 0;       // Transport failures that took the whole timeout
+  uint32_t http_errors = 0;
+  uint32_t bad_body = 0;       // Not a JPEG / not a JSON object
+} request_stats_t;
+
+typedef struct {
+  double t_s;
+  long dram_free, dram_min, psram_free;
+} heap_sample_t;
+
+static std::atomic<bool> stop_requested(false);
+static clock_type::time_point run_start;
+
+static double seconds_since_start() {
+  return std::chrono::duration<double>(clock_type::now() - run_start).count();
+}
+
+static double ms_between(clock_type::time_point a, clock_type::time_point b) {
+  return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+// Sleep until `when`, waking early on Ctrl-C or the end of the run
+static void sleep_until(clock_type::time_point when, clock_type::time_point deadline) {
+  while (!stop_requested.load() && clock_type::now() < when && clock_type::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+}
+
+static bool looks_like_jpeg(const std::string &data) {
+  size_t n = data.size();
+  return n >= 4 && (uint8_t)data[0] == 0xFF && (uint8_t)data[1] == 0xD8 &&
+         (uint8_t)data[n - 2] == 0xFF && (uint8_t)data[n - 1] == 0xD9;
+}
+
+// Nearest-rank percentile of an unsorted sample; 0 for an empty one
+static double percentile(std::vector<double> values, double p) {
+  if (values.empty()) {
+    return 0;
+  }
+  std::sort(values.begin(), values.end());
+  size_t rank = (size_t)std::ceil(p / 100.0 * values.size());
+  return values[rank == 0 ? 0 : rank - 1];
+}
+
+static double mean_of(const std::vector<double> &values) {
+  double sum = 0;
+  for (double v : values) {
+    sum += v;
+  }
+  return values.empty() ? 0 : sum / values.size();
+}
+
+static double stddev_of(const std::vector<double> &values) {
+  if (values.size() < 2) {
+    return 0;
+  }
+  double mean = mean_of(values), sq = 0;
+  for (double v : values) {
+    sq += (v - mean) * (v - mean);
+  }
+  return std::sqrt(sq / (values.size() - 1));
+}
+
+// boundary=... from a multipart Content-Type, quotes stripped
+static std::string multipart_boundary(const std::string &content_type) {
+  size_t at = content_type.find("boundary=");
+  if (at == std::string::npos) {
+    return "";
+  }
+  std::string b = content_type.substr(at + 9);
+  size_t end = b.find(';');
+  if (end != std::string::npos) {
+    b = b.substr(0, end);
+  }
+  if (b.size() >= 2 && b.front() == '"' && b.back() == '"') {
+    b = b.substr(1, b.size() - 2);
+  }
+  return b;
+}
+
+// One multipart part: boundary line, headers, Content-Length bytes. Returns
+// false when the connection has to be dropped; recoverable framing problems
+// are counted and skipped
+static bool read_part(http_conn *conn, const std::string &delimiter, std::string *jpeg,
+                      stream_stats_t *st) {
+  std::string line;
+  bool resync = false;
+  for (;;) {
+    if (!conn->read_line(&line)) {
+      return false;
+    }
+    if (line == delimiter) {
+      break;
+    }
+    if (line == delimiter + "--") {
+      return false;  // Server ended the stream
+    }
+    if (!line.empty() && !resync) {
+      st->parse_errors++;
+      resync = true;
+    }
+  }
+
+  long length = -1;
+  for (;;) {
+    if (!conn->read_line(&line)) {
+      return false;
+    }
+    if (line.empty()) {
+      break;
+    }
+    if (strncasecmp(line.c_str(), "Content-Length:", 15) == 0) {
+      length = atol(line.c_str() + 15);
+    }
+  }
+  if (length <= 0) {
+    // Without a length the JPEG cannot be delimited reliably
+    st->parse_errors++;
+    return false;
+  }
+  if (!conn->read_exact(jpeg, (size_t)length)) {
+    st->parse_errors++;
+    return false;
+  }
+  return true;
+}
+
+static void stream_worker(const options_t *opt, unsigned index, clock_type::time_point deadline,
+                          stream_stats_t *st) {
+  // Stagger the viewers a little, like real clients arriving
+  std::this_thread::sleep_for(std::chrono::milliseconds(100 * index));
+  bool first_connection = true;
+  std::string jpeg;
+
+  while (!stop_requested.load() && clock_type::now() < deadline) {
+    if (!first_connection) {
+      st->reconnects++;
+      sleep_until(clock_type::now() + std::chrono::seconds(1), deadline);
+      if (stop_requested.load() || clock_type::now() >= deadline) {
+        break;
+      }
+    }
+    first_connection = false;
+
+    http_conn conn;
+    http_response_t resp;
+    clock_type::time_point connect_at = clock_type::now();
+    if (!conn.open(opt->host, opt->port, opt->stream_path, opt->timeout_ms) ||
+        !conn.read_head(&resp)) {
+      continue;
+    }
+    if (resp.status != 200) {
+      st->http_errors++;
+      continue;
+    }
+    std::string boundary = multipart_boundary(resp.content_type);
+    if (boundary.empty()) {
+      st->parse_errors++;
+      continue;
+    }
+    std::string delimiter = "--" + boundary;
+
+    bool have_previous = false;
+    clock_type::time_point previous;
+    while (!stop_requested.load() && clock_type::now() < deadline) {
+      if (!read_part(&conn, delimiter, &jpeg, st)) {
+        break;
+      }
+      clock_type::time_point now = clock_type::now();
+      if (!looks_like_jpeg(jpeg)) {
+        st->bad_jpeg++;
+      }
+      if (st->first_frame_ms < 0) {
+        st->first_frame_ms = ms_between(connect_at, now);
+        st->first_s = seconds_since_start();
+      }
+      if (have_previous) {
+        st->gaps_ms.push_back(ms_between(previous, now));
+      }
+      previous = now;
+      have_previous = true;
+      st->frames++;
+      st->bytes += jpeg.size();
+      st->last_s = seconds_since_start();
+    }
+  }
+}
+
+typedef bool (*body_check_t)(const std::string &body);
+
+static bool body_is_jpeg(const std::string &body) { return looks_like_jpeg(body); }
+
+static bool body_is_json_object(const std::string &body) {
+  size_t last = body.find_last_not_of(" \r\n\t");
+  return !body.empty() && body[0] == '{' && last != std::string::npos && body[last] == '}';
+}
+
+// Fixed-rate requests: a slow answer delays the next one rather than letting
+// requests pile up, as a single-connection poller (DWC, a dashboard) behaves
+static void request_worker(const options_t *opt, uint16_t port, std::string path,
+                           unsigned interval_ms, body_check_t check,
+                           clock_type::time_point deadline, request_stats_t *st) {
+  clock_type::time_point next = clock_type::now();
+  std::string body;
+  while (!stop_requested.load() && clock_type::now() < deadline) {
+    clock_type::time_point start = clock_type::now();
+    http_response_t resp;
+    bool ok = http_get(opt->host, port, path, opt->timeout_ms, &resp, &body, 4 << 20);
+    clock_type::time_point end = clock_type::now();
+    // Failures count towards the tail too: a request that times out is the
+    // slowest answer there is, not a missing sample
+    double ms = ms_between(start, end);
+    st->all_ms.push_back(ms);
+    if (!ok) {
+      if (resp.status != 0 && resp.status != 200) {
+        st->http_errors++;
+      } else {
+        st->errors++;
+        if (ms >= opt->timeout_ms) {
+          st->timeouts++;
+        }
+      }
+    } else if (resp.status != 200) {
+      st->http_errors++;
+    } else if (!check(body)) {
+      st->bad_body++;
+    } else {
+      st->latency_ms.push_back(ms);
+    }
+
+    next += std::chrono::milliseconds(interval_ms);
+    if (next < end) {
+      next = end;
+    }
+    sleep_until(next, deadline);
+  }
+}
+
+// Value of an unlabelled Prometheus sample, -1 when absent
+static long metric_value(const std::string &text, const char *name) {
+  std::string key = std::string("\n") + name + " ";
+  size_t at = ("\n" + text).find(key);
+  if (at == std::string::npos) {
+    return -1;
+  }
+  return atol(text.c_str() + at + key.size() - 1);
+}
+
+static void heap_worker(const options_t *opt, clock_type::time_point deadline,
+                        std::vector<heap_sample_t> *samples, uint32_t *errors) {
+  clock_type::time_point next = clock_type::now();
+  std::string body;
+  for (;;) {
+    http_response_t resp;
+    if (http_get(opt->host, opt->port, "/metrics", opt->timeout_ms, &resp, &body) &&
+        resp.status == 200) {
+      heap_sample_t s = {seconds_since_start(), metric_value(body, "cam_dram_free_bytes"),
+                         metric_value(body, "cam_dram_min_free_bytes"),
+                         metric_value(body, "cam_psram_free_bytes")};
+      samples->push_back(s);
+    } else {
+      (*errors)++;
+    }
+    // One last sample at the end of the run shows the drift
+    if (stop_requested.load() || clock_type::now() >= deadline) {
+      break;
+    }
+    next += std::chrono::milliseconds(opt->heap_ms);
+    sleep_until(next, deadline);
+  }
+}
+
+// Current quality from /status, so the default /control request changes nothing
+static std::string default_control_query(const options_t *opt) {
+  http_response_t resp;
+  std::string body;
+  if (http_get(opt->host, opt->port, "/status", opt->timeout_ms, &resp, &body) &&
+      resp.status == 200) {
+    size_t at = body.find("\"quality\":");
+    if (at != std::string::npos) {
+      return "var=quality&val=" + std::to_string(atoi(body.c_str() + at + 10));
+    }
+  }
+  return "";
+}
+
+//
+// Report
+//
+
+typedef std::vector<std::pair<std::string, double>> report_t;
+
+static void report_add(report_t *r, const std::string &key, double value) {
+  r->push_back(std::make_pair(key, value));
+}
+
+static uint32_t request_failures(const request_stats_t &st) {
+  return st.errors + st.http_errors + st.bad_body;
+}
+
+static void report_requests(report_t *r, const char *name, const request_stats_t &st) {
+  std::string p = name;
+  report_add(r, p + "_ok", (double)st.latency_ms.size());
+  report_add(r, p + "_errors", request_failures(st));
+  report_add(r, p + "_p50_ms", percentile(st.latency_ms, 50));
+  report_add(r, p + "_p99_ms", percentile(st.latency_ms, 99));
+  report_add(r, p + "_max_ms", percentile(st.latency_ms, 100));
+  report_add(r, p + "_all_p99_ms", percentile(st.all_ms, 99));
+  report_add(r, p + "_timeouts", st.timeouts);
+}
+
+static void print_requests(const char *name, bool enabled, const request_stats_t &st) {
+  if (!enabled) {
+    printf("%-9s off\n", name);
+    return;
+  }
+  printf("%-9s ok %-6zu p50 %7.1f ms  p99 %7.1f ms  max %7.1f ms  failed %u (%u timed out)  "
+         "http %u  bad %u  p99 incl. failures %7.1f ms\n",
+         name, st.latency_ms.size(), percentile(st.latency_ms, 50), percentile(st.latency_ms, 99),
+         percentile(st.latency_ms, 100), st.errors, st.timeouts, st.http_errors, st.bad_body,
+         percentile(st.all_ms, 99));
+}
+
+static double stream_fps(const stream_stats_t &st) {
+  double span = st.last_s - st.first_s;
+  return st.frames > 1 && span > 0 ? (st.frames - 1) / span : 0;
+}
+
+// Flat {"key": number} pairs of a previous report, for --baseline
+static std::map<std::string, double> load_report(const std::string &path) {
+  std::map<std::string, double> values;
+  FILE *f = fopen(path.c_str(), "r");
+  if (!f) {
+    return values;
+  }
+  std::string text;
+  char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    text.append(buf, n);
+  }
+  fclose(f);
+
+  size_t pos = 0;
+  while ((pos = text.find('"', pos)) != std::string::npos) {
+    size_t end = text.find('"', pos + 1);
+    if (end == std::string::npos) {
+      break;
+    }
+    std::string key = text.substr(pos + 1, end - pos - 1);
+    size_t colon = text.find_first_not_of(" \t\r\n", end + 1);
+    pos = end + 1;
+    if (colon == std::string::npos || text[colon] != ':') {
+      continue;
+    }
+    const char *value = text.c_str() + colon + 1;
+    char *value_end = nullptr;
+    double v = strtod(value, &value_end);
+    if (value_end != value) {
+      values[key] = v;
+      pos = value_end - text.c_str();
+    }
+  }
+  return values;
+}
+
+static bool write_report(const std::string &path, const options_t &opt, const report_t &r) {
+  FILE *f = fopen(path.c_str(), "w");
+  if (!f) {
+    return false;
+  }
+  fprintf(f, "{\n  \"label\": \"%s\",\n  \"host\": \"%s\"", opt.label.c_str(), opt.host.c_str());
+  for (const auto &kv : r) {
+    fprintf(f, ",\n  \"%s\": %.3f", kv.first.c_str(), kv.second);
+  }
+  fprintf(f, "\n}\n");
+  return fclose(f) == 0;
+}
+
+static void print_comparison(const std::string &path, const report_t &r) {
+  std::map<std::string, double> base = load_report(path);
+  if (base.empty()) {
+    fprintf(stderr, "No baseline values in %s\n", path.c_str());
+    return;
+  }
+  printf("\nAgainst baseline %s\n", path.c_str());
+  printf("%-28s %12s %12s %9s\n", "metric", "baseline", "this run", "change");
+  for (const auto &kv : r) {
+    auto it = base.find(kv.first);
+    if (it == base.end()) {
+      continue;
+    }
+    double before = it->second, after = kv.second;
+    if (before != 0) {
+      printf("%-28s %12.1f %12.1f %+8.1f%%\n", kv.first.c_str(), before, after,
+             (after - before) / std::fabs(before) * 100.0);
+    } else {
+      printf("%-28s %12.1f %12.1f %9s\n", kv.first.c_str(), before, after,
+             after == 0 ? "=" : "new");
+    }
+  }
+}
+
+//
+// Command line
+//
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+          "Usage: %s --host HOST [options]\n"
+          "  --port N              HTTP port (80)\n"
+          "  --snapshot-port N     DWC snapshot port, 0 = no poller (81)\n"
+          "  --streams N           concurrent /stream viewers (2)\n"
+          "  --duration S          run time in seconds (60)\n"
+          "  --snapshot-ms MS      snapshot poll interval (250)\n"
+          "  --status-ms MS        /status interval, 0 = off (1000)\n"
+          "  --control-ms MS       /control interval, 0 = off (2000)\n"
+          "  --control QUERY       /control query (default: rewrite the current quality)\n"
+          "  --heap-ms MS          /metrics heap sample interval (5000)\n"
+          "  --stream-path PATH    stream URL path (/stream)\n"
+          "  --timeout-ms MS       connect and read timeout (5000)\n"
+          "  --label NAME          firmware build name for the report\n"
+          "  --report FILE         write the report as JSON\n"
+          "  --baseline FILE       compare against an earlier report\n"
+          "  --heap-csv FILE       write the heap samples as CSV\n",
+          argv0);
+}
+
+static bool parse_args(int argc, char **argv, options_t *opt) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      return false;
+    }
+    const char *value = argv[++i];
+    unsigned long n = strtoul(value, nullptr, 10);
+    if (arg == "--host") {
+      opt->host = value;
+    } else if (arg == "--port") {
+      opt->port = (uint16_t)n;
+    } else if (arg == "--snapshot-port") {
+      opt->snapshot_port = (uint16_t)n;
+    } else if (arg == "--streams") {
+      opt->streams = (unsigned)n;
+    } else if (arg == "--duration") {
+      opt->duration_s = (unsigned)n;
+    } else if (arg == "--snapshot-ms") {
+      opt->snapshot_ms = (unsigned)n;
+    } else if (arg == "--status-ms") {
+      opt->status_ms = (unsigned)n;
+    } else if (arg == "--control-ms") {
+      opt->control_ms = (unsigned)n;
+    } else if (arg == "--control") {
+      opt->control_query = value;
+    } else if (arg == "--heap-ms") {
+      opt->heap_ms = (unsigned)n;
+    } else if (arg == "--stream-path") {
+      opt->stream_path = value;
+    } else if (arg == "--timeout-ms") {
+      opt->timeout_ms = (unsigned)n;
+    } else if (arg == "--label") {
+      opt->label = value;
+    } else if (arg == "--report") {
+      opt->report_path = value;
+    } else if (arg == "--baseline") {
+      opt->baseline_path = value;
+    } else if (arg == "--heap-csv") {
+      opt->heap_csv_path = value;
+    } else {
+      return false;
+    }
+  }
+  return !opt->host.empty() && opt->duration_s > 0 && opt->snapshot_ms > 0 &&
+         opt->heap_ms > 0 && opt->timeout_ms > 0;
+}
+
+static void on_interrupt(int) { stop_requested.store(true); }
+
+int main(int argc, char **argv) {
+  options_t opt;
+  if (!parse_args(argc, argv, &opt)) {
+    usage(argv[0]);
+    return 1;
+  }
+  signal(SIGPIPE, SIG_IGN);
+  signal(SIGINT, on_interrupt);
+
+  std::string control_query = opt.control_query;
+  if (opt.control_ms && control_query.empty()) {
+    control_query = default_control_query(&opt);
+    if (control_query.empty()) {
+      fprintf(stderr, "%s:%u/status did not answer, is the camera up?\n", opt.host.c_str(),
+              opt.port);
+      return 1;
+    }
+  }
+
+  printf("cam_loadtest: %s, %u stream(s), snapshots %s, %u s, build \"%s\"\n", opt.host.c_str(),
+         opt.streams, opt.snapshot_port ? "on" : "off", opt.duration_s, opt.label.c_str());
+  fflush(stdout);
+
+  run_start = clock_type::now();
+  clock_type::time_point deadline = run_start + std::chrono::seconds(opt.duration_s);
+
+  std::vector<stream_stats_t> streams(opt.streams);
+  request_stats_t snapshots, status, control;
+  std::vector<heap_sample_t> heap;
+  uint32_t heap_errors = 0;
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i < opt.streams; i++) {
+    threads.emplace_back(stream_worker, &opt, i, deadline, &streams[i]);
+  }
+  if (opt.snapshot_port) {
+    threads.emplace_back(request_worker, &opt, opt.snapshot_port, opt.snapshot_path,
+                         opt.snapshot_ms, body_is_jpeg, deadline, &snapshots);
+  }
+  if (opt.status_ms) {
+    threads.emplace_back(request_worker, &opt, opt.port, std::string("/status"), opt.status_ms,
+                         body_is_json_object, deadline, &status);
+  }
+  if (opt.control_ms) {
+    threads.emplace_back(request_worker, &opt, opt.port, "/control?" + control_query,
+                         opt.control_ms, body_is_json_object, deadline, &control);
+  }
+  threads.emplace_back(heap_worker, &opt, deadline, &heap, &heap_errors);
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  //
+  // Summary
+  //
+  report_t r;
+  report_add(&r, "duration_s", seconds_since_start());
+  report_add(&r, "streams", opt.streams);
+
+  printf("\n%-7s %7s %7s %9s %9s %9s %9s %9s %6s %5s %6s %5s\n", "stream", "frames", "fps",
+         "gap_mean", "jitter", "gap_p99", "gap_max", "first_ms", "parse", "jpeg", "reconn",
+         "http");
+  double fps_min = -1, fps_sum = 0, jitter_max = 0, gap_p99_max = 0, gap_max = 0;
+  uint32_t parse_errors = 0, bad_jpeg = 0, reconnects = 0, starved = 0;
+  for (unsigned i = 0; i < opt.streams; i++) {
+    const stream_stats_t &st = streams[i];
+    double fps = stream_fps(st), jitter = stddev_of(st.gaps_ms);
+    double p99 = percentile(st.gaps_ms, 99), worst = percentile(st.gaps_ms, 100);
+    printf("%-7u %7llu %7.2f %9.1f %9.1f %9.1f %9.1f %9.0f %6u %5u %6u %5u\n", i,
+           (unsigned long long)st.frames, fps, mean_of(st.gaps_ms), jitter, p99, worst,
+           st.first_frame_ms, st.parse_errors, st.bad_jpeg, st.reconnects, st.http_errors);
+
+    std::string p = "stream" + std::to_string(i);
+    report_add(&r, p + "_fps", fps);
+    report_add(&r, p + "_jitter_ms", jitter);
+    report_add(&r, p + "_gap_p99_ms", p99);
+    report_add(&r, p + "_first_frame_ms", st.first_frame_ms);
+
+    fps_min = fps_min < 0 || fps < fps_min ? fps : fps_min;
+    fps_sum += fps;
+    jitter_max = std::max(jitter_max, jitter);
+    gap_p99_max = std::max(gap_p99_max, p99);
+    gap_max = std::max(gap_max, worst);
+    parse_errors += st.parse_errors;
+    bad_jpeg += st.bad_jpeg;
+    reconnects += st.reconnects;
+    starved += st.frames == 0;
+  }
+  report_add(&r, "stream_fps_min", fps_min < 0 ? 0 : fps_min);
+  report_add(&r, "stream_fps_mean", opt.streams ? fps_sum / opt.streams : 0);
+  report_add(&r, "stream_jitter_ms_max", jitter_max);
+  report_add(&r, "stream_gap_p99_ms_max", gap_p99_max);
+  report_add(&r, "stream_gap_max_ms", gap_max);
+  report_add(&r, "stream_parse_errors", parse_errors);
+  report_add(&r, "stream_bad_jpeg", bad_jpeg);
+  report_add(&r, "stream_reconnects", reconnects);
+  report_add(&r, "stream_starved", starved);
+
+  printf("\n");
+  print_requests("snapshot", opt.snapshot_port != 0, snapshots);
+  print_requests("status", opt.status_ms != 0, status);
+  print_requests("control", opt.control_ms != 0, control);
+  report_requests(&r, "snapshot", snapshots);
+  report_requests(&r, "status", status);
+  report_requests(&r, "control", control);
+
+  if (!heap.empty() && heap.front().dram_free >= 0) {
+    const heap_sample_t &first = heap.front(), &last = heap.back();
+    long dram_low = first.dram_free, psram_low = first.psram_free;
+    for (const heap_sample_t &s : heap) {
+      dram_low = std::min(dram_low, s.dram_free);
+      psram_low = std::min(psram_low, s.psram_free);
+    }
+    printf("heap      DRAM free %ld -> %ld (lowest sample %ld, device low-water %ld), "
+           "PSRAM free %ld -> %ld, %zu samples, %u failed\n",
+           first.dram_free, last.dram_free, dram_low, last.dram_min, first.psram_free,
+           last.psram_free, heap.size(), heap_errors);
+    report_add(&r, "heap_dram_start", first.dram_free);
+    report_add(&r, "heap_dram_end", last.dram_free);
+    report_add(&r, "heap_dram_drift", last.dram_free - first.dram_free);
+    report_add(&r, "heap_dram_min_free", last.dram_min);
+    report_add(&r, "heap_psram_end", last.psram_free);
+    report_add(&r, "heap_psram_drift", last.psram_free - first.psram_free);
+  } else {
+    printf("heap      no /metrics samples (%u failed)\n", heap_errors);
+  }
+
+  if (!opt.heap_csv_path.empty()) {
+    FILE *f = fopen(opt.heap_csv_path.c_str(), "w");
+    if (f) {
+      fprintf(f, "t_s,dram_free,dram_min_free,psram_free\n");
+      for (const heap_sample_t &s : heap) {
+        fprintf(f, "%.1f,%ld,%ld,%ld\n", s.t_s, s.dram_free, s.dram_min, s.psram_free);
+      }
+      fclose(f);
+    } else {
+      fprintf(stderr, "Cannot write %s\n", opt.heap_csv_path.c_str());
+    }
+  }
+  if (!opt.report_path.empty() && !write_report(opt.report_path, opt, r)) {
+    fprintf(stderr, "Cannot write %s\n", opt.report_path.c_str());
+  }
+  if (!opt.baseline_path.empty()) {
+    print_comparison(opt.baseline_path, r);
+  }
+
+  bool clean = parse_errors == 0 && bad_jpeg == 0 && starved == 0 && snapshots.bad_body == 0 &&
+               request_failures(status) == 0 && request_failures(control) == 0;
+  return clean ? 0 : 2;
+}
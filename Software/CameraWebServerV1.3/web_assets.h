@@ -0,0 +1,263 @@
+// Generated by tools/build_assets.py from the sketch sources. Do not edit.
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <pgmspace.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+  const char *uri;          // Path the asset is served on
+  const char *type;         // Content-Type
+  const char *etag;         // Quoted strong ETag (content hash)
+  const uint8_t *data;      // gzip-compressed body
+  size_t len;
+} web_asset_t;
+
+// index.html: 15812 bytes, 4716 gzipped
+static const uint8_t asset_index_html[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x5b, 0xeb, 0x96, 0xdb, 0x36, 0x92, 0xfe, 0x9f, 0xa7,
+  0x80, 0xe5, 0xec, 0x88, 0xda, 0x48, 0xd4, 0xa5, 0x2f, 0x6e, 0xab, 0x2f, 0x59, 0xdb, 0xb1, 0x67, 0x3c, 0xeb, 0xdb, 0xa4,
+  0xe3, 0x78, 0xce, 0xe6, 0xe4, 0xb8, 0x21, 0x12, 0x94, 0x98, 0xa6, 0x08, 0x85, 0x20, 0x5b, 0xad, 0xe9, 0xe9, 0xe7, 0x9a,
+  0xff, 0xf3, 0x64, 0x5b, 0x05, 0x80, 0x20, 0x40, 0xb2, 0x25, 0x39, 0xe3, 0xe3, 0x73, 0x6c, 0x8a, 0x40, 0x15, 0x0a, 0x85,
+  0xaa, 0xaf, 0x2e, 0xa0, 0xcf, 0x1e, 0x85, 0x3c, 0xc8, 0x37, 0x2b, 0x46, 0x16, 0xf9, 0x32, 0xb9, 0xf8, 0xe6, 0x0c, 0xff,
+  0x21, 0x09, 0x4d, 0xe7, 0xe7, 0x1d, 0x96, 0x76, 0xf0, 0x05, 0xa3, 0xe1, 0xc5, 0x37, 0x84, 0x9c, 0x2d, 0x59, 0x4e, 0x49,
+  0xb0, 0xa0, 0x99, 0x60, 0xf9, 0x79, 0xa7, 0xc8, 0xa3, 0xc1, 0x49, 0xa7, 0x1a, 0x48, 0xe9, 0x92, 0x9d, 0x77, 0x6e, 0x62,
+  0xb6, 0x5e, 0xf1, 0x2c, 0xef, 0x90, 0x80, 0xa7, 0x39, 0x4b, 0x61, 0xe2, 0x3a, 0x0e, 0xf3, 0xc5, 0x79, 0xc8, 0x6e, 0xe2,
+  0x80, 0x0d, 0xe4, 0x8f, 0x3e, 0x89, 0xd3, 0x38, 0x8f, 0x69, 0x32, 0x10, 0x01, 0x4d, 0xd8, 0xf9, 0x58, 0xb1, 0xc9, 0xe3,
+  0x3c, 0x61, 0x17, 0x3f, 0x14, 0x2c, 0x27, 0x6f, 0x39, 0x4c, 0xe0, 0x19, 0x79, 0x41, 0x97, 0x67, 0x43, 0xf5, 0x1e, 0x67,
+  0x88, 0x7c, 0xa3, 0x9e, 0x08, 0x99, 0x66, 0x9c, 0xe7, 0xe4, 0x4e, 0x3e, 0x13, 0x32, 0x18, 0xcc, 0xe6, 0x53, 0xf2, 0x78,
+  0xc4, 0xc6, 0xa3, 0xf1, 0xe1, 0xa9, 0x79, 0xb9, 0xa2, 0x29, 0x4b, 0xe0, 0xfd, 0xf8, 0x78, 0x4c, 0x27, 0x93, 0xea, 0x3d,
+  0x0d, 0x02, 0x10, 0x0d, 0x06, 0x0e, 0x69, 0xc8, 0x4e, 0x46, 0xf5, 0x81, 0xc1, 0x9a, 0xd1, 0x6b, 0x18, 0xa5, 0x07, 0xec,
+  0xf8, 0xe0, 0xa8, 0x1a, 0xcd, 0xd9, 0x2d, 0x12, 0xb1, 0x23, 0xf6, 0x84, 0xcd, 0xaa, 0xd7, 0xcb, 0x22, 0x67, 0x21, 0xbc,
+  0x7f, 0x7a, 0x48, 0x0f, 0x66, 0x27, 0xd5, 0xfb, 0x19, 0xcf, 0x42, 0x96, 0xe1, 0xf2, 0xd1, 0xe4, 0xe9, 0xc1, 0x13, 0x35,
+  0x70, 0x2f, 0xff, 0xfe, 0x6f, 0x72, 0x47, 0x66, 0xfc, 0x76, 0x20, 0xe2, 0x7f, 0xc4, 0x29, 0x48, 0xae, 0xa6, 0x02, 0xc5,
+  0xed, 0xa9, 0x9e, 0x31, 0xe3, 0xe1, 0xc6, 0x6c, 0x6f, 0x49, 0xb3, 0x79, 0x9c, 0x4e, 0x89, 0x91, 0x34, 0x02, 0xe5, 0x0e,
+  0x22, 0xba, 0x8c, 0x93, 0xcd, 0x94, 0x74, 0x5e, 0x83, 0xa6, 0xb3, 0x4e, 0x9f, 0x74, 0x2e, 0xd9, 0x9c, 0x33, 0xf2, 0xf1,
+  0x35, 0x3c, 0x8b, 0x8d, 0xc8, 0xd9, 0x72, 0x50, 0xc4, 0x7d, 0x32, 0xa0, 0xab, 0x55, 0xc2, 0x06, 0xea, 0x0d, 0x8c, 0xd0,
+  0x54, 0x0c, 0x04, 0xcb, 0xe2, 0xa8, 0xe4, 0x36, 0xa3, 0xc1, 0xf5, 0x3c, 0xe3, 0x45, 0x0a, 0xbb, 0xb8, 0xa1, 0x99, 0x87,
+  0xda, 0xec, 0x95, 0x83, 0x01, 0x4f, 0x78, 0x56, 0xbe, 0x47, 0x0d, 0x98, 0x91, 0x15, 0x0d, 0x43, 0x29, 0xfd, 0xf8, 0x64,
+  0x75, 0x6b, 0xef, 0x0e, 0x2d, 0x86, 0x65, 0x46, 0xfa, 0x30, 0x16, 0xab, 0x84, 0x82, 0xa0, 0x51, 0xc2, 0x6e, 0x4b, 0xe2,
+  0xdf, 0x0a, 0x91, 0xc7, 0xd1, 0x66, 0xa0, 0xcd, 0x64, 0x4a, 0xc4, 0x8a, 0x82, 0x7d, 0xcc, 0x58, 0xbe, 0x66, 0x2c, 0x2d,
+  0x67, 0xd1, 0x24, 0x9e, 0xa7, 0x83, 0x18, 0xe4, 0x16, 0x53, 0x82, 0x47, 0xc3, 0xb2, 0x72, 0x68, 0x4e, 0x57, 0xb0, 0xf2,
+  0x64, 0x65, 0x38, 0x22, 0xf7, 0xc1, 0x3a, 0xc3, 0xd7, 0xf8, 0xf7, 0xa9, 0xa3, 0x3b, 0x50, 0x6d, 0x9e, 0xf3, 0xa5, 0x4d,
+  0xa1, 0x65, 0x1d, 0xef, 0xd0, 0x32, 0x1c, 0x11, 0x03, 0x32, 0x7f, 0x9c, 0xb1, 0x65, 0x39, 0x90, 0xb0, 0x1c, 0x24, 0x19,
+  0xa0, 0xc8, 0x52, 0x01, 0x23, 0x7f, 0x34, 0x29, 0x47, 0x15, 0x5b, 0x5f, 0x14, 0x33, 0x69, 0xb7, 0x70, 0xd0, 0x8e, 0x06,
+  0xa5, 0xb1, 0xf4, 0x4e, 0x6d, 0xde, 0x23, 0xff, 0x29, 0xf2, 0x2e, 0x25, 0xcd, 0x39, 0xec, 0xe0, 0x70, 0x65, 0x2c, 0xc1,
+  0x17, 0x39, 0xcd, 0x0b, 0xb1, 0x5d, 0x9d, 0xbb, 0x14, 0x75, 0x62, 0xe9, 0xa9, 0xb1, 0xb2, 0x2d, 0xf7, 0x8c, 0x86, 0x73,
+  0x66, 0xd6, 0x32, 0x47, 0x7c, 0xbc, 0xba, 0x25, 0xe3, 0x51, 0xc5, 0x44, 0x1b, 0x6c, 0x46, 0xc3, 0xb8, 0x80, 0x15, 0x9f,
+  0x3e, 0x7d, 0x5a, 0x1f, 0x03, 0x9d, 0x01, 0x8d, 0xe0, 0x49, 0x1c, 0x96, 0x46, 0x25, 0xdf, 0xf7, 0xda, 0xac, 0xee, 0xf1,
+  0x78, 0x3c, 0x3e, 0x99, 0x3c, 0x69, 0xb5, 0x39, 0xad, 0x31, 0x5b, 0xfa, 0x35, 0x8b, 0xe7, 0x0b, 0xb0, 0x99, 0xe3, 0xd1,
+  0xe8, 0x0b, 0x8e, 0x44, 0x6e, 0xcd, 0x5f, 0x53, 0x80, 0x9e, 0x74, 0x5e, 0x9d, 0xcb, 0xe3, 0x68, 0x36, 0x8b, 0x26, 0x87,
+  0xa7, 0xe5, 0x9e, 0xdc, 0xd7, 0xe3, 0xf1, 0xa9, 0x4b, 0x9f, 0xc4, 0x37, 0x8d, 0x43, 0x55, 0xb0, 0xd1, 0x6b, 0xb0, 0x50,
+  0xf0, 0xd2, 0x60, 0xc1, 0xb2, 0x0c, 0xb0, 0xcd, 0x12, 0xe0, 0xe4, 0xc9, 0xf8, 0xc9, 0xb8, 0x29, 0x80, 0x7c, 0xad, 0xa8,
+  0x15, 0x39, 0x1c, 0x3b, 0x2f, 0xf2, 0xa6, 0x25, 0xcc, 0xb3, 0x38, 0x34, 0xc7, 0x0d, 0xcf, 0xe0, 0xa7, 0x4b, 0x18, 0xc9,
+  0x19, 0xf2, 0x2a, 0x96, 0xa9, 0x40, 0x03, 0x3e, 0x88, 0x32, 0x32, 0x8e, 0x6a, 0xfe, 0x73, 0xe8, 0x7a, 0xc3, 0xff, 0x2c,
+  0x59, 0x18, 0x53, 0xe2, 0x2d, 0xe9, 0xad, 0x82, 0x6a, 0x38, 0xda, 0x63, 0x38, 0xf6, 0x9e, 0x59, 0xd3, 0xc8, 0xf0, 0xe0,
+  0x42, 0xb0, 0x84, 0xe6, 0x56, 0x8a, 0x2d, 0x61, 0xd8, 0x70, 0x68, 0xa2, 0x8d, 0x1c, 0xef, 0x7d, 0xa9, 0xf9, 0xb8, 0x16,
+  0x68, 0x23, 0x41, 0x05, 0x4c, 0x87, 0xb6, 0x55, 0x02, 0xdc, 0x2e, 0x68, 0xc8, 0xd7, 0x60, 0x1c, 0xd2, 0x96, 0xc9, 0x01,
+  0xfe, 0x95, 0xcd, 0x67, 0xd4, 0x1b, 0xf5, 0xe5, 0x1f, 0x7f, 0x72, 0xd4, 0x3b, 0x75, 0x44, 0x17, 0x79, 0xc6, 0xe8, 0x72,
+  0x10, 0x65, 0x10, 0xdd, 0x5a, 0x77, 0xf0, 0x78, 0x34, 0x1b, 0x85, 0xe3, 0xc9, 0x7f, 0x28, 0xfc, 0xa8, 0x45, 0xf8, 0xe3,
+  0xea, 0x1d, 0xc2, 0xee, 0x40, 0xba, 0x78, 0xdd, 0xb9, 0x97, 0x00, 0x18, 0x0b, 0xed, 0x0d, 0x93, 0xc9, 0xc8, 0x3d, 0xcd,
+  0xc7, 0x4a, 0x7a, 0x0b, 0xe0, 0xcc, 0xa9, 0x8e, 0x47, 0xa3, 0xff, 0x2a, 0x79, 0xb4, 0xbc, 0xaa, 0xc9, 0x77, 0xb2, 0xcd,
+  0xb9, 0x1f, 0x8f, 0xa2, 0xf1, 0x93, 0x09, 0x6d, 0x75, 0x6b, 0x7b, 0xa8, 0xa6, 0x52, 0x1a, 0xe4, 0x31, 0x4f, 0x45, 0x0d,
+  0x7d, 0x15, 0xfa, 0xd9, 0xfa, 0x68, 0x85, 0xbb, 0x06, 0xa6, 0xb5, 0x63, 0x7f, 0x23, 0xc8, 0xc8, 0x79, 0x2c, 0x0d, 0x1d,
+  0x89, 0x16, 0x13, 0xb0, 0x66, 0x03, 0xfe, 0xf0, 0x07, 0x18, 0x43, 0x10, 0x70, 0xe0, 0x5f, 0x02, 0xb4, 0x76, 0x62, 0xe4,
+  0x96, 0xf1, 0x64, 0x80, 0x0e, 0xf0, 0x87, 0x7c, 0x31, 0x63, 0x2b, 0x46, 0x73, 0x8f, 0x16, 0x39, 0x1f, 0x44, 0x71, 0xde,
+  0xc7, 0x53, 0x84, 0xb3, 0xf1, 0xc6, 0xe8, 0x6a, 0x7d, 0xf4, 0xa0, 0x5e, 0xcf, 0x75, 0x53, 0x4b, 0x1f, 0x3b, 0xe2, 0x59,
+  0x42, 0x67, 0xe8, 0x6b, 0x7b, 0x07, 0x1d, 0x23, 0xf7, 0x2c, 0xe1, 0xc1, 0xf5, 0x69, 0x9d, 0xbd, 0x15, 0x87, 0x04, 0x4b,
+  0x58, 0x00, 0xc2, 0xce, 0x0a, 0x18, 0x4a, 0xcd, 0xc6, 0x5b, 0xac, 0xa7, 0xf2, 0x3f, 0x74, 0x30, 0xdb, 0x33, 0xb7, 0xd8,
+  0xfd, 0x1f, 0x89, 0x1a, 0xe0, 0x7b, 0x60, 0x60, 0xbb, 0x33, 0x15, 0x77, 0xdf, 0x47, 0xb5, 0x98, 0xa7, 0x36, 0x36, 0x8d,
+  0x78, 0x50, 0x88, 0x72, 0x7b, 0xea, 0x17, 0xe8, 0x11, 0xb0, 0x2e, 0x89, 0x53, 0x20, 0x9c, 0x54, 0x06, 0x3f, 0x39, 0x3a,
+  0x3e, 0x80, 0x04, 0xb0, 0x1c, 0x1b, 0xf0, 0x28, 0x82, 0x94, 0x58, 0x4e, 0x31, 0xe9, 0x9b, 0xe4, 0xe2, 0xaf, 0xb2, 0x18,
+  0x14, 0xba, 0xc1, 0x6c, 0xcf, 0x92, 0x1b, 0x89, 0x68, 0x06, 0xf6, 0x03, 0x6a, 0x00, 0xb3, 0xf4, 0xc6, 0x07, 0x47, 0x21,
+  0x9b, 0xf7, 0x81, 0xf1, 0x24, 0x38, 0x3a, 0x62, 0x7d, 0x4c, 0x58, 0xe9, 0xc1, 0x21, 0x35, 0x01, 0x65, 0x4a, 0x52, 0x9e,
+  0xb2, 0x53, 0x13, 0x30, 0xf4, 0xbe, 0xdd, 0x60, 0xf8, 0x04, 0x82, 0x21, 0x09, 0x8a, 0x4c, 0xe0, 0x94, 0x15, 0x8f, 0x25,
+  0x4c, 0xb8, 0xe2, 0x08, 0x06, 0xb6, 0x1b, 0x36, 0x05, 0x32, 0x0c, 0xb7, 0x92, 0x4f, 0x17, 0xfc, 0x06, 0xd3, 0x3a, 0x12,
+  0xc5, 0x49, 0x8e, 0x42, 0xcd, 0x32, 0x5c, 0x39, 0x65, 0x42, 0x78, 0x63, 0x7f, 0x04, 0xd0, 0xe9, 0x4e, 0x07, 0xd3, 0xa2,
+  0xb3, 0x84, 0x85, 0xa8, 0x45, 0x0c, 0xcb, 0xf9, 0x06, 0xd5, 0x7f, 0x5c, 0xad, 0x92, 0x72, 0x44, 0xb5, 0x84, 0xaf, 0x59,
+  0x58, 0xc5, 0x38, 0x83, 0x0b, 0x35, 0xcf, 0xaf, 0x7c, 0xbe, 0xe1, 0xed, 0x16, 0xb4, 0x60, 0xa6, 0x34, 0x08, 0x68, 0x16,
+  0x8a, 0xaf, 0xeb, 0x99, 0x87, 0xfb, 0x7b, 0x66, 0x0d, 0xc1, 0x4a, 0xd0, 0x00, 0x99, 0xaa, 0x00, 0xf2, 0xf5, 0xa2, 0x84,
+  0xe3, 0x42, 0x35, 0xe8, 0x3d, 0x9c, 0x8c, 0x1c, 0x19, 0xf6, 0xc7, 0x86, 0x93, 0x23, 0x1b, 0xf0, 0x6e, 0x68, 0x52, 0x60,
+  0xce, 0xd3, 0x00, 0xc4, 0xa6, 0xfd, 0xb5, 0xe4, 0xb0, 0x8a, 0xc7, 0x12, 0xac, 0x84, 0x62, 0x66, 0xd9, 0x54, 0x53, 0x1b,
+  0x2c, 0xb5, 0x8a, 0xe8, 0x04, 0xbb, 0x51, 0xe9, 0x6c, 0x67, 0x43, 0x5d, 0x16, 0x9e, 0x0d, 0x55, 0xa9, 0x7a, 0x86, 0xb5,
+  0x93, 0xac, 0x17, 0x55, 0x21, 0xa2, 0x0a, 0xc6, 0xb3, 0x30, 0xbe, 0xb9, 0xd0, 0x8a, 0x3a, 0x5b, 0x8c, 0x5b, 0xea, 0x4c,
+  0x78, 0x59, 0x8e, 0xc3, 0x5c, 0x12, 0x24, 0x54, 0x88, 0xf3, 0x4e, 0x99, 0xc8, 0x77, 0x2e, 0x2e, 0x19, 0x03, 0x63, 0xbe,
+  0xcc, 0x8b, 0x30, 0xe6, 0xe4, 0xef, 0xaf, 0x9f, 0xbd, 0x27, 0x2f, 0x2f, 0x3f, 0x1c, 0x4c, 0x06, 0x97, 0x07, 0xe4, 0x92,
+  0xa5, 0x82, 0x91, 0x7f, 0xff, 0x8b, 0xbc, 0xff, 0xf9, 0xe0, 0xf8, 0x78, 0x74, 0x36, 0x34, 0x8b, 0xd9, 0x8f, 0x36, 0x57,
+  0x69, 0xa9, 0x1d, 0xb3, 0x20, 0xe4, 0xad, 0x29, 0x89, 0xc3, 0x72, 0x60, 0x10, 0x72, 0x2c, 0xa1, 0xd5, 0x5c, 0x95, 0x92,
+  0xeb, 0xbc, 0xb5, 0x73, 0xf1, 0x49, 0x3d, 0xc0, 0xb6, 0x81, 0xe6, 0x41, 0x06, 0x88, 0x7f, 0x9d, 0xe6, 0x1e, 0x5e, 0xab,
+  0xc2, 0x5b, 0x96, 0x9d, 0x44, 0x45, 0x62, 0xdf, 0xf7, 0x6d, 0x5e, 0x46, 0x60, 0xa5, 0x4e, 0x54, 0xdf, 0x37, 0xae, 0xec,
+  0x2a, 0x03, 0xd4, 0xb2, 0x9f, 0x01, 0xa6, 0xa0, 0xc3, 0x96, 0x83, 0x32, 0x97, 0xeb, 0xb4, 0x2a, 0xd2, 0x4a, 0xa5, 0xcc,
+  0x04, 0x98, 0x12, 0x2f, 0xe7, 0x5a, 0x70, 0x1c, 0xef, 0x40, 0x29, 0x93, 0x9f, 0x77, 0xde, 0x60, 0x96, 0x5d, 0xbe, 0x19,
+  0x1a, 0x76, 0x43, 0xfb, 0x10, 0x9b, 0xbc, 0x35, 0x76, 0xd8, 0xdc, 0x75, 0xb4, 0x2a, 0xe7, 0x95, 0x00, 0xd8, 0x91, 0x4b,
+  0x66, 0x2c, 0xe1, 0x34, 0x1c, 0xcc, 0xf2, 0xb4, 0x73, 0xf1, 0xa3, 0x7c, 0x86, 0xe3, 0x45, 0x4e, 0x67, 0x43, 0x45, 0xb7,
+  0x2f, 0x23, 0x91, 0xd2, 0x95, 0x58, 0x00, 0x9c, 0x49, 0x56, 0x97, 0xfa, 0x57, 0x9d, 0x8b, 0x63, 0x16, 0x5a, 0x6f, 0x17,
+  0xdf, 0xec, 0xa3, 0xc6, 0xc5, 0xe4, 0xe2, 0x85, 0xca, 0x3a, 0x04, 0x1c, 0xcb, 0xa4, 0x4d, 0x05, 0x76, 0x56, 0x62, 0x2b,
+  0xc0, 0xd2, 0x98, 0xfc, 0xad, 0x40, 0x20, 0xe2, 0x19, 0x6e, 0x1f, 0xc0, 0xa7, 0xc0, 0x65, 0x71, 0xfb, 0xe5, 0xf3, 0xd9,
+  0x50, 0x4e, 0x71, 0x88, 0x54, 0x88, 0xd4, 0x3a, 0xab, 0x88, 0xac, 0x29, 0x30, 0x89, 0xaf, 0xe4, 0x0e, 0x24, 0x5a, 0x80,
+  0x4a, 0x6e, 0xe6, 0x14, 0x54, 0xf1, 0xf3, 0x9f, 0x9f, 0x11, 0xef, 0x64, 0x34, 0xba, 0x85, 0x5a, 0xad, 0x77, 0x36, 0x54,
+  0x73, 0xb6, 0x12, 0x46, 0x0b, 0x90, 0x7f, 0x3c, 0x3a, 0x19, 0xad, 0xda, 0xa6, 0xa3, 0xe2, 0x50, 0x16, 0x6b, 0x87, 0x43,
+  0x67, 0x8b, 0xdb, 0x36, 0xfc, 0x7b, 0x01, 0xa6, 0x9f, 0x6f, 0x3a, 0x17, 0x7f, 0xfd, 0xf0, 0xf2, 0xcf, 0xe4, 0x6f, 0xea,
+  0xd7, 0x8e, 0xfd, 0x1a, 0x9a, 0x6d, 0x32, 0x8f, 0x27, 0x9d, 0x8b, 0xbf, 0x00, 0x30, 0x11, 0x6f, 0x3c, 0xd9, 0x6f, 0x97,
+  0xe3, 0x93, 0xce, 0xc5, 0x73, 0x9a, 0xd0, 0x34, 0x00, 0x4c, 0xf1, 0xc6, 0x27, 0xfb, 0x51, 0x4d, 0x0e, 0x91, 0x2a, 0x0d,
+  0x65, 0xd2, 0x45, 0x2e, 0x29, 0xc6, 0x63, 0x6f, 0x72, 0xd8, 0xfb, 0xea, 0x9a, 0x8a, 0x56, 0xe0, 0x45, 0xca, 0x17, 0xc8,
+  0x07, 0x1a, 0xb0, 0x1d, 0x4a, 0x92, 0xd3, 0xb7, 0x09, 0x3e, 0xea, 0x5c, 0x1c, 0x8c, 0x08, 0x4c, 0x93, 0xb5, 0xe5, 0x9e,
+  0x2a, 0x7a, 0x02, 0x54, 0xc7, 0x8a, 0x28, 0xe0, 0x3c, 0xd9, 0x8f, 0xea, 0xe0, 0x00, 0xd7, 0xaa, 0xa8, 0x98, 0xc8, 0xbf,
+  0xbe, 0x7a, 0xfe, 0xc1, 0xf9, 0x12, 0x03, 0x42, 0x0a, 0x79, 0x0c, 0xf9, 0x3f, 0xf8, 0xb1, 0x43, 0x3f, 0x6a, 0xfe, 0xd6,
+  0xcd, 0x8e, 0x40, 0xec, 0xf1, 0x2d, 0xf1, 0xa2, 0x22, 0x81, 0x45, 0x10, 0x24, 0xf7, 0xd4, 0xd2, 0x11, 0x12, 0xfa, 0x47,
+  0xb7, 0xfb, 0x19, 0x10, 0x2e, 0x33, 0xd9, 0x73, 0x2e, 0x72, 0x9e, 0x3c, 0xc0, 0x79, 0x87, 0xfa, 0x1e, 0x44, 0xea, 0x9d,
+  0x10, 0xad, 0x53, 0x66, 0x85, 0xab, 0xd8, 0xb9, 0xdc, 0x28, 0x50, 0x7d, 0x86, 0x8f, 0x10, 0x68, 0x73, 0x0c, 0x7e, 0xe2,
+  0x4b, 0x01, 0x3a, 0x63, 0x11, 0x00, 0xd7, 0x62, 0xa0, 0xa3, 0xa3, 0x46, 0x7c, 0xf9, 0x0e, 0x20, 0x1f, 0xdf, 0x6d, 0x01,
+  0xeb, 0xb6, 0xd0, 0xad, 0x92, 0xcc, 0x1a, 0xd0, 0x1a, 0x2c, 0x86, 0x31, 0xe7, 0xb8, 0xdd, 0xf0, 0x39, 0x43, 0x68, 0x7f,
+  0x51, 0x64, 0x19, 0x24, 0xff, 0xc4, 0x06, 0xde, 0xba, 0xc5, 0x59, 0x54, 0xf2, 0x4c, 0xd4, 0x5e, 0x02, 0x45, 0x39, 0x00,
+  0xe1, 0x15, 0xc0, 0xd6, 0x0d, 0xb7, 0x69, 0xc7, 0x5f, 0x22, 0x98, 0x8b, 0x8d, 0x5f, 0x26, 0x92, 0x01, 0xcb, 0xc1, 0xd7,
+  0x95, 0xe9, 0x83, 0xec, 0xea, 0x7d, 0xa9, 0x34, 0x12, 0x95, 0xb6, 0x4a, 0xf2, 0xe0, 0x21, 0xeb, 0x74, 0x55, 0xf1, 0x2b,
+  0x7f, 0x5c, 0xb4, 0x07, 0x70, 0xc3, 0x46, 0x5e, 0x51, 0x04, 0x59, 0xbc, 0xd2, 0x5e, 0x01, 0x16, 0x28, 0x72, 0xa2, 0xec,
+  0xe5, 0x07, 0x9e, 0x93, 0x73, 0x12, 0x42, 0x55, 0xb9, 0x04, 0xd1, 0xfc, 0x39, 0xcb, 0x5f, 0x26, 0x0c, 0x1f, 0x9f, 0x6f,
+  0x5e, 0x87, 0x5e, 0xb7, 0x4a, 0xfb, 0xba, 0x3a, 0xfd, 0xb7, 0x89, 0x7f, 0x82, 0x64, 0x6e, 0x0f, 0x6a, 0xcc, 0xf9, 0xea,
+  0xe4, 0x88, 0xe0, 0xaf, 0x21, 0xc3, 0xda, 0x4a, 0x8d, 0x93, 0x5c, 0xc2, 0x2a, 0xca, 0x5f, 0x2a, 0x14, 0xdb, 0x42, 0x5f,
+  0xcd, 0x75, 0x79, 0x68, 0x63, 0xd8, 0xcd, 0x40, 0x4f, 0x74, 0xa9, 0xe1, 0xf0, 0x76, 0x53, 0xc2, 0x24, 0x97, 0x0a, 0x81,
+  0x76, 0x37, 0x19, 0xce, 0x72, 0xe9, 0x24, 0xd0, 0x3c, 0xcf, 0xd3, 0x6d, 0x54, 0x06, 0x8c, 0xea, 0xaa, 0x92, 0x30, 0xa2,
+  0x50, 0x64, 0x07, 0x8b, 0x26, 0x0c, 0xd5, 0x79, 0x61, 0x12, 0xba, 0x93, 0x49, 0x99, 0xb5, 0xd6, 0x0e, 0x5b, 0xa7, 0x9d,
+  0x3b, 0xc8, 0xed, 0x5c, 0xd5, 0x65, 0xa0, 0xed, 0xfc, 0x39, 0xbf, 0xdd, 0x46, 0xaf, 0x67, 0xb9, 0xa4, 0xda, 0xe5, 0x00,
+  0xcc, 0xb6, 0x91, 0x5a, 0xc8, 0xd5, 0x4a, 0xae, 0x51, 0x67, 0x1f, 0x16, 0xad, 0x36, 0xa3, 0x07, 0x5f, 0xad, 0xf6, 0x92,
+  0x42, 0x1b, 0x8f, 0x6b, 0x73, 0x6f, 0x10, 0x70, 0x90, 0xbc, 0xac, 0xd5, 0x47, 0x53, 0xd2, 0xb5, 0x53, 0x97, 0x6e, 0x5f,
+  0x0f, 0x40, 0x7a, 0x02, 0x43, 0x32, 0x3f, 0x31, 0xef, 0x20, 0xf9, 0xc0, 0xe9, 0xf2, 0x9d, 0xaa, 0xbc, 0x35, 0xff, 0xa8,
+  0x48, 0x55, 0x7e, 0x2f, 0x58, 0xae, 0x2c, 0xc5, 0x43, 0x1b, 0x60, 0x7d, 0xd9, 0xdb, 0xad, 0xda, 0xeb, 0x06, 0x2c, 0x7c,
+  0x09, 0x44, 0x6f, 0x62, 0x91, 0xfb, 0x50, 0x10, 0xf3, 0x1b, 0xe6, 0x75, 0x75, 0x05, 0xd8, 0xed, 0x93, 0x2e, 0x5e, 0x42,
+  0xe0, 0xbf, 0xf2, 0x26, 0xa1, 0x6b, 0x1a, 0x06, 0x6d, 0xd4, 0x34, 0x0c, 0xd5, 0x52, 0xb5, 0x59, 0x88, 0x29, 0x3e, 0x2e,
+  0xfe, 0x42, 0x35, 0x47, 0x61, 0xcb, 0xf8, 0xcb, 0xe9, 0x8c, 0xda, 0x52, 0xbf, 0x55, 0xc7, 0xee, 0x2d, 0xc5, 0xbc, 0x4f,
+  0x62, 0xf1, 0x52, 0xde, 0x61, 0x9c, 0x93, 0x88, 0x26, 0x82, 0x55, 0xf2, 0x57, 0x26, 0x54, 0xe3, 0x0d, 0x64, 0xe4, 0x9f,
+  0xff, 0x24, 0xdd, 0xee, 0x69, 0x73, 0xa6, 0xac, 0xdf, 0x7d, 0x59, 0xf2, 0xc3, 0xcc, 0x92, 0xf7, 0xf7, 0xa4, 0xab, 0xaf,
+  0x40, 0xba, 0x04, 0x94, 0x6a, 0xb7, 0x02, 0xba, 0x8e, 0x94, 0xc3, 0x21, 0x91, 0xe5, 0x22, 0xde, 0x3d, 0x4f, 0x55, 0xea,
+  0x24, 0x08, 0xcd, 0x18, 0x59, 0x15, 0x62, 0x01, 0xd9, 0xb5, 0xec, 0x5a, 0x51, 0xf2, 0x89, 0xcd, 0x2e, 0x79, 0x70, 0x0d,
+  0x55, 0xbf, 0x37, 0x5c, 0x8b, 0x1e, 0xc9, 0x39, 0x18, 0xc6, 0x02, 0x86, 0xd6, 0x31, 0xe4, 0xd2, 0x4a, 0x29, 0x25, 0xbf,
+  0x90, 0x25, 0x39, 0x05, 0x26, 0x69, 0x48, 0x74, 0x5d, 0x85, 0xad, 0xa1, 0x24, 0x66, 0xa2, 0x4f, 0x04, 0x07, 0x66, 0xb8,
+  0x16, 0x90, 0x06, 0x5c, 0xe4, 0x82, 0xf0, 0x14, 0x6a, 0x55, 0xc9, 0xda, 0x27, 0x2f, 0x69, 0xb0, 0x50, 0x32, 0xc0, 0x46,
+  0x4a, 0x76, 0x14, 0xc6, 0x40, 0x0e, 0xc8, 0xf5, 0x81, 0x73, 0xc0, 0x43, 0x16, 0xf6, 0xc9, 0x7a, 0x11, 0xc3, 0xcc, 0x58,
+  0xc0, 0x03, 0xcd, 0x09, 0x5e, 0x7e, 0x0a, 0x02, 0xe2, 0x10, 0x75, 0x51, 0xee, 0x93, 0xe7, 0x19, 0x5f, 0x0b, 0x96, 0x81,
+  0xd5, 0xf1, 0xac, 0xe4, 0xb3, 0xca, 0xf8, 0x2d, 0xc8, 0xd0, 0x93, 0x22, 0xe3, 0x2d, 0x4c, 0xb5, 0x27, 0x51, 0xac, 0xf0,
+  0xde, 0x1d, 0xcf, 0x23, 0x91, 0x8d, 0x20, 0xd8, 0x9f, 0xe4, 0xf7, 0x56, 0xc6, 0xf3, 0xa1, 0xae, 0xf5, 0x2d, 0x63, 0xff,
+  0x74, 0xf9, 0xf9, 0xed, 0xb3, 0xbf, 0x7f, 0x7e, 0xf5, 0xec, 0xf5, 0x9b, 0x8f, 0x3f, 0xbe, 0xbc, 0x04, 0xcd, 0x1f, 0x28,
+  0xb5, 0x26, 0xc0, 0x6e, 0x8d, 0x2e, 0x90, 0x42, 0x2a, 0x6a, 0xbf, 0x7a, 0x45, 0xe3, 0xa4, 0xc8, 0xa4, 0x8b, 0x8f, 0xaa,
+  0xf7, 0x85, 0x60, 0x6f, 0x7f, 0x5b, 0x31, 0x0c, 0x31, 0x8f, 0xbc, 0xae, 0x91, 0xa8, 0x4b, 0xe2, 0x14, 0xe4, 0x4c, 0x43,
+  0xbe, 0xee, 0x55, 0x93, 0x11, 0xb9, 0xc0, 0x86, 0x3f, 0x66, 0x49, 0x83, 0xbf, 0x1e, 0xba, 0x64, 0xbf, 0xbb, 0xfc, 0x01,
+  0xab, 0xd6, 0x69, 0x1b, 0xc1, 0x8a, 0xa5, 0x48, 0xa0, 0x0b, 0x63, 0x67, 0x58, 0xed, 0x10, 0xbd, 0x44, 0x39, 0x1b, 0xfa,
+  0x73, 0xc3, 0x15, 0x15, 0x8e, 0xaa, 0x22, 0xc7, 0xb3, 0x5c, 0xd0, 0x78, 0xa8, 0xed, 0x71, 0xaa, 0x3d, 0xe0, 0x74, 0x4d,
+  0x2a, 0xbf, 0x8b, 0x23, 0xe2, 0x3d, 0x2a, 0xf5, 0x50, 0x71, 0x52, 0x03, 0x68, 0x6b, 0x77, 0x56, 0xd2, 0xb2, 0x16, 0xe0,
+  0x9d, 0x5c, 0x30, 0xcf, 0x90, 0x83, 0x25, 0x13, 0x00, 0x1d, 0xe6, 0x4c, 0x83, 0x2d, 0xa4, 0x10, 0xc6, 0x3e, 0x09, 0x67,
+  0x9e, 0x79, 0xca, 0x58, 0x5e, 0x64, 0xe6, 0x9e, 0xfc, 0xde, 0xb4, 0xc0, 0x71, 0xdf, 0xb3, 0x42, 0xa0, 0xcb, 0xfd, 0x00,
+  0x4e, 0xef, 0xa7, 0x7c, 0xed, 0x59, 0x9e, 0xaf, 0xd3, 0x01, 0x5f, 0x64, 0x01, 0xcc, 0xb8, 0xd2, 0x66, 0xf1, 0x7d, 0x76,
+  0xfe, 0xed, 0x1d, 0x52, 0xdd, 0x5f, 0xb5, 0xfb, 0xbf, 0x25, 0x8c, 0x11, 0x52, 0xed, 0x0d, 0x9d, 0xda, 0x20, 0xed, 0x4d,
+  0x2c, 0xe2, 0x59, 0x2c, 0x83, 0x3e, 0x22, 0x0e, 0x39, 0x3f, 0x3f, 0x27, 0xdd, 0x45, 0x1c, 0x86, 0x0c, 0x22, 0x4d, 0x4d,
+  0x64, 0x1d, 0xb3, 0x82, 0x05, 0x20, 0x33, 0x88, 0x92, 0xf0, 0x80, 0xe2, 0x52, 0x3e, 0xd8, 0x78, 0xce, 0x03, 0x3c, 0x4f,
+  0x49, 0x9c, 0xe7, 0x2b, 0x31, 0xed, 0x22, 0x18, 0xac, 0x85, 0x90, 0x40, 0xb0, 0x16, 0xdd, 0x1a, 0x0f, 0xe5, 0x01, 0x70,
+  0xfe, 0x6c, 0x5d, 0x79, 0x84, 0x77, 0xf5, 0xed, 0x9d, 0xe2, 0x7e, 0x3f, 0x1d, 0x0e, 0xbf, 0xbd, 0x33, 0x0b, 0x2c, 0xc0,
+  0x67, 0xef, 0x01, 0x01, 0xae, 0x2a, 0xb5, 0x28, 0xdf, 0x9d, 0xc5, 0x29, 0xd4, 0x0b, 0x3f, 0xe1, 0xb7, 0x30, 0xb0, 0x32,
+  0xcd, 0x32, 0xba, 0x99, 0x15, 0x51, 0xc4, 0x32, 0xb3, 0x9e, 0xf4, 0x0a, 0x35, 0x5b, 0x1b, 0x93, 0x21, 0x06, 0x98, 0x7d,
+  0x79, 0x03, 0x3a, 0x40, 0xcc, 0x65, 0x29, 0xcb, 0xbc, 0x2e, 0x07, 0xfb, 0x04, 0xcb, 0x01, 0x8d, 0x9d, 0x5f, 0x58, 0x27,
+  0xdb, 0x6e, 0x5e, 0xba, 0xa9, 0x87, 0xd5, 0xa5, 0x46, 0x30, 0xc7, 0xc0, 0xee, 0xeb, 0xb2, 0x36, 0x97, 0x2b, 0xc3, 0x32,
+  0xac, 0xc8, 0x6e, 0x6a, 0x6b, 0xe2, 0x51, 0xe1, 0x37, 0x3e, 0x3c, 0x22, 0xec, 0xc6, 0x0f, 0x69, 0x4e, 0x95, 0x76, 0xe1,
+  0xf4, 0x71, 0x7d, 0xd7, 0x3e, 0x17, 0x80, 0x7a, 0x09, 0xfb, 0x24, 0x03, 0x84, 0xf7, 0xd7, 0xcb, 0xf7, 0xef, 0xfc, 0x15,
+  0x7e, 0xf2, 0xe3, 0x69, 0xca, 0xde, 0x76, 0xb3, 0x45, 0x6f, 0x7d, 0x85, 0x1b, 0x30, 0xf3, 0x9b, 0xd6, 0xbb, 0xc7, 0x6e,
+  0xa4, 0x87, 0xb4, 0x68, 0x4f, 0x1b, 0xdd, 0xa3, 0xf3, 0xf2, 0x1c, 0xea, 0x66, 0x45, 0xea, 0xd0, 0x55, 0x52, 0xb9, 0x68,
+  0xe1, 0x6e, 0xd9, 0x1d, 0x83, 0x80, 0xfb, 0x1b, 0x18, 0xbb, 0x87, 0xe6, 0x24, 0x43, 0x91, 0xd7, 0x7d, 0xa1, 0xec, 0x1f,
+  0x5d, 0x01, 0x04, 0x83, 0x24, 0xdb, 0xda, 0x15, 0xd9, 0x06, 0x44, 0xae, 0xd3, 0xa2, 0x1c, 0xdf, 0x7d, 0x67, 0x01, 0xe9,
+  0xc5, 0x79, 0x1d, 0x86, 0x5d, 0xc1, 0x00, 0xf3, 0xdf, 0x31, 0x0c, 0x5f, 0x73, 0x28, 0x1f, 0x28, 0x40, 0x2d, 0x5e, 0xa8,
+  0x80, 0x09, 0x09, 0x01, 0xa2, 0x4c, 0x1f, 0x02, 0x7b, 0xe5, 0xd4, 0x16, 0x1b, 0x0b, 0xa2, 0xf3, 0xac, 0x60, 0xb6, 0xec,
+  0x2e, 0x08, 0xba, 0x23, 0xae, 0x5e, 0xef, 0x77, 0x98, 0xf0, 0x8f, 0x4c, 0xa3, 0x04, 0xfc, 0x76, 0x8c, 0x57, 0x12, 0xfc,
+  0x14, 0x2f, 0x19, 0x44, 0x2c, 0xcf, 0x20, 0x49, 0x9f, 0x4c, 0x46, 0xa3, 0x51, 0xc3, 0xc2, 0xab, 0x98, 0xfe, 0x5c, 0xba,
+  0x63, 0x99, 0x27, 0x4c, 0x49, 0x71, 0x30, 0x01, 0x46, 0xbf, 0x17, 0x0c, 0xc3, 0x28, 0x46, 0x66, 0x7c, 0x91, 0x03, 0x5b,
+  0x08, 0xdd, 0xcb, 0x15, 0xf1, 0x00, 0x76, 0xf2, 0x84, 0xe1, 0xed, 0x6e, 0x4c, 0xd3, 0x5e, 0x1f, 0xf5, 0x91, 0x4a, 0xa5,
+  0xa0, 0x4e, 0x6a, 0xe9, 0x8c, 0x31, 0x52, 0x70, 0xf0, 0x4a, 0xe3, 0x1a, 0x4e, 0x64, 0x00, 0xc2, 0xc3, 0x07, 0x00, 0xa5,
+  0x3f, 0x43, 0xa0, 0x97, 0xb3, 0x30, 0x8d, 0xfc, 0x18, 0xa7, 0xf9, 0xc1, 0xc4, 0x1b, 0xf5, 0xa5, 0x1a, 0x7b, 0x15, 0x2c,
+  0x38, 0x91, 0x11, 0x85, 0x7f, 0x9f, 0x26, 0x9b, 0xf2, 0x9c, 0x30, 0xae, 0x43, 0x88, 0x4f, 0xe5, 0x41, 0x42, 0x66, 0x11,
+  0xab, 0x7c, 0x44, 0x25, 0x09, 0x01, 0x2f, 0x20, 0x3f, 0x82, 0x5c, 0x23, 0xd2, 0x2c, 0x2c, 0x74, 0xad, 0x82, 0xa5, 0x6d,
+  0x15, 0xc0, 0xfd, 0xb2, 0x58, 0x41, 0x66, 0xc0, 0x20, 0x8f, 0x20, 0x33, 0x06, 0x90, 0x01, 0xb9, 0x06, 0xc4, 0x67, 0x60,
+  0xa2, 0xb3, 0x0b, 0x33, 0xf7, 0xe3, 0x8f, 0x6f, 0xc0, 0x9a, 0x6f, 0xf8, 0x35, 0x7b, 0x3f, 0x43, 0x9b, 0x86, 0xdf, 0x36,
+  0xd7, 0x7a, 0xf8, 0x70, 0x42, 0x30, 0xe8, 0xe1, 0xd4, 0x7d, 0xaf, 0x82, 0x30, 0xf2, 0x0c, 0xc0, 0x5c, 0x72, 0x8b, 0x27,
+  0x6a, 0xeb, 0x79, 0xc2, 0x67, 0xde, 0x2f, 0xf8, 0x84, 0x6a, 0x3a, 0x79, 0x86, 0xf8, 0x89, 0x9a, 0xeb, 0x93, 0x93, 0xde,
+  0xaf, 0x7d, 0x72, 0x47, 0x10, 0x81, 0x00, 0xbf, 0xe3, 0x25, 0x1c, 0xe7, 0x10, 0xcd, 0xb1, 0x0b, 0xa7, 0xfe, 0x60, 0x6c,
+  0xaa, 0xd6, 0x6c, 0x0f, 0x49, 0x60, 0xf5, 0xea, 0x08, 0x1b, 0x11, 0xe9, 0x4f, 0x7f, 0xc2, 0x18, 0x0b, 0xdc, 0x42, 0x2b,
+  0x0c, 0x99, 0xb8, 0xe0, 0xbf, 0xff, 0xf0, 0xf2, 0x1d, 0xce, 0xa9, 0x36, 0x6b, 0x6b, 0x17, 0x28, 0x05, 0x98, 0x90, 0x77,
+  0x85, 0x5e, 0x85, 0x51, 0xa3, 0x9c, 0x74, 0x7f, 0xb5, 0x5d, 0x5d, 0xa3, 0x76, 0x31, 0x1d, 0x34, 0x85, 0x24, 0xd8, 0x95,
+  0x16, 0x5e, 0xf8, 0xf2, 0xe3, 0x4b, 0x0d, 0xc7, 0xe8, 0x54, 0x0e, 0x1c, 0x2b, 0x15, 0xfb, 0x90, 0xcc, 0xc7, 0xf3, 0xd4,
+  0xab, 0x12, 0x9a, 0x3e, 0x26, 0xd4, 0x96, 0x87, 0x41, 0x41, 0x13, 0xb2, 0x4c, 0x7b, 0x65, 0x35, 0xad, 0x12, 0x59, 0x21,
+  0x75, 0x73, 0x4d, 0x9d, 0xde, 0x76, 0x51, 0x23, 0x0f, 0x43, 0xa4, 0xf2, 0x8c, 0x3b, 0xd5, 0x16, 0xb8, 0x81, 0xaa, 0x45,
+  0x41, 0x24, 0xb0, 0x3d, 0xaf, 0x51, 0x55, 0x22, 0xed, 0x40, 0xc5, 0x52, 0x14, 0x59, 0xc2, 0xb8, 0xa8, 0xd7, 0xc0, 0xdf,
+  0x6a, 0xde, 0xf6, 0xe0, 0xa3, 0xc5, 0xf3, 0x5c, 0xdd, 0xdc, 0x3b, 0xc7, 0x56, 0x01, 0xcc, 0x33, 0x00, 0x4f, 0xa1, 0xfb,
+  0x89, 0x00, 0xb0, 0x78, 0x9d, 0x8f, 0x39, 0x2b, 0x66, 0xf3, 0x19, 0xe2, 0x8c, 0xc8, 0x65, 0xb2, 0x8f, 0x10, 0x22, 0x54,
+  0xa7, 0x17, 0xb2, 0xf5, 0x0c, 0x51, 0x2e, 0x8a, 0xe7, 0xe0, 0xaa, 0x2a, 0xa3, 0x37, 0x39, 0x3e, 0x20, 0x12, 0x4e, 0xcd,
+  0x8a, 0x34, 0xad, 0xd2, 0x44, 0x22, 0xe2, 0x25, 0xf6, 0x2d, 0x51, 0xcd, 0x71, 0x5a, 0x60, 0x61, 0x92, 0xcb, 0x69, 0xb8,
+  0xb9, 0x72, 0x71, 0xc9, 0x82, 0x8a, 0x4d, 0x1a, 0xd8, 0x15, 0x57, 0x1a, 0x96, 0xcd, 0x4e, 0xaf, 0x9c, 0x58, 0x87, 0x2a,
+  0x10, 0x32, 0xdb, 0x68, 0xb0, 0x02, 0x37, 0xbc, 0x64, 0x34, 0x0b, 0x16, 0x1f, 0x28, 0xb8, 0x85, 0x45, 0xe3, 0xe7, 0xfc,
+  0x52, 0xc6, 0x79, 0xcf, 0xc9, 0x57, 0xf7, 0x77, 0x94, 0x47, 0x0f, 0xdb, 0x85, 0x8a, 0x11, 0x72, 0xfd, 0x0f, 0x19, 0x5f,
+  0xc6, 0x90, 0x26, 0x78, 0x35, 0x1b, 0xa9, 0x05, 0xf0, 0x16, 0xbb, 0x68, 0x31, 0xab, 0x53, 0x37, 0x5f, 0x56, 0x1e, 0x09,
+  0x3b, 0x02, 0x8f, 0x94, 0x7b, 0xb6, 0x9c, 0xb1, 0x16, 0x5f, 0xbc, 0xc6, 0x7a, 0x6d, 0xe1, 0xbf, 0x69, 0xed, 0xbe, 0x96,
+  0x41, 0xea, 0x40, 0x3f, 0xf7, 0x6a, 0x7c, 0x76, 0xda, 0xf4, 0x03, 0xe6, 0xdb, 0x7d, 0xc7, 0x65, 0xf9, 0xb8, 0x01, 0xcc,
+  0xe7, 0x4b, 0x12, 0x00, 0x6a, 0x65, 0xb4, 0x96, 0x43, 0xd8, 0xf1, 0x15, 0x9e, 0xfb, 0xe4, 0xc8, 0x8e, 0x8e, 0x76, 0xce,
+  0xe4, 0xe6, 0xfa, 0x20, 0xea, 0x0a, 0xe4, 0xa0, 0x18, 0x88, 0x49, 0xc4, 0xf2, 0x60, 0xe1, 0x5d, 0x0d, 0xb5, 0x53, 0x7f,
+  0xdf, 0xd4, 0x96, 0xac, 0x54, 0x90, 0xc6, 0xe7, 0xd7, 0xf6, 0xf6, 0xf2, 0x05, 0x94, 0x9b, 0xc4, 0x12, 0x19, 0x23, 0x1a,
+  0x58, 0x38, 0xe4, 0x15, 0xb2, 0xed, 0x65, 0x6c, 0xb5, 0xdb, 0x90, 0x43, 0xdb, 0x80, 0x64, 0xfa, 0x9b, 0xe0, 0xa9, 0xe7,
+  0x46, 0xf2, 0x9a, 0x5d, 0x4b, 0x6e, 0xc6, 0xb0, 0x2b, 0x11, 0xca, 0x06, 0x9c, 0x6f, 0xbe, 0x1a, 0x71, 0x73, 0x15, 0xab,
+  0x03, 0xd1, 0x95, 0x57, 0x01, 0xd2, 0xc7, 0x34, 0x1f, 0x27, 0xdd, 0xc8, 0xb3, 0x8d, 0xb5, 0x31, 0xa5, 0x18, 0xc7, 0x9b,
+  0xec, 0x43, 0x55, 0xb9, 0xb6, 0xfc, 0xf4, 0xa0, 0xde, 0xf2, 0x54, 0x9f, 0x3d, 0xf4, 0xad, 0xc9, 0xba, 0xe7, 0x34, 0x75,
+  0x3b, 0x9b, 0xcd, 0x79, 0xca, 0xf5, 0x3f, 0x43, 0xa8, 0x97, 0x5f, 0xaf, 0x94, 0x8d, 0xcc, 0xe6, 0xc4, 0x8c, 0xc7, 0x9f,
+  0xb1, 0x17, 0x39, 0xb5, 0xfa, 0x96, 0xf5, 0x59, 0xf7, 0x6e, 0x1e, 0x65, 0x94, 0x50, 0x6e, 0x47, 0x6a, 0x2e, 0x66, 0xa1,
+  0x93, 0x70, 0x61, 0x06, 0x82, 0x59, 0x06, 0x22, 0x4d, 0xd5, 0x23, 0x28, 0x71, 0x47, 0xae, 0x80, 0x2d, 0x92, 0x0c, 0xdb,
+  0x26, 0xd8, 0xe7, 0xd0, 0xed, 0x0f, 0xd5, 0xf7, 0x70, 0x20, 0xda, 0xa4, 0x8e, 0x50, 0xe7, 0x3d, 0xc2, 0x52, 0xd6, 0xb2,
+  0x34, 0x1d, 0x6e, 0xac, 0x20, 0x03, 0x25, 0x56, 0xb0, 0x80, 0x02, 0x24, 0xcb, 0xea, 0xd1, 0x83, 0x27, 0xfa, 0xbb, 0x57,
+  0x39, 0xd8, 0xba, 0x25, 0x18, 0x30, 0x9f, 0x89, 0x60, 0xab, 0xe8, 0x41, 0x13, 0xac, 0xa5, 0x5f, 0xf7, 0x24, 0x82, 0x54,
+  0x31, 0x49, 0x9c, 0x63, 0x6f, 0x31, 0x27, 0xd9, 0xaa, 0x3a, 0x6d, 0x0b, 0x06, 0x56, 0x4b, 0xc0, 0x0a, 0xa3, 0xb2, 0x7a,
+  0x31, 0x3c, 0x41, 0xa5, 0xaf, 0x4a, 0x63, 0x21, 0x4b, 0xe0, 0x0f, 0xa2, 0x38, 0x9e, 0x18, 0x61, 0xf6, 0x27, 0x89, 0x7c,
+  0x63, 0x55, 0x9f, 0xf1, 0x7f, 0x45, 0xa8, 0xbe, 0x17, 0xe2, 0xf0, 0x1b, 0xbe, 0x66, 0xd9, 0x0b, 0x6a, 0xd7, 0xfe, 0xa8,
+  0xe3, 0x48, 0xf8, 0x71, 0x1a, 0x24, 0x45, 0xc8, 0x20, 0xa3, 0x8e, 0x16, 0x21, 0x40, 0x83, 0x83, 0xb1, 0x6d, 0x76, 0x89,
+  0x25, 0x2a, 0x4e, 0xad, 0x34, 0x59, 0xb5, 0x60, 0x6b, 0xad, 0xb7, 0xae, 0xbc, 0x4c, 0xef, 0xd6, 0x52, 0x81, 0x7d, 0x16,
+  0xc0, 0x3b, 0xfc, 0xbd, 0x56, 0xc0, 0x5b, 0xa8, 0x6e, 0x1d, 0x18, 0x5a, 0xbc, 0x04, 0xdb, 0xb2, 0xa8, 0x20, 0x3d, 0x24,
+  0x35, 0x33, 0x3e, 0xa9, 0xea, 0x79, 0xa7, 0x0d, 0x5c, 0x5b, 0xe4, 0xea, 0x6f, 0x08, 0x67, 0x0d, 0x96, 0xd8, 0xb2, 0x70,
+  0xce, 0x41, 0xba, 0xdd, 0xcf, 0x14, 0xd1, 0xf9, 0x5d, 0xb1, 0x9c, 0x41, 0x35, 0x29, 0x97, 0xb4, 0x9d, 0x12, 0xd7, 0xad,
+  0xc0, 0x15, 0x7b, 0x49, 0xb2, 0xde, 0x94, 0x5d, 0x13, 0xfb, 0x8b, 0x72, 0xfc, 0xe2, 0xe8, 0x87, 0x38, 0x8a, 0xe0, 0xf5,
+  0x6b, 0x08, 0xfa, 0x29, 0x2c, 0x5d, 0x8e, 0xea, 0xc4, 0xec, 0x9a, 0x6d, 0x84, 0x67, 0xda, 0xc6, 0x3d, 0x1f, 0x92, 0x71,
+  0xec, 0x00, 0x7a, 0xf0, 0xde, 0x8d, 0x43, 0x4a, 0xb6, 0xb4, 0x58, 0xfe, 0x2f, 0x8e, 0x94, 0x92, 0xc1, 0x34, 0xcb, 0x17,
+  0xb4, 0xfc, 0x6a, 0xc1, 0xb7, 0x34, 0x5f, 0xf8, 0x74, 0x26, 0x3c, 0x4d, 0x33, 0x30, 0x1b, 0xeb, 0xb9, 0x49, 0x94, 0x9c,
+  0x7f, 0x56, 0x8a, 0xda, 0xc3, 0x2f, 0xac, 0x8c, 0xd4, 0x38, 0x76, 0x6a, 0x6d, 0x4e, 0xf1, 0x3a, 0x6d, 0xa9, 0xc4, 0x6b,
+  0x28, 0x05, 0x73, 0x35, 0x55, 0x4b, 0xfa, 0x50, 0xb5, 0xd9, 0x6b, 0x47, 0x64, 0x14, 0xf1, 0x8b, 0x26, 0xfe, 0xd5, 0x9c,
+  0x0d, 0xb8, 0xcf, 0x4f, 0xa6, 0xbb, 0x89, 0xd1, 0x90, 0x67, 0xb9, 0x6a, 0x78, 0x22, 0xf4, 0x61, 0xfd, 0x02, 0x95, 0x50,
+  0x12, 0x2a, 0xc7, 0x3d, 0x25, 0xab, 0x18, 0x8b, 0x5a, 0x89, 0x57, 0x34, 0x63, 0xf2, 0x26, 0x8b, 0xad, 0x2c, 0x97, 0x91,
+  0x47, 0x5a, 0xc2, 0xa7, 0x6c, 0x07, 0x14, 0xe0, 0xb9, 0x70, 0x44, 0x2c, 0x6c, 0xe6, 0xad, 0x72, 0x8e, 0x6b, 0x0d, 0x25,
+  0xa9, 0xa5, 0x4b, 0x3c, 0xef, 0x99, 0x52, 0x93, 0x85, 0xc6, 0xea, 0xe6, 0x5b, 0xfc, 0x32, 0xfa, 0xb5, 0x9a, 0x89, 0x4d,
+  0x1a, 0x4f, 0xb1, 0x86, 0x61, 0xc2, 0xa3, 0x16, 0x02, 0x37, 0x77, 0x40, 0x91, 0xcd, 0x81, 0x6a, 0x39, 0x60, 0xa2, 0xd2,
+  0x75, 0x0f, 0xce, 0x56, 0xca, 0x02, 0xa7, 0x58, 0x9f, 0x84, 0x02, 0xd5, 0x66, 0xf5, 0x4a, 0x29, 0x81, 0x41, 0x5b, 0x75,
+  0x5e, 0x0f, 0x25, 0x30, 0xb3, 0xe2, 0x52, 0xf7, 0x51, 0xa3, 0x4b, 0x30, 0xda, 0x18, 0x0a, 0xd4, 0xf0, 0x33, 0x5e, 0x74,
+  0x3c, 0xac, 0xcf, 0xf6, 0x93, 0xff, 0x0e, 0xbc, 0x13, 0xbf, 0x7e, 0xfb, 0xf6, 0xce, 0xd6, 0xb1, 0xcd, 0x12, 0xd1, 0xef,
+  0x55, 0x7c, 0xcb, 0x42, 0x6f, 0xdc, 0xbb, 0x97, 0x8d, 0xd9, 0xab, 0x56, 0x24, 0xae, 0x65, 0x0b, 0x4e, 0x98, 0xf9, 0x03,
+  0x75, 0x5e, 0x5b, 0x65, 0x67, 0xca, 0xac, 0x07, 0xe2, 0xaa, 0x8a, 0x84, 0x28, 0x07, 0xe4, 0x44, 0x29, 0x80, 0xb8, 0x1b,
+  0x5a, 0xdb, 0x1b, 0xaf, 0x0e, 0x07, 0x20, 0x55, 0x15, 0x00, 0x72, 0xda, 0x92, 0x9b, 0x3c, 0x98, 0xc1, 0x75, 0x87, 0x4d,
+  0x19, 0xdd, 0xcc, 0xad, 0x91, 0xaf, 0x69, 0xb1, 0x75, 0xe1, 0x22, 0xbb, 0x09, 0x2c, 0xec, 0x3e, 0x54, 0x21, 0xaa, 0xc5,
+  0xac, 0x94, 0xed, 0x0f, 0x29, 0xe3, 0x3f, 0x8c, 0xf7, 0xdd, 0x8f, 0xa9, 0x6c, 0x67, 0xe5, 0x98, 0x1d, 0xd3, 0xb0, 0xd4,
+  0x57, 0x23, 0xbc, 0xdb, 0xf6, 0x51, 0x75, 0x09, 0x9a, 0x3d, 0x43, 0x2c, 0xc7, 0x1b, 0x2d, 0x43, 0xab, 0x57, 0x55, 0x5e,
+  0x9a, 0xe9, 0xcf, 0x9a, 0xf0, 0x4b, 0x94, 0x1b, 0xf6, 0x40, 0x13, 0x1f, 0x8d, 0xab, 0xd6, 0x91, 0x38, 0xb7, 0x7b, 0x12,
+  0xf5, 0x26, 0x7f, 0x79, 0x49, 0xd1, 0x6b, 0x6d, 0xb9, 0x98, 0x51, 0x4b, 0x0f, 0xd5, 0xad, 0x46, 0xbd, 0xd3, 0xd1, 0xe8,
+  0xb8, 0xb8, 0x45, 0x46, 0xd5, 0xf8, 0xa8, 0x69, 0xa8, 0xbc, 0xcb, 0xdc, 0xa6, 0x23, 0x75, 0x61, 0x58, 0x57, 0xd2, 0x83,
+  0xf7, 0x17, 0x80, 0xda, 0x1f, 0x53, 0xd9, 0x54, 0x92, 0x27, 0x25, 0xf3, 0x9a, 0x29, 0x4a, 0x00, 0xe5, 0xee, 0x66, 0x0d,
+  0x81, 0x54, 0xd7, 0xc7, 0x1a, 0xd6, 0xaf, 0x19, 0x03, 0xf4, 0x10, 0xaa, 0x48, 0xda, 0x22, 0xf0, 0x16, 0x2f, 0xda, 0xd1,
+  0x1b, 0x6f, 0xb9, 0x7c, 0xb1, 0x8a, 0x3f, 0xbb, 0x99, 0xe9, 0xf4, 0x17, 0x8d, 0x6e, 0x4c, 0x5e, 0xd8, 0xd6, 0x72, 0x86,
+  0x98, 0x03, 0xeb, 0x39, 0x15, 0x8a, 0xa6, 0xaf, 0xdf, 0xf1, 0x6f, 0x21, 0xb7, 0x20, 0xcb, 0x10, 0xeb, 0x4b, 0xfd, 0x2d,
+  0x54, 0xb6, 0xe4, 0x9a, 0xcc, 0xba, 0xce, 0xdf, 0x42, 0xe8, 0x1e, 0xa4, 0xba, 0x6f, 0xf3, 0xf1, 0xea, 0x01, 0x41, 0x44,
+  0x73, 0x40, 0x25, 0x7e, 0x9e, 0x25, 0x34, 0xbd, 0xee, 0xd6, 0xf5, 0x01, 0x07, 0xfc, 0x17, 0x79, 0x3f, 0x43, 0x72, 0x88,
+  0x3a, 0x24, 0xcc, 0xf8, 0xca, 0x2d, 0x1a, 0xfa, 0xb5, 0x23, 0x16, 0x39, 0xaf, 0x8e, 0x58, 0xb7, 0x9d, 0x55, 0xab, 0xd9,
+  0xdc, 0x02, 0x35, 0x85, 0xad, 0xee, 0x85, 0x82, 0x05, 0x4d, 0xe7, 0xac, 0xd5, 0x00, 0xb7, 0xdf, 0x22, 0xc9, 0x97, 0x09,
+  0xeb, 0xba, 0x99, 0x71, 0x5b, 0xef, 0xda, 0x6a, 0x75, 0xb9, 0x57, 0x6f, 0xb5, 0xdb, 0xa2, 0xb5, 0xd8, 0x7a, 0x67, 0xa0,
+  0xaf, 0x26, 0x6a, 0x57, 0x75, 0x35, 0x57, 0xb3, 0x2b, 0x24, 0xfb, 0x12, 0xdf, 0x6d, 0x65, 0x76, 0xf5, 0x35, 0x5b, 0x79,
+  0x6d, 0xed, 0x26, 0xe0, 0x8d, 0x8b, 0x3e, 0xb5, 0x46, 0xa3, 0xc2, 0x3a, 0x1b, 0x96, 0xdf, 0x16, 0x9d, 0x0d, 0xd5, 0x17,
+  0xee, 0x67, 0x43, 0xf5, 0x7f, 0xb6, 0xff, 0x1f, 0x9c, 0x9f, 0xb5, 0x7c, 0xc4, 0x3d, 0x00, 0x00,
+};
+
+static const web_asset_t web_assets[] = {
+  {"/", "text/html", "\"05095c618f76f765\"", asset_index_html, sizeof(asset_index_html)},
+};
+
+#define WEB_ASSET_COUNT (sizeof(web_assets) / sizeof(web_assets[0]))
+
+#endif  // WEB_ASSETS_H
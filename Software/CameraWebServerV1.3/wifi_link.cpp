@@ -0,0 +1,236 @@
+#include "wifi_link.h"
+#include "board_config.h"
+#include "settings.h"
+
+#include <WiFi.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/semphr.h>
+#include <string.h>
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#endif
+
+#define LINK_UP_BIT (1 << 0)
+
+static const char *link_ssid = nullptr;
+static const char *link_password = nullptr;
+
+static SemaphoreHandle_t link_lock = nullptr;
+static EventGroupHandle_t link_events = nullptr;
+
+// All guarded by link_lock (written from the WiFi event task and loop())
+static wifi_link_status_t link = {};
+static uint32_t attempt_start_ms = 0;
+static uint32_t retry_at_ms = 0;
+static bool attempt_cached = false; // Current attempt targets the cached BSSID/channel
+static bool attempt_fast = false;   // ...and is still waiting for that AP (fast timeout)
+static bool fast_failed = false;    // Cached association is stale, forget it
+static bool cache_dirty = false;    // Link came up, remember the AP
+
+// Wait out the current backoff, doubling it for the next failure
+static void set_backoff_locked(uint32_t now) {
+  link.state = WIFI_LINK_BACKOFF;
+  retry_at_ms = now + link.backoff_ms;
+  link.backoff_ms = link.backoff_ms * 2 > WIFI_RECONNECT_MAX_MS ? WIFI_RECONNECT_MAX_MS
+                                                                 : link.backoff_ms * 2;
+}
+
+// Cached AP did not answer (moved channel, replaced router): scan on the next
+// attempt, which follows after the minimum delay without growing the backoff
+static void fast_connect_failed_locked(uint32_t now) {
+  attempt_cached = false;
+  attempt_fast = false;
+  fast_failed = true;
+  link.state = WIFI_LINK_BACKOFF;
+  retry_at_ms = now + WIFI_RECONNECT_MIN_MS;
+}
+
+// Runs in the WiFi event task: state transitions only, no blocking work
+static void on_wifi_event(arduino_event_id_t event, arduino_event_info_t info) {
+  uint32_t now = millis();
+
+  if (event == ARDUINO_EVENT_WIFI_STA_CONNECTED) {
+    // The cached AP answered; DHCP gets the rest of the normal attempt timeout
+    xSemaphoreTake(link_lock, portMAX_DELAY);
+    attempt_fast = false;
+    xSemaphoreGive(link_lock);
+  } else if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+    xSemaphoreTake(link_lock, portMAX_DELAY);
+    link.state = WIFI_LINK_UP;
+    link.up_since_ms = now;
+    link.backoff_ms = WIFI_RECONNECT_MIN_MS;
+    if (link.first_ip_ms == 0) {
+      link.first_ip_ms = now;
+      link.fast_connect = attempt_cached;
+    }
+    attempt_cached = false;
+    attempt_fast = false;
+    cache_dirty = true;
+    xSemaphoreGive(link_lock);
+    xEventGroupSetBits(link_events, LINK_UP_BIT);
+    log_i("Link up after %u attempt(s)", (unsigned)link.attempts);
+  } else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+    xEventGroupClearBits(link_events, LINK_UP_BIT);
+    xSemaphoreTake(link_lock, portMAX_DELAY);
+    link.last_reason = info.wifi_sta_disconnected.reason;
+    if (link.state == WIFI_LINK_UP) {
+      link.drops++;
+      log_w("Link lost (reason %u), reconnecting in %u ms", link.last_reason,
+            (unsigned)link.backoff_ms);
+    }
+    if (attempt_fast) {
+      fast_connect_failed_locked(now);
+    } else if (link.state != WIFI_LINK_BACKOFF) {
+      set_backoff_locked(now);
+    }
+    xSemaphoreGive(link_lock);
+  } else if (event == ARDUINO_EVENT_WIFI_STA_LOST_IP) {
+    // Still associated; DHCP renews within the attempt timeout or we start over
+    xEventGroupClearBits(link_events, LINK_UP_BIT);
+    xSemaphoreTake(link_lock, portMAX_DELAY);
+    if (link.state == WIFI_LINK_UP) {
+      link.drops++;
+      link.state = WIFI_LINK_CONNECTING;
+      attempt_start_ms = now;
+    }
+    xSemaphoreGive(link_lock);
+  }
+}
+
+static void start_attempt() {
+  bool fast = false;
+  wifi_cache_t cache;
+#if WIFI_FAST_RECONNECT
+  // Only the very first association tries the cached AP; later attempts scan
+  // so roaming to another AP of the same network keeps working
+  fast = link.attempts == 0 && settings_load_wifi(&cache);
+#endif
+
+  xSemaphoreTake(link_lock, portMAX_DELAY);
+  link.state = WIFI_LINK_CONNECTING;
+  link.attempts++;
+  attempt_cached = fast;
+  attempt_fast = fast;
+  attempt_start_ms = millis();
+  xSemaphoreGive(link_lock);
+
+  if (fast) {
+    log_i("Fast connect: channel %u, BSSID %02x:%02x:%02x:%02x:%02x:%02x", cache.channel,
+          cache.bssid[0], cache.bssid[1], cache.bssid[2], cache.bssid[3], cache.bssid[4],
+          cache.bssid[5]);
+    WiFi.begin(link_ssid, link_password, cache.channel, cache.bssid);
+  } else {
+    WiFi.begin(link_ssid, link_password);
+  }
+}
+
+void wifi_link_begin(const char *ssid, const char *password) {
+  link_ssid = ssid;
+  link_password = password;
+  if (!link_lock) {
+    link_lock = xSemaphoreCreateMutex();
+    link_events = xEventGroupCreate();
+  }
+  link.backoff_ms = WIFI_RECONNECT_MIN_MS;
+
+  WiFi.persistent(false);       // Credentials are compiled in, skip the flash write
+  WiFi.setAutoReconnect(false); // Retries are ours, with backoff
+  WiFi.onEvent(on_wifi_event);
+  WiFi.mode(WIFI_STA);
+  WiFi.setSleep(false);         // No modem sleep while streaming (power_idle enables it when idle)
+
+#if defined(WIFI_STATIC_IP)
+  // Static address skips the DHCP exchange
+  IPAddress ip, gateway, subnet, dns;
+  ip.fromString(WIFI_STATIC_IP);
+  gateway.fromString(WIFI_GATEWAY);
+  subnet.fromString(WIFI_SUBNET);
+#if defined(WIFI_DNS)
+  dns.fromString(WIFI_DNS);
+#else
+  dns = gateway;
+#endif
+  if (!WiFi.config(ip, gateway, subnet, dns)) {
+    log_w("Static IP configuration failed, using DHCP");
+  }
+#endif
+
+  start_attempt();
+}
+
+void wifi_link_poll() {
+  uint32_t now = millis();
+
+  xSemaphoreTake(link_lock, portMAX_DELAY);
+  wifi_link_state_t state = link.state;
+  bool save_cache = cache_dirty;
+  cache_dirty = false;
+  bool retry_due = state == WIFI_LINK_BACKOFF && (int32_t)(now - retry_at_ms) >= 0;
+  bool timed_out = state == WIFI_LINK_CONNECTING &&
+                   now - attempt_start_ms > (attempt_fast ? WIFI_FAST_CONNECT_TIMEOUT_MS
+                                                          : WIFI_ATTEMPT_TIMEOUT_MS);
+  if (timed_out) {
+    log_w("Connection attempt timed out");
+    if (attempt_fast) {
+      fast_connect_failed_locked(now);
+    } else {
+      set_backoff_locked(now);
+    }
+  }
+  bool clear_cache = fast_failed;
+  fast_failed = false;
+  xSemaphoreGive(link_lock);
+
+#if WIFI_FAST_RECONNECT
+  // NVS writes happen here rather than in the event task
+  if (clear_cache) {
+    wifi_cache_t none = {};
+    settings_save_wifi(&none);
+  }
+  if (save_cache) {
+    wifi_cache_t cache = {};
+    const uint8_t *bssid = WiFi.BSSID();
+    if (bssid) {
+      memcpy(cache.bssid, bssid, sizeof(cache.bssid));
+      cache.channel = WiFi.channel();
+      cache.valid = 1;
+      settings_save_wifi(&cache);
+    }
+  }
+#endif
+
+  if (timed_out) {
+    WiFi.disconnect();
+  } else if (retry_due) {
+    start_attempt();
+  }
+}
+
+bool wifi_link_wait_up(uint32_t timeout_ms) {
+  return (xEventGroupWaitBits(link_events, LINK_UP_BIT, pdFALSE, pdTRUE,
+                              pdMS_TO_TICKS(timeout_ms)) & LINK_UP_BIT) != 0;
+}
+
+bool wifi_link_up() {
+  return link_events && (xEventGroupGetBits(link_events) & LINK_UP_BIT) != 0;
+}
+
+void wifi_link_get_status(wifi_link_status_t *status) {
+  xSemaphoreTake(link_lock, portMAX_DELAY);
+  *status = link;
+  xSemaphoreGive(link_lock);
+}
+
+const char *wifi_link_state_name(wifi_link_state_t state) {
+  switch (state) {
+    case WIFI_LINK_CONNECTING:
+      return "connecting";
+    case WIFI_LINK_UP:
+      return "up";
+    case WIFI_LINK_BACKOFF:
+      return "backoff";
+  }
+  return "unknown";
+}
@@ -0,0 +1,48 @@
+#ifndef WIFI_LINK_H
+#define WIFI_LINK_H
+
+#include <stdint.h>
+
+//
+// Wi-Fi station link
+//
+// Owns association and recovery. Driver events move a small state machine
+// (connecting -> up -> backoff -> connecting ...); wifi_link_poll() from loop()
+// only fires the timers (retry after backoff, attempt timeout). A dropped link
+// is retried after WIFI_RECONNECT_MIN_MS, doubling up to WIFI_RECONNECT_MAX_MS
+// while attempts keep failing. The HTTP server and frame pipeline are left
+// running throughout; stream senders hold off while the link is down and carry
+// on with the newest frame once it is back.
+//
+
+typedef enum {
+  WIFI_LINK_CONNECTING = 0, // Association / DHCP in progress
+  WIFI_LINK_UP,             // Associated with an IP address
+  WIFI_LINK_BACKOFF,        // Waiting before the next attempt
+} wifi_link_state_t;
+
+typedef struct {
+  wifi_link_state_t state;
+  uint32_t drops;          // Times an established link was lost
+  uint32_t attempts;       // Connection attempts since boot
+  uint8_t last_reason;     // wifi_err_reason_t of the last disconnect
+  uint32_t backoff_ms;     // Delay before the next attempt after a failure
+  uint32_t first_ip_ms;    // ms since reset when the first IP was assigned (0 = not yet)
+  uint32_t up_since_ms;    // millis() when the link last came up
+  bool fast_connect;       // First association used the cached BSSID/channel
+} wifi_link_status_t;
+
+// Start the first association (static IP / fast connect as configured)
+void wifi_link_begin(const char *ssid, const char *password);
+
+// Retry and timeout handling; call from loop()
+void wifi_link_poll();
+
+// Block up to timeout_ms for the link to be up; true if it is
+bool wifi_link_wait_up(uint32_t timeout_ms);
+
+bool wifi_link_up();
+void wifi_link_get_status(wifi_link_status_t *status);
+const char *wifi_link_state_name(wifi_link_state_t state);
+
+#endif  // WIFI_LINK_H